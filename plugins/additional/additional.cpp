@@ -63,6 +63,8 @@
 #include <wx/richtext/richtextctrl.h>
 #include <wx/srchctrl.h>
 
+#include <map>
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /**
@@ -726,6 +728,65 @@ public:
 	}
 };
 
+/**
+ * Table of the grids shown in the designer.
+ *
+ * The example values are made from the labels when the cells are drawn, only the values typed in the preview are
+ * stored, so a grid with many cells does not allocate them.
+ */
+class PreviewGridTable : public wxGridTableBase
+{
+private:
+	int m_rows;
+	int m_cols;
+	wxArrayString m_rowLabels;
+	wxArrayString m_colLabels;
+	std::map< std::pair< int, int >, wxString > m_edited;
+
+public:
+	PreviewGridTable( int rows, int cols, const wxArrayString& rowLabels, const wxArrayString& colLabels )
+	:
+	m_rows( rows ),
+	m_cols( cols ),
+	m_rowLabels( rowLabels ),
+	m_colLabels( colLabels )
+	{
+	}
+
+	int GetNumberRows() override {
+		return m_rows;
+	}
+
+	int GetNumberCols() override {
+		return m_cols;
+	}
+
+	wxString GetValue( int row, int col ) override {
+		std::map< std::pair< int, int >, wxString >::const_iterator edited = m_edited.find( std::make_pair( row, col ) );
+		if ( edited != m_edited.end() )
+		{
+			return edited->second;
+		}
+		return GetColLabelValue( col ) + wxT("-") + GetRowLabelValue( row );
+	}
+
+	void SetValue( int row, int col, const wxString& value ) override {
+		m_edited[ std::make_pair( row, col ) ] = value;
+	}
+
+	bool IsEmptyCell( int, int ) override {
+		return false;
+	}
+
+	wxString GetRowLabelValue( int row ) override {
+		return ( row < (int)m_rowLabels.size() ? m_rowLabels[row] : wxGridTableBase::GetRowLabelValue( row ) );
+	}
+
+	wxString GetColLabelValue( int col ) override {
+		return ( col < (int)m_colLabels.size() ? m_colLabels[col] : wxGridTableBase::GetColLabelValue( col ) );
+	}
+};
+
 class GridComponent : public ComponentBase
 {
 public:
@@ -735,9 +796,11 @@ public:
 			obj->GetPropertyAsSize(_("size")),
 			obj->GetPropertyAsInteger(_("window_style")));
 
-		grid->CreateGrid(
+		grid->SetTable( new PreviewGridTable(
 			obj->GetPropertyAsInteger(_("rows")),
-			obj->GetPropertyAsInteger(_("cols")));
+			obj->GetPropertyAsInteger(_("cols")),
+			obj->GetPropertyAsArrayString( _("row_label_values") ),
+			obj->GetPropertyAsArrayString( _("col_label_values") ) ), true );
 
 		grid->EnableDragColMove( obj->GetPropertyAsInteger( _("drag_col_move") ) != 0 );
 		grid->EnableDragColSize( obj->GetPropertyAsInteger( _("drag_col_size") ) != 0 );
@@ -755,12 +818,6 @@ public:
 		grid->SetColLabelAlignment( obj->GetPropertyAsInteger( _("col_label_horiz_alignment") ), obj->GetPropertyAsInteger( _("col_label_vert_alignment") ) );
 		grid->SetColLabelSize( obj->GetPropertyAsInteger( _("col_label_size") ) );
 
-		wxArrayString columnLabels = obj->GetPropertyAsArrayString( _("col_label_values") );
-		for ( int i = 0; i < (int)columnLabels.size() && i < grid->GetNumberCols(); ++i )
-		{
-			grid->SetColLabelValue( i, columnLabels[i] );
-		}
-
 		wxArrayInt columnSizes = obj->GetPropertyAsArrayInt( _("column_sizes") );
 		for ( int i = 0; i < (int)columnSizes.size() && i < grid->GetNumberCols(); ++i )
 		{
@@ -770,12 +827,6 @@ public:
 		grid->SetRowLabelAlignment( obj->GetPropertyAsInteger( _("row_label_horiz_alignment") ), obj->GetPropertyAsInteger( _("row_label_vert_alignment") ) );
 		grid->SetRowLabelSize( obj->GetPropertyAsInteger( _("row_label_size") ) );
 
-		wxArrayString rowLabels = obj->GetPropertyAsArrayString( _("row_label_values") );
-		for ( int i = 0; i < (int)rowLabels.size() && i < grid->GetNumberRows(); ++i )
-		{
-			grid->SetRowLabelValue( i, rowLabels[i] );
-		}
-
 		wxArrayInt rowSizes = obj->GetPropertyAsArrayInt( _("row_sizes") );
 		for ( int i = 0; i < (int)rowSizes.size() && i < grid->GetNumberRows(); ++i )
 		{
@@ -811,15 +862,6 @@ public:
 			grid->SetDefaultCellFont( obj->GetPropertyAsFont( _("cell_font") ) );
 		}
 
-		// Example Cell Values
-		for ( int col = 0; col < grid->GetNumberCols(); ++col )
-		{
-			for ( int row = 0; row < grid->GetNumberRows(); ++row )
-			{
-				grid->SetCellValue( row, col, grid->GetColLabelValue( col ) + wxT("-") + grid->GetRowLabelValue( row ) );
-			}
-		}
-
 		if ( obj->GetPropertyAsInteger( _("autosize_rows") ) != 0 )
 		{
 			grid->AutoSizeRows();
@@ -1452,11 +1494,13 @@ public:
 			return;
 		}
 
-		size_t count = GetManager()->GetChildCount( wxobject );
+		std::vector< wxObject* > children;
+		std::vector< IObject* > iChildren;
+		size_t count = GetManager()->GetChildren( wxobject, &children, &iChildren );
 		for ( size_t i = 0; i < count; ++i )
 		{
-			wxObject* child = GetManager()->GetChild( wxobject, i );
-			IObject* childObj = GetManager()->GetIObject( child );
+			wxObject* child = children[i];
+			IObject* childObj = iChildren[i];
 			if (childObj->GetClassName() == _("propGridItem"))
 			{
 				if (childObj->GetPropertyAsString( _("type") ) == _("Category") )
@@ -1605,11 +1649,13 @@ public:
 			return;
 		}
 
-		size_t count = GetManager()->GetChildCount( wxobject );
+		std::vector< wxObject* > children;
+		std::vector< IObject* > iChildren;
+		size_t count = GetManager()->GetChildren( wxobject, &children, &iChildren );
 		for ( size_t i = 0; i < count; ++i )
 		{
-			wxObject* child = GetManager()->GetChild( wxobject, i );
-			IObject* childObj = GetManager()->GetIObject( child );
+			wxObject* child = children[i];
+			IObject* childObj = iChildren[i];
 			if (childObj->GetClassName() == _("propGridPage"))
 			{
 				wxPropertyGridPage *page = pgm->AddPage( childObj->GetPropertyAsString( _("label") ), childObj->GetPropertyAsBitmap( _("bitmap") ) );
@@ -1851,11 +1897,13 @@ public:
 			// very very strange
 			return;
 		}
-		size_t count = GetManager()->GetChildCount( wxobject );
+		std::vector< wxObject* > children;
+		std::vector< IObject* > iChildren;
+		size_t count = GetManager()->GetChildren( wxobject, &children, &iChildren );
 		for ( size_t i = 0; i < count; ++i )
 		{
-			wxObject* child = GetManager()->GetChild( wxobject, i );
-			IObject* childObj = GetManager()->GetIObject( child );
+			wxObject* child = children[i];
+			IObject* childObj = iChildren[i];
 			if (childObj->GetClassName() == _("dataViewColumn"))
 			{
 				if (childObj->GetPropertyAsString( _("type")) == _("Text"))
@@ -1990,11 +2038,13 @@ public:
 			// very very strange
 			return;
 		}
-		size_t count = GetManager()->GetChildCount( wxobject );
+		std::vector< wxObject* > children;
+		std::vector< IObject* > iChildren;
+		size_t count = GetManager()->GetChildren( wxobject, &children, &iChildren );
 		for ( size_t i = 0; i < count; ++i )
 		{
-			wxObject* child = GetManager()->GetChild( wxobject, i );
-			IObject* childObj = GetManager()->GetIObject( child );
+			wxObject* child = children[i];
+			IObject* childObj = iChildren[i];
 			if (childObj->GetClassName() == _("dataViewListColumn"))
 			{
 				if (childObj->GetPropertyAsString( _("type")) == _("Text"))
@@ -2203,11 +2253,13 @@ void ComponentEvtHandler::OnRibbonBarPageChanged( wxRibbonBarEvent& event )
 
 	int selPage = rb->GetActivePage();
 
-	size_t count = m_manager->GetChildCount( m_window );
+	std::vector< wxObject* > children;
+	std::vector< IObject* > iChildren;
+	size_t count = m_manager->GetChildren( m_window, &children, &iChildren );
 	for ( size_t i = 0; i < count; i++ )
 	{
-		wxObject* wxChild = m_manager->GetChild( m_window, i );
-		IObject*  iChild = m_manager->GetIObject( wxChild );
+		wxObject* wxChild = children[i];
+		IObject* iChild = iChildren[i];
 		if ( iChild )
 		{
 			if (int(i) == selPage && iChild->GetPropertyAsInteger(_("select")) == 0) {
@@ -2316,11 +2368,13 @@ class RibbonButtonBarComponent : public ComponentBase
 			return;
 		}
 
-		size_t count = GetManager()->GetChildCount( wxobject );
+		std::vector< wxObject* > children;
+		std::vector< IObject* > iChildren;
+		size_t count = GetManager()->GetChildren( wxobject, &children, &iChildren );
 		for ( size_t i = 0; i < count; ++i )
 		{
-			wxObject* child = GetManager()->GetChild( wxobject, i );
-			IObject* childObj = GetManager()->GetIObject( child );
+			wxObject* child = children[i];
+			IObject* childObj = iChildren[i];
 			if (childObj->GetClassName() == wxT("ribbonButton"))
 			{
 				rb->AddButton(wxID_ANY,
@@ -2388,11 +2442,13 @@ class RibbonToolBarComponent : public ComponentBase
 			return;
 		}
 
-		size_t count = GetManager()->GetChildCount( wxobject );
+		std::vector< wxObject* > children;
+		std::vector< IObject* > iChildren;
+		size_t count = GetManager()->GetChildren( wxobject, &children, &iChildren );
 		for ( size_t i = 0; i < count; ++i )
 		{
-			wxObject* child = GetManager()->GetChild( wxobject, i );
-			IObject* childObj = GetManager()->GetIObject( child );
+			wxObject* child = children[i];
+			IObject* childObj = iChildren[i];
 			if (wxT("ribbonTool") == childObj->GetClassName() )
 			{
 				rb->AddTool(wxID_ANY,
@@ -2457,11 +2513,13 @@ class RibbonGalleryComponent : public ComponentBase
 			return;
 		}
 
-		size_t count = GetManager()->GetChildCount( wxobject );
+		std::vector< wxObject* > children;
+		std::vector< IObject* > iChildren;
+		size_t count = GetManager()->GetChildren( wxobject, &children, &iChildren );
 		for ( size_t i = 0; i < count; ++i )
 		{
-			wxObject* child = GetManager()->GetChild( wxobject, i );
-			IObject* childObj = GetManager()->GetIObject( child );
+			wxObject* child = children[i];
+			IObject* childObj = iChildren[i];
 			if ( wxT("ribbonGalleryItem") == childObj->GetClassName() )
 			{
 				rg->Append(childObj->GetPropertyAsBitmap( _("bitmap") ), wxID_ANY );
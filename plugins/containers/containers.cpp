@@ -75,11 +75,13 @@ protected:
 			return;
 		}
 
-		size_t count = m_manager->GetChildCount( m_window );
+		std::vector< wxObject* > children;
+		std::vector< IObject* > iChildren;
+		size_t count = m_manager->GetChildren( m_window, &children, &iChildren );
 		for ( size_t i = 0; i < count; i++ )
 		{
-			wxObject* wxChild = m_manager->GetChild( m_window, i );
-			IObject*  iChild = m_manager->GetIObject( wxChild );
+			wxObject* wxChild = children[i];
+			IObject* iChild = iChildren[i];
 			if ( iChild )
 			{
 				if ( (int)i == selPage && !iChild->GetPropertyAsInteger( _("select") ) )
@@ -198,11 +198,13 @@ public:
 			return;
 		}
 
-		size_t count = GetManager()->GetChildCount( wxobject );
+		std::vector< wxObject* > children;
+		std::vector< IObject* > iChildren;
+		size_t count = GetManager()->GetChildren( wxobject, &children, &iChildren );
 		for ( size_t i = 0; i < count; ++i )
 		{
-			wxObject* child = GetManager()->GetChild( wxobject, i );
-			IObject* childObj = GetManager()->GetIObject( child );
+			wxObject* child = children[i];
+			IObject* childObj = iChildren[i];
 			if ( wxT("tool") == childObj->GetClassName() )
 			{
 				tb->AddTool( 	wxID_ANY,
@@ -29,6 +29,8 @@
 #include <wx/wrapsizer.h>
 #include <xrcconv.h>
 
+#include <memory>
+
 #ifdef __WX24__
 	#define wxFIXED_MINSIZE wxADJUST_MINSIZE
 #endif
@@ -72,7 +74,9 @@ public:
 			// it is a spacer
 			XrcToXfbFilter spacer( xrcObj, _("spacer") );
 			spacer.AddPropertyPair( "size", _("width"), _("height") );
-			sizeritem->LinkEndChild( spacer.GetXfbObject() );
+			// The element is linked into the sizeritem, the wrapper is ours to free
+			std::unique_ptr< ticpp::Element > spacerObj( spacer.GetXfbObject() );
+			sizeritem->LinkEndChild( spacerObj.get() );
 		}
 
 		return sizeritem;
@@ -162,7 +166,9 @@ public:
 			// it is a spacer
 			XrcToXfbFilter spacer( xrcObj, _("spacer") );
 			spacer.AddPropertyPair( "size", _("width"), _("height") );
-			sizeritem->LinkEndChild( spacer.GetXfbObject() );
+			// The element is linked into the sizeritem, the wrapper is ours to free
+			std::unique_ptr< ticpp::Element > spacerObj( spacer.GetXfbObject() );
+			sizeritem->LinkEndChild( spacerObj.get() );
 		}
 		return sizeritem;
 	}
@@ -450,7 +456,9 @@ public:
 
 		// Add the children
 		IManager* manager = GetManager();
-		size_t count = manager->GetChildCount( wxobject );
+		std::vector< wxObject* > sizerItems;
+		std::vector< IObject* > iSizerItems;
+		size_t count = manager->GetChildren( wxobject, &sizerItems, &iSizerItems );
 		if ( 0 == count )
 		{
 			// wxGridBagSizer gets upset sometimes without children
@@ -460,8 +468,8 @@ public:
 		for ( size_t i = 0; i < count; ++i )
 		{
 			// Should be a GBSizerItem
-			wxObject* wxsizerItem = manager->GetChild( wxobject, i );
-			IObject* isizerItem = manager->GetIObject( wxsizerItem );
+			wxObject* wxsizerItem = sizerItems[i];
+			IObject* isizerItem = iSizerItems[i];
 
 			// Get the location of the item
 			wxGBSpan span( isizerItem->GetPropertyAsInteger( _("rowspan") ), isizerItem->GetPropertyAsInteger( _("colspan") ) );
@@ -29,6 +29,8 @@
 #include "wx/wx.h"
 #include "fontcontainer.h"
 
+#include <vector>
+
 #define COMPONENT_TYPE_ABSTRACT 0
 #define COMPONENT_TYPE_WINDOW   1
 #define COMPONENT_TYPE_SIZER    2
@@ -145,7 +147,9 @@ class IComponent
   virtual ticpp::Element* ExportToXrc( IObject* obj ) = 0;
 
   /**
-   * Converts from an XRC element to a wxFormBuilder project file XML element
+   * Converts from an XRC element to a wxFormBuilder project file XML element.
+   * The caller takes the ownership of the returned element and deletes it, return a new element or the one of
+   * XrcToXfbFilter::GetXfbObject(), never one the component still holds.
    */
   virtual ticpp::Element* ImportFromXrc( ticpp::Element* xrcObj ) = 0;
 
@@ -210,6 +214,14 @@ public:
 	*/
 	virtual bool SelectObject( wxObject* wxobject ) = 0;
 
+	/**
+	Get all the children of the object in one call, instead of GetChildCount(), GetChild() and GetIObject() for each.
+	@param children Receives the children, NULL for those not created.
+	@param iChildren Receives the object interfaces of the children, NULL for those not created. Can be NULL.
+	@return The count of the children.
+	*/
+	virtual size_t GetChildren( wxObject* wxobject, std::vector< wxObject* >* children, std::vector< IObject* >* iChildren = NULL ) = 0;
+
 	virtual ~IManager(){}
 };
 
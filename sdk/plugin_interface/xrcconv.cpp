@@ -697,7 +697,10 @@ void XrcToXfbFilter::AddPropertyPair( const char* xrcPropName, const wxString& x
 
 ticpp::Element* XrcToXfbFilter::GetXfbObject()
 {
-	return m_xfbObj->Clone().release()->ToElement();
+	// The element is handed over instead of cloned, the filter is done with it
+	ticpp::Element* xfbObj = m_xfbObj;
+	m_xfbObj = NULL;
+	return xfbObj;
 }
 
 //-----------------------------
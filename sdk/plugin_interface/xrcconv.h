@@ -126,6 +126,9 @@ class XrcToXfbFilter
 
   void AddPropertyPair( const char* xrcPropName, const wxString& xfbPropName1, const wxString& xfbPropName2 );
 
+  /**
+   * Hands over the converted element, the caller owns it. Nothing can be added after.
+   */
   ticpp::Element* GetXfbObject();
 
  private:
@@ -0,0 +1,221 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "codeanalysis.h"
+
+#include "../model/objectbase.h"
+
+#include <wx/thread.h>
+
+#include <cassert>
+
+namespace
+{
+	// The generators used to try the template on every object, it only produces code for these classes
+	bool HasValidatorTemplate( PObjectInfo info )
+	{
+		PCodeInfo codeInfo = info->GetCodeInfo( wxT( "C++" ) );
+		if ( codeInfo && !codeInfo->GetTemplate( wxT( "valvar_declaration" ) ).empty() )
+		{
+			return true;
+		}
+
+		for ( unsigned int i = 0; i < info->GetBaseClassCount( false ); i++ )
+		{
+			if ( HasValidatorTemplate( info->GetBaseClass( i, false ) ) )
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+
+void CodeSummary::AddMacro( const wxString& value )
+{
+	if ( m_macroSet.insert( value ).second )
+	{
+		m_macros.push_back( value );
+	}
+}
+
+void CodeSummary::AddBitmap( const wxString& value )
+{
+	if ( !value.empty() && m_bitmapSet.insert( value ).second )
+	{
+		m_bitmaps.push_back( value );
+	}
+}
+
+void CodeSummary::Append( const CodeSummary& other )
+{
+	m_classes.insert( other.m_classes.begin(), other.m_classes.end() );
+
+	for ( std::vector< wxString >::const_iterator it = other.m_macros.begin(); it != other.m_macros.end(); ++it )
+	{
+		AddMacro( *it );
+	}
+
+	m_events.insert( m_events.end(), other.m_events.begin(), other.m_events.end() );
+	m_subclasses.insert( m_subclasses.end(), other.m_subclasses.begin(), other.m_subclasses.end() );
+
+	for ( std::vector< wxString >::const_iterator it = other.m_bitmaps.begin(); it != other.m_bitmaps.end(); ++it )
+	{
+		AddBitmap( *it );
+	}
+
+	m_validators.insert( m_validators.end(), other.m_validators.begin(), other.m_validators.end() );
+}
+
+PCodeSummary CodeAnalysis::GetSummary( PObjectBase obj )
+{
+	assert( wxIsMainThread() );
+
+	if ( !obj )
+	{
+		return PCodeSummary( new CodeSummary() );
+	}
+
+	// The project is usually a temporary copy made by the panels, so it is not cached.
+	// Its own properties are collected and the summaries of the forms are reused.
+	if ( obj->GetObjectTypeName() == wxT( "project" ) )
+	{
+		std::shared_ptr< CodeSummary > summary( new CodeSummary() );
+		CollectObject( obj, summary.get() );
+		for ( unsigned int i = 0; i < obj->GetChildCount(); i++ )
+		{
+			summary->Append( *GetSummary( obj->GetChild( i ) ) );
+		}
+		CollectSubclass( obj, summary.get() );
+		return summary;
+	}
+
+	SummaryMap::iterator it = m_summaries.find( obj.get() );
+	if ( it != m_summaries.end() )
+	{
+		return it->second.second;
+	}
+
+	std::shared_ptr< CodeSummary > summary( new CodeSummary() );
+	Collect( obj, summary.get() );
+
+	// Keep the object alive, so its address cannot be reused while it is a key
+	m_summaries[ obj.get() ] = std::make_pair( obj, PCodeSummary( summary ) );
+	return summary;
+}
+
+void CodeAnalysis::Invalidate()
+{
+	assert( wxIsMainThread() );
+
+	m_summaries.clear();
+}
+
+void CodeAnalysis::Collect( PObjectBase obj, CodeSummary* summary )
+{
+	CollectObject( obj, summary );
+
+	for ( unsigned int i = 0; i < obj->GetChildCount(); i++ )
+	{
+		Collect( obj->GetChild( i ), summary );
+	}
+
+	CollectSubclass( obj, summary );
+}
+
+void CodeAnalysis::CollectObject( PObjectBase obj, CodeSummary* summary )
+{
+	PObjectInfo info = obj->GetObjectInfo();
+	if ( info )
+	{
+		summary->m_classes.insert( info );
+	}
+
+	for ( unsigned int i = 0; i < obj->GetPropertyCount(); i++ )
+	{
+		PProperty prop = obj->GetProperty( i );
+		switch ( prop->GetType() )
+		{
+			case PT_MACRO:
+				summary->AddMacro( prop->GetValue() );
+				break;
+			case PT_BITMAP:
+				summary->AddBitmap( prop->GetValue() );
+				break;
+			default:
+				break;
+		}
+	}
+
+	for ( unsigned int i = 0; i < obj->GetEventCount(); i++ )
+	{
+		PEvent event = obj->GetEvent( i );
+		if ( !event->GetValue().empty() )
+		{
+			summary->m_events.push_back( event );
+		}
+	}
+
+	if ( info && HasValidatorTemplate( info ) )
+	{
+		summary->m_validators.push_back( obj );
+	}
+}
+
+void CodeAnalysis::CollectSubclass( PObjectBase obj, CodeSummary* summary )
+{
+	PProperty subclass = obj->GetProperty( wxT( "subclass" ) );
+	if ( !subclass )
+	{
+		return;
+	}
+
+	std::map< wxString, wxString > children;
+	subclass->SplitParentProperty( &children );
+
+	std::map< wxString, wxString >::iterator name = children.find( wxT( "name" ) );
+	if ( children.end() == name || name->second.empty() )
+	{
+		// No name, so do nothing
+		return;
+	}
+
+	CodeSummary::SubclassInfo entry;
+	entry.object = obj;
+	entry.name = name->second;
+
+	std::map< wxString, wxString >::iterator header = children.find( wxT( "header" ) );
+	if ( children.end() != header )
+	{
+		entry.header = header->second;
+	}
+
+	// The value needs to be tested like ObjectInspector does
+	entry.forwardDeclare = true;
+	std::map< wxString, wxString >::iterator forward_declare = children.find( wxT( "forward_declare" ) );
+	if ( children.end() != forward_declare )
+	{
+		entry.forwardDeclare = ( forward_declare->second == forward_declare->first );
+	}
+
+	summary->m_subclasses.push_back( entry );
+}
@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+@file
+Language independent analysis of the object tree, shared by all code generators.
+*/
+
+#ifndef __CODE_ANALYSIS__
+#define __CODE_ANALYSIS__
+
+#include "../utils/wxfbdefs.h"
+
+#include <wx/hashmap.h>
+
+#include <unordered_set>
+
+/**
+* Hashed set of strings, used by the generators to keep output lines unique.
+*/
+typedef std::unordered_set< wxString, wxStringHash, wxStringEqual > StringHashSet;
+
+/**
+* Immutable summary of the information the code generators collect from an object tree.
+*
+* All lists keep the order in which the generators used to find the items walking the tree,
+* so the generated code does not change. Language specific filtering is left to each generator.
+*/
+class CodeSummary
+{
+	friend class CodeAnalysis;
+
+public:
+	/**
+	* An object with a non-empty "subclass" name.
+	*/
+	struct SubclassInfo
+	{
+		PObjectBase object;
+		wxString name;
+		wxString header;
+		bool forwardDeclare;
+	};
+
+	typedef std::vector< SubclassInfo > SubclassVector;
+
+private:
+	std::unordered_set< PObjectInfo > m_classes;
+
+	std::vector< wxString > m_macros;
+	StringHashSet m_macroSet;
+
+	EventVector m_events;
+
+	SubclassVector m_subclasses;
+
+	std::vector< wxString > m_bitmaps;
+	StringHashSet m_bitmapSet;
+
+	ObjectBaseVector m_validators;
+
+	void AddMacro( const wxString& value );
+	void AddBitmap( const wxString& value );
+
+	/**
+	* Appends the items of another summary, keeping macros and bitmaps unique.
+	*/
+	void Append( const CodeSummary& other );
+
+public:
+	/**
+	* Classes of all objects in the tree.
+	*/
+	const std::unordered_set< PObjectInfo >& GetClasses() const { return m_classes; }
+
+	/**
+	* Unique values of the PT_MACRO properties, in tree order (parents before children).
+	*/
+	const std::vector< wxString >& GetMacros() const { return m_macros; }
+
+	/**
+	* Events with a handler, in tree order.
+	*/
+	const EventVector& GetEventHandlers() const { return m_events; }
+
+	/**
+	* Subclassed objects, children before their parents.
+	*/
+	const SubclassVector& GetSubclasses() const { return m_subclasses; }
+
+	/**
+	* Unique non-empty values of the PT_BITMAP properties.
+	*/
+	const std::vector< wxString >& GetEmbeddedBitmaps() const { return m_bitmaps; }
+
+	/**
+	* Objects of a class with a C++ "valvar_declaration" template, its own or of a base class, in tree order.
+	*/
+	const ObjectBaseVector& GetValidatorObjects() const { return m_validators; }
+};
+
+/**
+* Computes and caches the CodeSummary of each form.
+*
+* The cache is owned by ApplicationData and cleared each time the model notifies a change,
+* so a single generation run shares the analysis between all the language generators.
+* It is not locked, it is only used from the main thread: the worker threads of the generation only parse and write files.
+*/
+class CodeAnalysis
+{
+private:
+	typedef std::map< ObjectBase*, std::pair< PObjectBase, PCodeSummary > > SummaryMap;
+	SummaryMap m_summaries;
+
+	void Collect( PObjectBase obj, CodeSummary* summary );
+	void CollectObject( PObjectBase obj, CodeSummary* summary );
+	void CollectSubclass( PObjectBase obj, CodeSummary* summary );
+
+public:
+	/**
+	* Gets the summary of an object tree.
+	* Forms are analysed once and cached, the summary of the project is composed from the summaries of its forms.
+	*/
+	PCodeSummary GetSummary( PObjectBase obj );
+
+	/**
+	* Drops all the cached summaries.
+	*/
+	void Invalidate();
+};
+
+#endif //__CODE_ANALYSIS__
@@ -25,12 +25,15 @@
 
 #include "codegen.h"
 
+#include "templateprofile.h"
 #include "../model/objectbase.h"
 #include "../rad/appdata.h"
 #include "../utils/wxfbexception.h"
 
 #include <wx/tokenzr.h>
 
+#include <chrono>
+
 TemplateParser::TemplateParser(PObjectBase obj, wxString _template)
 :
 m_obj( obj ),
@@ -997,6 +1000,21 @@ wxString TemplateParser::ParseTemplate()
 	return m_out;
 }
 
+wxString TemplateParser::ParseTemplate( const wxString& language, const wxString& className, const wxString& templateName )
+{
+	if ( !TemplateProfile::IsEnabled() )
+	{
+		return ParseTemplate();
+	}
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	wxString code = ParseTemplate();
+	const long long elapsed = std::chrono::duration_cast< std::chrono::microseconds >( std::chrono::steady_clock::now() - start ).count();
+
+	TemplateProfile::Record( language, className, templateName, elapsed, code.utf8_str().length() );
+	return code;
+}
+
 /**
 * Obtaining the template enclosed between '@{' y '@}'.
 * Note: whitespaces at the very start will be ignored.
@@ -1151,3 +1169,8 @@ bool TemplateParser::IsEqual(const wxString& value, const wxString& set)
 
 	return contains;
 }
+
+PCodeSummary CodeGenerator::GetSummary( PObjectBase obj )
+{
+	return AppData()->GetCodeAnalysis()->GetSummary( obj );
+}
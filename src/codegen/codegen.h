@@ -32,6 +32,8 @@
 #ifndef __CODEGEN__
 #define __CODEGEN__
 
+#include "codeanalysis.h"
+
 #include "../model/types.h"
 #include "../utils/wxfbdefs.h"
 
@@ -243,6 +245,12 @@ public:
 	*/
 	wxString ParseTemplate();
 
+	/**
+	* As ParseTemplate(), counting the run in the TemplateProfile when it is enabled.
+	* @param className The class the template belongs to, which can be a base class of the object.
+	*/
+	wxString ParseTemplate( const wxString& language, const wxString& className, const wxString& templateName );
+
 	/**
 	* Set the string for the #pred and #npred macros
 	*/
@@ -271,6 +279,10 @@ public:
 class CodeGenerator
 {
 protected:
+	/**
+	* Gets the analysis of an object tree, shared with the other generators.
+	*/
+	PCodeSummary GetSummary( PObjectBase obj );
 
 public:
 	/**
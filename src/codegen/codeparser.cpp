@@ -1,5 +1,13 @@
 #include "codeparser.h"
 
+#include "../utils/fileutils.h"
+
+#include <wx/convauto.h>
+
+#include <algorithm>
+#include <cwchar>
+#include <string>
+
 wxString RemoveWhiteSpace(wxString str) {
 	size_t index = 0;
 	while (index < str.Len()) {
@@ -44,44 +52,102 @@ wxString Function::GetFunction() {
 // CodeParser
 //---------------------------------------------------
 
-void CCodeParser::ParseCFiles(wxString className) {
-	m_className = className;
-	wxTextFile headerFile(m_hFile);
-	wxTextFile sourceFile(m_cFile);
+namespace {
+bool IsIdentifierChar(wchar_t c) {
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
 
-	wxString header;
-	wxString source;
+/** reads the whole file at once, with the line ends of wxTextFile: '\n' after every line */
+wxString ReadCode(const wxString& path) {
+	std::string data;
+	if (!FileUtils::ReadFile(path, &data)) {
+		return wxT("");
+	}
 
-	// start opening files
-	if (headerFile.Open()) {
-		wxString Str;
+	wxString code(data.data(), wxConvAuto(), data.size());
+	code.Replace(wxT("\r\n"), wxT("\n"));
+	code.Replace(wxT("\r"), wxT("\n"));
+	if (!code.empty() && code.Last() != '\n') {
+		code << wxT('\n');
+	}
+	return code;
+}
 
-		Str = headerFile.GetFirstLine();
-		while (!(headerFile.Eof())) {
-			header << Str;
-			header << wxT('\n');
-			Str = headerFile.GetNextLine();
+/** returns the position after the comment or literal starting at 'pos', or 'pos' if there is none
+ * there */
+size_t SkipCommentOrLiteral(const std::wstring& code, size_t pos) {
+	const wchar_t c = code[pos];
+	if (c == '/' && pos + 1 < code.size()) {
+		if (code[pos + 1] == '/') {
+			const size_t end = code.find('\n', pos);
+			return (end == std::wstring::npos ? code.size() : end);
 		}
-		headerFile.Close();
-	} else {
-		header = wxT("");
+		if (code[pos + 1] == '*') {
+			const size_t end = code.find(L"*/", pos + 2);
+			return (end == std::wstring::npos ? code.size() : end + 2);
+		}
+	} else if (c == '"' || (c == '\'' && (pos == 0 || code[pos - 1] < '0' || code[pos - 1] > '9'))) {
+		// a quote after a digit is a digit separator, not a character literal
+		for (size_t i = pos + 1; i < code.size(); ++i) {
+			if (code[i] == '\\') {
+				++i;
+			} else if (code[i] == c) {
+				return i + 1;
+			} else if (code[i] == '\n') {
+				return i;
+			}
+		}
+		return code.size();
 	}
-	if (sourceFile.Open()) {
-		wxString Str;
-
-		source = sourceFile.GetFirstLine();
-		while (!(sourceFile.Eof())) {
-			source << Str;
-			source << wxT('\n');
-			Str = sourceFile.GetNextLine();
+	return pos;
+}
+
+/** finds the first of 'chars' at or after 'pos' outside of comments and literals */
+size_t FindCode(const std::wstring& code, const wchar_t* chars, size_t pos) {
+	while (pos < code.size()) {
+		const size_t next = SkipCommentOrLiteral(code, pos);
+		if (next != pos) {
+			pos = next;
+		} else if (code[pos] != 0 && wcschr(chars, code[pos])) {
+			return pos;
+		} else {
+			++pos;
 		}
-		sourceFile.Close();
-	} else {
-		source = wxT("");
 	}
+	return std::wstring::npos;
+}
+
+/** returns the position of the bracket closing the one at 'open', or npos if it is not closed */
+size_t FindClosingBracket(const std::wstring& code, size_t open) {
+	size_t depth = 0;
+	for (size_t pos = FindCode(code, L"{}", open); pos != std::wstring::npos;
+	     pos = FindCode(code, L"{}", pos + 1)) {
+		if (code[pos] == '{') {
+			++depth;
+		} else if (--depth == 0) {
+			return pos;
+		}
+	}
+	return std::wstring::npos;
+}
+
+/** finds 'word' at or after 'pos', not preceded by another identifier character */
+size_t FindWord(const std::wstring& code, const std::wstring& word, size_t pos) {
+	for (pos = code.find(word, pos); pos != std::wstring::npos; pos = code.find(word, pos + 1)) {
+		if (pos == 0 || !IsIdentifierChar(code[pos - 1])) {
+			return pos;
+		}
+	}
+	return std::wstring::npos;
+}
+}  // namespace
+
+void CCodeParser::ParseCFiles(wxString className) {
+	m_className = className;
 
 	// parse the file contents
-	ParseCCode(header, source);
+	ParseCCode(ReadCode(m_hFile), ReadCode(m_cFile));
+	m_parsed = true;
 }
 
 void CCodeParser::ParseCCode(wxString header, wxString source) {
@@ -112,10 +178,19 @@ void CCodeParser::ParseCInclude(wxString code) {
 }
 
 void CCodeParser::ParseCClass(wxString code) {
-	int startClass = code.Find(wxT("class ") + m_className);
-	if (startClass != wxNOT_FOUND) {
-		code = ParseBrackets(code, startClass);
-		if (startClass != wxNOT_FOUND) {
+	const std::wstring text = code.ToStdWstring();
+	const std::wstring declaration = (wxT("class ") + m_className).ToStdWstring();
+
+	size_t startClass = FindWord(text, declaration, 0);
+	while (startClass != std::wstring::npos && startClass + declaration.size() < text.size() &&
+	       IsIdentifierChar(text[startClass + declaration.size()])) {
+		startClass = FindWord(text, declaration, startClass + 1);
+	}
+
+	if (startClass != std::wstring::npos) {
+		int classStart = startClass;
+		code = ParseBrackets(code, classStart);
+		if (classStart != wxNOT_FOUND) {
 			ParseCUserMembers(code);
 		}
 	}
@@ -138,125 +213,111 @@ void CCodeParser::ParseCUserMembers(wxString code) {
 }
 
 void CCodeParser::ParseSourceFunctions(wxString code) {
-	int functionStart = 0;
-	int functionEnd = 0;
-	int previousFunctionEnd = 0;
-	wxString funcName, funcArg;
-	Function* func;
-	wxString Str, R;
-
-	int loop = 0;
-	while (1) {
-		// find the begining of the function name
-		Str = m_className + wxT("::");
-		functionStart = code.find(Str, previousFunctionEnd);
-		if (functionStart == wxNOT_FOUND) {
-			// Get the last bit of remaining code after the last function in the file
-			m_trailingCode = code.Mid(previousFunctionEnd);
+	// One sweep over the source, the bodies of the functions found are skipped as a whole
+	const std::wstring text = code.ToStdWstring();
+	const std::wstring scope = (m_className + wxT("::")).ToStdWstring();
+
+	size_t previousFunctionEnd = 0;
+	size_t pos = 0;
+	while (pos < text.size()) {
+		const size_t next = SkipCommentOrLiteral(text, pos);
+		if (next != pos) {
+			pos = next;
+			continue;
+		}
+
+		if (text.compare(pos, scope.size(), scope) != 0 || (pos > 0 && IsIdentifierChar(text[pos - 1]))) {
+			++pos;
+			continue;
+		}
+
+		// a definition of a static member ends before any bracket
+		const size_t functionEnd = FindCode(text, L"{;", pos);
+		if (functionEnd == std::wstring::npos) {
+			break;
+		}
+		if (text[functionEnd] == ';') {
+			pos = functionEnd + 1;
+			continue;
+		}
+
+		const size_t closing = FindClosingBracket(text, functionEnd);
+		if (closing == std::wstring::npos) {
+			wxLogWarning(_("Brackets missing in source file: %s"), m_cFile.c_str());
+			m_trailingCode = wxT("//The Following Block is missing a closing bracket\n//and has been set "
+			                     "aside by wxFormbuilder\n") +
+			                 code.Mid(previousFunctionEnd);
 			m_trailingCode.RemoveLast();
 			return;
 		}
-		// found a function now creat a new function class
-		func = new Function();
 
-		// find the begining of the line on which the function name resides
-		functionStart = code.rfind('\n', functionStart);
-		func->SetDocumentation(code.Mid(previousFunctionEnd, functionStart - previousFunctionEnd));
-		functionStart++;
+		// the heading starts at the begining of the line on which the function name resides
+		size_t functionStart = text.rfind('\n', pos);
+		functionStart = (functionStart == std::wstring::npos ? 0 : functionStart);
+		functionStart = std::max(functionStart, previousFunctionEnd);
 
-		functionEnd = code.find('{', functionStart);
+		Function func;
+		func.SetDocumentation(code.Mid(previousFunctionEnd, functionStart - previousFunctionEnd));
+
+		if (functionStart < functionEnd && text[functionStart] == '\n') {
+			functionStart++;
+		}
 		wxString heading = code.Mid(functionStart, functionEnd - functionStart);
 		if (heading.Right(1) == '\n') {
 			heading.RemoveLast();
 		}
-		func->SetHeading(heading);
+		func.SetHeading(heading);
+		func.SetContents(code.Mid(functionEnd + 1, closing - functionEnd - 1));
 
 		m_functions[RemoveWhiteSpace(heading)] = func;
 
-		// find the opening brackets of the function
-		func->SetContents(ParseBrackets(code, functionStart));
-		if (functionStart != wxNOT_FOUND) {
-			functionEnd = functionStart;
-		} else {
-			wxMessageBox(wxT("Brackets Missing in Source File!"));
-			code.insert(functionEnd + 1,
-			            wxT("//The Following Block is missing a closing bracket\n//and has been "
-			                "set aside by wxFormbuilder\n"));
-			func->SetContents(wxT(""));
-		}
+		previousFunctionEnd = closing + 1;
+		pos = previousFunctionEnd;
+	}
 
-		previousFunctionEnd = functionEnd;
-		if (loop == 100) {
-			return;
-		}
-		loop++;
+	// Get the last bit of remaining code after the last function in the file
+	m_trailingCode = code.Mid(previousFunctionEnd);
+	if (!m_trailingCode.empty()) {
+		m_trailingCode.RemoveLast();
 	}
 }
 
 wxString CCodeParser::ParseBrackets(wxString code, int& functionStart) {
-	int openingBrackets = 0;
-	int closingBrackets = 0;
-	int index = 0;
-	wxString Str;
+	const std::wstring text = code.ToStdWstring();
 
-	int functionLength = 0;
-	index = code.find('{', functionStart);
-	if (index != wxNOT_FOUND) {
-		openingBrackets++;
-		index++;
-		functionStart = index;
-		int loop = 0;
-		while (openingBrackets > closingBrackets) {
-			index = code.find_first_of(wxT("{}"), index);
-			if (index == wxNOT_FOUND) {
-				Str = code.Mid(functionStart, index);
-				functionStart = index;
-				return Str;
-			}
-			if (code.GetChar(index) == '{') {
-				index++;
-				openingBrackets++;
-			} else {
-				index++;
-				closingBrackets++;
-			}
-			if (loop == 100) {
-				return wxT("");
-			}
-			loop++;
-		}
-		index--;
-		functionLength = index - functionStart;
-	} else {
-		wxMessageBox(wxT("no brackets found"));
+	const size_t opening = FindCode(text, L"{", functionStart);
+	if (opening == std::wstring::npos) {
+		functionStart = wxNOT_FOUND;
+		return wxT("");
 	}
-	Str = code.Mid(functionStart, functionLength);
-	functionStart = functionStart + functionLength + 1;
-	return Str;
+
+	const size_t closing = FindClosingBracket(text, opening);
+	if (closing == std::wstring::npos) {
+		functionStart = wxNOT_FOUND;
+		return code.Mid(opening + 1);
+	}
+
+	functionStart = closing + 1;
+	return code.Mid(opening + 1, closing - opening - 1);
 }
 
 wxString CodeParser::GetFunctionDocumentation(wxString function) {
 	wxString contents = wxT("");
-	Function* func;
 
 	m_functionIter = m_functions.find(function);
 	if (m_functionIter != m_functions.end()) {
-		func = m_functionIter->second;
-		contents = func->GetDocumentation();
+		contents = m_functionIter->second.GetDocumentation();
 	}
 	return contents;
 }
 
 wxString CodeParser::GetFunctionContents(wxString function) {
 	wxString contents = wxT("");
-	Function* func;
 
 	m_functionIter = m_functions.find(RemoveWhiteSpace(function));
 	if (m_functionIter != m_functions.end()) {
-		func = m_functionIter->second;
-		contents = func->GetContents();
+		contents = m_functionIter->second.GetContents();
 		m_functions.erase(m_functionIter);
-		delete func;
 	}
 	return contents;
 }
@@ -265,7 +326,7 @@ wxString CodeParser::GetRemainingFunctions() {
 	wxString functions;
 	m_functionIter = m_functions.begin();
 	while (m_functionIter != m_functions.end()) {
-		functions += m_functionIter->second->GetFunction();
+		functions += m_functionIter->second.GetFunction();
 		m_functionIter++;
 	}
 	return functions;
@@ -57,8 +57,9 @@ protected:
 	wxString m_documentation;
 };
 
-/** map class mapping Function* to function name */
-WX_DECLARE_STRING_HASH_MAP(Function*, FunctionMap);
+/** map class mapping Function to function name, the map owns the functions so the parsers can be
+ * copied */
+WX_DECLARE_STRING_HASH_MAP(Function, FunctionMap);
 #define funcIterator FunctionMap::iterator
 
 /** parses the source and header files for all code added to the generated */
@@ -113,13 +114,14 @@ class CCodeParser : public CodeParser {
 private:
 	wxString m_hFile;
 	wxString m_cFile;
+	bool m_parsed;
 
 public:
 	/** constructor */
-	CCodeParser() {
+	CCodeParser() : m_parsed(false) {
 	}
 
-	CCodeParser(wxString headerFileName, wxString sourceFileName) {
+	CCodeParser(wxString headerFileName, wxString sourceFileName) : m_parsed(false) {
 		m_hFile = headerFileName;
 		m_cFile = sourceFileName;
 	}
@@ -129,9 +131,16 @@ public:
 
 	/** c++ Parser */
 
-	/** opens the header and source,  'className' is the Inherited class */
+	/** opens the header and source,  'className' is the Inherited class. The files are read at once
+	 * and scanned in a single pass, comments and literals are skipped. Only the files are touched, so
+	 * the parsers of different classes can run in parallel */
 	void ParseCFiles(wxString className);
 
+	/** true once ParseCFiles has been called */
+	bool IsParsed() const {
+		return m_parsed;
+	}
+
 	/** extracts the contents of the files.  take the the entire contents of both files in string
 	 * form */
 	void ParseCCode(wxString header, wxString source);
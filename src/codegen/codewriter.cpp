@@ -26,7 +26,7 @@
 
 #include "codewriter.h"
 
-#include "../md5/md5.hh"
+#include "../utils/linediff.h"
 #include "../utils/typeconv.h"
 #include "../utils/wxfbexception.h"
 
@@ -36,8 +36,13 @@
 
 #include <wx/stc/stc.h>
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstring>
-#include <fstream>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 CodeWriter::CodeWriter()
 :
@@ -160,14 +165,59 @@ void TCCodeWriter::SetTextCtrl( wxStyledTextCtrl* tc )
 
 void TCCodeWriter::DoWrite( wxString code )
 {
-	if ( m_tc )
-		m_tc->AddText( code );
+	m_buffer += code;
 }
 
 void TCCodeWriter::Clear()
 {
-	if ( m_tc )
-		m_tc->ClearAll(); //*!*
+	m_buffer.clear();
+}
+
+void TCCodeWriter::Flush()
+{
+	if ( !m_tc )
+	{
+		return;
+	}
+
+	const wxString oldText = m_tc->GetText();
+	if ( oldText == m_buffer )
+	{
+		return;
+	}
+
+	std::vector< wxString > oldLines;
+	std::vector< wxString > newLines;
+	LineDiff::SplitLines( oldText, &oldLines );
+	LineDiff::SplitLines( m_buffer, &newLines );
+
+	std::vector< LineDiff::Hunk > hunks;
+	LineDiff::Compare( oldLines, newLines, &hunks );
+
+	const bool readOnly = m_tc->GetReadOnly();
+	m_tc->SetReadOnly( false );
+
+	// Apply from the end, so the positions of the previous lines do not move
+	for ( std::vector< LineDiff::Hunk >::reverse_iterator hunk = hunks.rbegin(); hunk != hunks.rend(); ++hunk )
+	{
+		const size_t oldStart = hunk->oldStart;
+		const size_t oldEnd = hunk->oldEnd;
+
+		wxString text;
+		for ( size_t i = hunk->newStart; i < hunk->newEnd; ++i )
+		{
+			text += newLines[ i ];
+		}
+
+		const int start = ( oldStart < oldLines.size() ? m_tc->PositionFromLine( oldStart ) : m_tc->GetLength() );
+		const int end = ( oldEnd < oldLines.size() ? m_tc->PositionFromLine( oldEnd ) : m_tc->GetLength() );
+
+		m_tc->SetTargetStart( start );
+		m_tc->SetTargetEnd( end );
+		m_tc->ReplaceTarget( text );
+	}
+
+	m_tc->SetReadOnly( readOnly );
 }
 
 StringCodeWriter::StringCodeWriter()
@@ -203,64 +253,185 @@ FileCodeWriter::~FileCodeWriter()
 	WriteBuffer();
 }
 
-void FileCodeWriter::WriteBuffer()
+namespace
 {
-	const static unsigned char MICROSOFT_BOM[3] = { 0xEF, 0xBB, 0xBF };
-
-	// Compare buffer with existing file (if any) to determine if
-	// writing the file is necessary
-	bool shouldWrite = true;
-	std::ifstream fileIn(m_filename.mb_str(wxConvFile), std::ios::binary | std::ios::in);
-
-	std::string buf;
-
-	if (fileIn)
+	/// Returns true if the file has exactly these contents, checking the size first.
+	bool FileContentsEqual( const wxString& filename, const std::string& data )
 	{
-		MD5 diskHash(fileIn);
-		unsigned char* diskDigest = diskHash.raw_digest();
+		if ( !::wxFileExists( filename ) )
+		{
+			return false;
+		}
+
+		wxFile file( filename, wxFile::read );
+		if ( !file.IsOpened() || file.Length() != (wxFileOffset)data.size() )
+		{
+			return false;
+		}
 
-		MD5 bufferHash;
-		if (m_useMicrosoftBOM) {
-			bufferHash.update(MICROSOFT_BOM, 3);
+		char chunk[ 64 * 1024 ];
+		size_t offset = 0;
+		while ( offset < data.size() )
+		{
+			const ssize_t read = file.Read( chunk, std::min( sizeof( chunk ), data.size() - offset ) );
+			if ( read <= 0 || 0 != std::memcmp( chunk, data.data() + offset, read ) )
+			{
+				return false;
+			}
+			offset += read;
 		}
-		const std::string& data = m_useUtf8 ? _STDSTR( m_buffer ) : _ANSISTR( m_buffer );
 
-		if (!m_useUtf8) buf = data;
+		return true;
+	}
 
-		bufferHash.update( reinterpret_cast< const unsigned char* >( data.c_str() ), data.size() );
+	/// Writes the generated files with a few threads.
+	/// The errors are kept to be logged from the main thread.
+	class FileWritePool
+	{
+	private:
+		struct Job
+		{
+			wxString filename;
+			std::string data;
+		};
+
+		std::mutex m_mutex;
+		std::condition_variable m_queued;
+		std::condition_variable m_finished;
+		std::deque< Job > m_jobs;
+		std::vector< std::thread > m_threads;
+		size_t m_running = 0;
+		bool m_stop = false;
+		wxArrayString m_errors;
+
+		void Run()
+		{
+			std::unique_lock< std::mutex > lock( m_mutex );
+			while ( true )
+			{
+				m_queued.wait( lock, [ this ] { return m_stop || !m_jobs.empty(); } );
+				if ( m_jobs.empty() )
+				{
+					return;
+				}
+
+				Job job = std::move( m_jobs.front() );
+				m_jobs.pop_front();
+				++m_running;
+
+				lock.unlock();
+				const wxString error = Write( job );
+				lock.lock();
+
+				if ( !error.empty() )
+				{
+					m_errors.Add( error );
+				}
+
+				--m_running;
+				if ( m_jobs.empty() && 0 == m_running )
+				{
+					m_finished.notify_all();
+				}
+			}
+		}
 
-		bufferHash.finalize();
+		static wxString Write( const Job& job )
+		{
+			if ( FileContentsEqual( job.filename, job.data ) )
+			{
+				return wxEmptyString;
+			}
 
-		unsigned char* bufferDigest = bufferHash.raw_digest();
+			// Written aside and renamed, so the file is never seen half written
+			wxTempFile file( job.filename );
+			if ( !file.IsOpened() || !file.Write( job.data.data(), job.data.size() ) || !file.Commit() )
+			{
+				return wxString::Format( _("Unable to create file: %s"), job.filename.c_str() );
+			}
 
-		shouldWrite = ( 0 != std::memcmp( diskDigest, bufferDigest, 16 ) );
+			return wxEmptyString;
+		}
 
-		delete [] diskDigest;
+	public:
+		~FileWritePool()
+		{
+			{
+				std::lock_guard< std::mutex > lock( m_mutex );
+				m_stop = true;
+			}
+			m_queued.notify_all();
 
-		delete [] bufferDigest;
-	}
+			for ( std::vector< std::thread >::iterator thread = m_threads.begin(); thread != m_threads.end(); ++thread )
+			{
+				thread->join();
+			}
+		}
 
-	if ( shouldWrite )
-	{
-		wxFile fileOut;
-		if (!fileOut.Create(m_filename, true))
+		void Enqueue( const wxString& filename, std::string&& data )
 		{
-			wxLogError( _("Unable to create file: %s"), m_filename.c_str() );
-			return;
+			{
+				std::lock_guard< std::mutex > lock( m_mutex );
+
+				Job job;
+				job.filename = filename;
+				job.data = std::move( data );
+				m_jobs.push_back( std::move( job ) );
+
+				// Started on demand, only as many as there are files waiting
+				const size_t maxThreads = std::max( 2u, std::min( 4u, std::thread::hardware_concurrency() ) );
+				if ( m_threads.size() < maxThreads && m_threads.size() < m_jobs.size() + m_running )
+				{
+					m_threads.push_back( std::thread( &FileWritePool::Run, this ) );
+				}
+			}
+			m_queued.notify_one();
 		}
 
-		if (m_useMicrosoftBOM)
+		wxArrayString Wait()
 		{
-			fileOut.Write(MICROSOFT_BOM, 3);
+			std::unique_lock< std::mutex > lock( m_mutex );
+			m_finished.wait( lock, [ this ] { return m_jobs.empty() && 0 == m_running; } );
+
+			wxArrayString errors;
+			errors.swap( m_errors );
+			return errors;
 		}
+	};
 
-		if (!m_useUtf8)
-			fileOut.Write(buf.c_str(), buf.length());
-		else
-			fileOut.Write(m_buffer);
+	FileWritePool& GetWritePool()
+	{
+		static FileWritePool pool;
+		return pool;
 	}
 }
 
+void FileCodeWriter::WriteBuffer()
+{
+	const static unsigned char MICROSOFT_BOM[3] = { 0xEF, 0xBB, 0xBF };
+
+	// Converted once, the same bytes are compared and written
+	std::string data;
+	if ( m_useMicrosoftBOM )
+	{
+		data.assign( reinterpret_cast< const char* >( MICROSOFT_BOM ), 3 );
+	}
+	data += ( m_useUtf8 ? _STDSTR( m_buffer ) : _ANSISTR( m_buffer ) );
+
+	GetWritePool().Enqueue( m_filename, std::move( data ) );
+}
+
+bool FileCodeWriter::WaitForPendingWrites()
+{
+	const wxArrayString errors = GetWritePool().Wait();
+	for ( size_t i = 0; i < errors.GetCount(); ++i )
+	{
+		wxLogError( errors[i] );
+	}
+
+	return errors.IsEmpty();
+}
+
 void FileCodeWriter::Clear()
 {
 	StringCodeWriter::Clear();
@@ -82,10 +82,15 @@ public:
 
 class wxStyledTextCtrl;
 
+/** Writes the code to a wxStyledTextCtrl.
+The code is buffered until Flush() is called, which only replaces the lines that changed,
+so the control keeps the styling, caret and scroll position of the untouched regions.
+*/
 class TCCodeWriter : public CodeWriter
 {
 private:
 	wxStyledTextCtrl* m_tc;
+	wxString m_buffer;
 
 protected:
 	void DoWrite(wxString code) override;
@@ -95,6 +100,9 @@ public:
     TCCodeWriter( wxStyledTextCtrl *tc );
     void SetTextCtrl( wxStyledTextCtrl* tc );
 	void Clear() override;
+
+	/// Applies the code written since the last Clear() to the control.
+	void Flush();
 };
 
 class StringCodeWriter : public CodeWriter
@@ -109,6 +117,10 @@ public:
 	wxString GetString();
 };
 
+/** Writes the code to a file when destroyed.
+The file is only rewritten if the contents changed. The writes are done in background threads,
+WaitForPendingWrites() must be called before using the files.
+*/
 class FileCodeWriter : public StringCodeWriter
 {
 private:
@@ -123,6 +135,10 @@ public:
 	FileCodeWriter( const wxString &file, bool useMicrosoftBOM = false, bool useUtf8 = true );
 	~FileCodeWriter() override;
 	void Clear() override;
+
+	/// Blocks until the files of the destroyed writers are written, logs the errors.
+	/// @return false if a file could not be written.
+	static bool WaitForPendingWrites();
 };
 
 #endif //__CODE_WRITER__
@@ -420,7 +420,10 @@ void CppCodeGenerator::GenerateInheritedClass( PObjectBase userClasses, PObjectB
 		return;
 	}
 
-	m_inheritedCodeParser.ParseCFiles(userClasses->GetPropertyAsString( _("name") ));
+	if ( !m_inheritedCodeParser.IsParsed() )
+	{
+		m_inheritedCodeParser.ParseCFiles( userClasses->GetPropertyAsString( _("name") ) );
+	}
 
 	//(FileCodeWriter*)m_header->
 	wxString type = userClasses->GetPropertyAsString( wxT("type") );
@@ -472,8 +475,8 @@ void CppCodeGenerator::GenerateInheritedClass( PObjectBase userClasses, PObjectB
 	m_source->WriteLn( wxT("}") );
 
 	// Do events in both files
-	EventVector events;
-	FindEventHandlers( form, events );
+	PCodeSummary summary = GetSummary( form );
+	const EventVector& events = summary->GetEventHandlers();
 
 	if ( events.size() > 0 )
 	{
@@ -623,7 +626,10 @@ bool CppCodeGenerator::GenerateCode( PObjectBase project )
 	std::set< wxString > subclassSourceIncludes;
 	std::vector< wxString > headerIncludes;
 
-	GenSubclassSets( project, &subclasses, &subclassSourceIncludes, &headerIncludes );
+	StringHashSet headerIncludeSet;
+
+	PCodeSummary summary = GetSummary( project );
+	GenSubclassSets( summary, &subclasses, &subclassSourceIncludes, &headerIncludes, &headerIncludeSet );
 
 	// Write the forward declaration lines
 	std::set< wxString >::iterator subclass_it;
@@ -638,7 +644,7 @@ bool CppCodeGenerator::GenerateCode( PObjectBase project )
 
 	// Generating in the .h header file those include from components dependencies.
 	std::set< wxString > templates;
-	GenIncludes( project, &headerIncludes, &templates );
+	GenIncludes( project, &headerIncludes, &headerIncludeSet, &templates );
 
 	// Write the include lines
 	std::vector<wxString>::iterator include_it;
@@ -682,8 +688,7 @@ bool CppCodeGenerator::GenerateCode( PObjectBase project )
 			if ( !headerVal.empty() )
 			{
 				wxString include = wxT( "#include \"" ) + headerVal + wxT( "\"" );
-				std::vector< wxString >::iterator findInclude = std::find( headerIncludes.begin(), headerIncludes.end(), include );
-				if ( findInclude == headerIncludes.end() )
+				if ( headerIncludeSet.find( include ) == headerIncludeSet.end() )
 				{
 					m_header->WriteLn( include );
 					m_header->WriteLn( wxEmptyString );
@@ -719,7 +724,7 @@ bool CppCodeGenerator::GenerateCode( PObjectBase project )
 	m_source->WriteLn( wxT( "#include \"" ) + file + wxT( ".h\"" ) );
 
 	m_source->WriteLn( wxEmptyString );
-	GenEmbeddedBitmapIncludes( project );
+	GenEmbeddedBitmapIncludes( summary );
 
 	code = GetCode( project, wxT( "cpp_epilogue" ) );
 	m_source->WriteLn( code );
@@ -758,15 +763,15 @@ bool CppCodeGenerator::GenerateCode( PObjectBase project )
 	// Generating "defines" for macros
 	if ( !useEnum )
 	{
-		GenDefines( project );
+		GenDefines( summary );
 	}
 
 	for ( unsigned int i = 0; i < project->GetChildCount(); i++ )
 	{
 		PObjectBase child = project->GetChild( i );
 
-		EventVector events;
-		FindEventHandlers( child, events );
+		PCodeSummary childSummary = GetSummary( child );
+		const EventVector& events = childSummary->GetEventHandlers();
 		GenClassDeclaration( child, useEnum, classDecoration, events );
 		if ( !m_useConnect )
 		{
@@ -886,7 +891,7 @@ bool CppCodeGenerator::GenEventEntry( PObjectBase obj, PObjectInfo obj_info, con
 		{
 			_template.Replace( wxT( "#handler" ), handlerName.c_str() ); // Ugly patch!
 			CppTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath );
-			m_source->WriteLn( parser.ParseTemplate() );
+			m_source->WriteLn( parser.ParseTemplate( wxT( "C++" ), obj_info->GetClassName(), wxT( "evt_" ) + templateName ) );
 			return true;
 		}
 	}
@@ -987,13 +992,12 @@ void CppCodeGenerator::GenAttributeDeclaration( PObjectBase obj, Permission perm
 }
 void CppCodeGenerator::GenValidatorVariables( PObjectBase obj )
 {
-	GenValVarsBase( obj->GetObjectInfo(), obj );
-
-	// Proceeding recursively with the children
-	for ( unsigned int i = 0; i < obj->GetChildCount() ; i++ )
+	// Only the objects of a class with the template can produce a declaration
+	PCodeSummary summary = GetSummary( obj );
+	const ObjectBaseVector& validators = summary->GetValidatorObjects();
+	for ( ObjectBaseVector::const_iterator it = validators.begin(); it != validators.end(); ++it )
 	{
-		PObjectBase child = obj->GetChild( i );
-		GenValidatorVariables( child );
+		GenValVarsBase( ( *it )->GetObjectInfo(), *it );
 	}
 }
 
@@ -1012,7 +1016,7 @@ void CppCodeGenerator::GenValVarsBase( PObjectInfo info, PObjectBase obj )
 	if ( !_template.empty() )
 	{
 		CppTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath );
-		wxString code = parser.ParseTemplate();
+		wxString code = parser.ParseTemplate( wxT( "C++" ), info->GetClassName(), wxT( "valvar_declaration" ) );
 		if ( !code.empty() )
 		{
 			m_header->WriteLn( code );
@@ -1048,7 +1052,7 @@ void CppCodeGenerator::GenDefinedEventHandlers( PObjectInfo info, PObjectBase ob
 		if ( !_template.empty() )
 		{
 			CppTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath );
-			wxString code = parser.ParseTemplate();
+			wxString code = parser.ParseTemplate( wxT( "C++" ), info->GetClassName(), wxT( "generated_event_handlers" ) );
 
 			if ( !code.empty() )
 			{
@@ -1088,7 +1092,7 @@ wxString CppCodeGenerator::GetCode( PObjectBase obj, wxString name )
 	}
 
 	CppTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath );
-	wxString code = parser.ParseTemplate();
+	wxString code = parser.ParseTemplate( wxT( "C++" ), obj->GetClassName(), name );
 
 	return code;
 }
@@ -1204,7 +1208,7 @@ void CppCodeGenerator::GenClassDeclaration( PObjectBase class_obj, bool use_enum
 void CppCodeGenerator::GenEnumIds( PObjectBase class_obj )
 {
 	std::vector< wxString > macros;
-	FindMacros( class_obj, &macros );
+	FindMacros( GetSummary( class_obj ), &macros );
 
 	std::vector< wxString >::iterator it = macros.begin();
 	if ( it != macros.end() )
@@ -1246,45 +1250,13 @@ void CppCodeGenerator::GenEnumIds( PObjectBase class_obj )
 	}
 }
 
-void CppCodeGenerator::GenSubclassSets( PObjectBase obj, std::set< wxString >* subclasses, std::set< wxString >* sourceIncludes, std::vector< wxString >* headerIncludes )
+void CppCodeGenerator::GenSubclassSets( PCodeSummary summary, std::set< wxString >* subclasses, std::set< wxString >* sourceIncludes, std::vector< wxString >* headerIncludes, StringHashSet* headerIncludeSet )
 {
-	// Call GenSubclassForwardDeclarations on all children as well
-	for ( unsigned int i = 0; i < obj->GetChildCount(); i++ )
+	const CodeSummary::SubclassVector& subclassInfos = summary->GetSubclasses();
+	for ( CodeSummary::SubclassVector::const_iterator subclass = subclassInfos.begin(); subclass != subclassInfos.end(); ++subclass )
 	{
-		GenSubclassSets( obj->GetChild( i ), subclasses, sourceIncludes, headerIncludes );
-	}
-
-	// Fill the set
-	PProperty subclass = obj->GetProperty( wxT( "subclass" ) );
-	if ( subclass )
-	{
-		std::map< wxString, wxString > children;
-		subclass->SplitParentProperty( &children );
-
-		std::map< wxString, wxString >::iterator name;
-		name = children.find( wxT( "name" ) );
-
-		if ( children.end() == name )
-		{
-			// No name, so do nothing
-			return;
-		}
-
-		wxString nameVal = name->second;
-		if ( nameVal.empty() )
-		{
-			// No name, so do nothing
-			return;
-		}
-
-		//check if user wants to include the header or forward declare
-		bool forward_declare = true;
-		std::map< wxString, wxString >::iterator forward_declare_it = children.find( wxT( "forward_declare" ) );
-		if ( children.end() != forward_declare_it )
-		{
-			// The value needs to be tested like ObjectInspector does
-			forward_declare = (forward_declare_it->second == forward_declare_it->first);
-		}
+		PObjectBase obj = subclass->object;
+		wxString nameVal = subclass->name;
 
 		//get namespaces
 		wxString originalValue = nameVal;
@@ -1316,49 +1288,37 @@ void CppCodeGenerator::GenSubclassSets( PObjectBase obj, std::set< wxString >* s
 							  _( "subclass" ),
 							  originalValue.c_str()
 						   );
-				return;
+				continue;
 			}
 
 			forwardDecl = subClassPrefix + wxT( "class " ) + nameVal + wxT( ";" ) + subClassSuffix;
 		}
 
-		// Now get the header
-		std::map< wxString, wxString >::iterator header;
-		header = children.find( wxT( "header" ) );
-
-		if ( children.end() == header )
-		{
-			// No header, so do nothing
-			return;
-		}
-
-		wxString headerVal = header->second;
-		if ( headerVal.empty() )
+		if ( subclass->header.empty() )
 		{
 			// No header, so do nothing
-			return;
+			continue;
 		}
 
 		// Got a header
 		PObjectInfo info = obj->GetObjectInfo();
 		if ( !info )
 		{
-			return;
+			continue;
 		}
 
 		PObjectPackage pkg = info->GetPackage();
 		if ( !pkg )
 		{
-			return;
+			continue;
 		}
 
-		wxString include = wxT( "#include \"" ) + headerVal + wxT( "\"" );
+		wxString include = wxT( "#include \"" ) + subclass->header + wxT( "\"" );
 		if ( pkg->GetPackageName() == wxT( "Forms" ) ||
 			 obj->GetChild( 1, wxT("menu") ) ||
-			 !forward_declare )
+			 !subclass->forwardDeclare )
 		{
-			std::vector< wxString >::iterator it = std::find( headerIncludes->begin(), headerIncludes->end(), include );
-			if ( headerIncludes->end() == it )
+			if ( headerIncludeSet->insert( include ).second )
 			{
 				headerIncludes->push_back( include );
 			}
@@ -1371,17 +1331,17 @@ void CppCodeGenerator::GenSubclassSets( PObjectBase obj, std::set< wxString >* s
 	}
 }
 
-void CppCodeGenerator::GenIncludes( PObjectBase project, std::vector<wxString>* includes, std::set< wxString >* templates )
+void CppCodeGenerator::GenIncludes( PObjectBase project, std::vector<wxString>* includes, StringHashSet* includeSet, std::set< wxString >* templates )
 {
-	GenObjectIncludes( project, includes, templates );
+	GenObjectIncludes( project, includes, includeSet, templates );
 }
 
-void CppCodeGenerator::GenObjectIncludes( PObjectBase project, std::vector< wxString >* includes, std::set< wxString >* templates )
+void CppCodeGenerator::GenObjectIncludes( PObjectBase project, std::vector< wxString >* includes, StringHashSet* includeSet, std::set< wxString >* templates )
 {
 	// Call GenIncludes on all children as well
 	for ( unsigned int i = 0; i < project->GetChildCount(); i++ )
 	{
-		GenObjectIncludes( project->GetChild( i ), includes, templates );
+		GenObjectIncludes( project->GetChild( i ), includes, includeSet, templates );
 	}
 
 	// Fill the set
@@ -1389,21 +1349,21 @@ void CppCodeGenerator::GenObjectIncludes( PObjectBase project, std::vector< wxSt
 	if ( code_info )
 	{
 		CppTemplateParser parser( project, code_info->GetTemplate( wxT( "include" ) ), m_i18n, m_useRelativePath, m_basePath );
-		wxString include = parser.ParseTemplate();
+		wxString include = parser.ParseTemplate( wxT( "C++" ), project->GetClassName(), wxT( "include" ) );
 		if ( !include.empty() )
 		{
 			if ( templates->insert( include ).second )
 			{
-				AddUniqueIncludes( include, includes );
+				AddUniqueIncludes( include, includes, includeSet );
 			}
 		}
 	}
 
 	// Generate includes for base classes
-	GenBaseIncludes( project->GetObjectInfo(), project, includes, templates );
+	GenBaseIncludes( project->GetObjectInfo(), project, includes, includeSet, templates );
 }
 
-void CppCodeGenerator::GenBaseIncludes( PObjectInfo info, PObjectBase obj, std::vector< wxString >* includes, std::set< wxString >* templates )
+void CppCodeGenerator::GenBaseIncludes( PObjectInfo info, PObjectBase obj, std::vector< wxString >* includes, StringHashSet* includeSet, std::set< wxString >* templates )
 {
 	if ( !info )
 	{
@@ -1414,25 +1374,25 @@ void CppCodeGenerator::GenBaseIncludes( PObjectInfo info, PObjectBase obj, std::
 	for ( unsigned int i = 0; i < info->GetBaseClassCount(false); i++ )
 	{
 		PObjectInfo base_info = info->GetBaseClass( i, false );
-		GenBaseIncludes( base_info, obj, includes, templates );
+		GenBaseIncludes( base_info, obj, includes, includeSet, templates );
 	}
 
 	PCodeInfo code_info = info->GetCodeInfo( wxT( "C++" ) );
 	if ( code_info )
 	{
 		CppTemplateParser parser( obj, code_info->GetTemplate( wxT( "include" ) ), m_i18n, m_useRelativePath, m_basePath );
-		wxString include = parser.ParseTemplate();
+		wxString include = parser.ParseTemplate( wxT( "C++" ), info->GetClassName(), wxT( "include" ) );
 		if ( !include.empty() )
 		{
 			if ( templates->insert( include ).second )
 			{
-				AddUniqueIncludes( include, includes );
+				AddUniqueIncludes( include, includes, includeSet );
 			}
 		}
 	}
 }
 
-void CppCodeGenerator::AddUniqueIncludes( const wxString& include, std::vector< wxString >* includes )
+void CppCodeGenerator::AddUniqueIncludes( const wxString& include, std::vector< wxString >* includes, StringHashSet* includeSet )
 {
 	// Split on newlines to only generate unique include lines
 	// This strips blank lines and trims
@@ -1456,43 +1416,15 @@ void CppCodeGenerator::AddUniqueIncludes( const wxString& include, std::vector<
 			inPreproc = false;
 		}
 
-		if ( inPreproc )
-		{
-			includes->push_back( line );
-			continue;
-		}
-
-		// If it is not an include line, it will be written
-		if ( !line.StartsWith( wxT( "#include" ) ) )
-		{
-			includes->push_back( line );
-			continue;
-		}
-
-		// If it is an include, it must be unique to be written
-		std::vector< wxString >::iterator it = std::find( includes->begin(), includes->end(), line );
-		if ( includes->end() == it )
+		// If it is an include outside of a preprocessor block, it must be unique to be written
+		bool isNew = includeSet->insert( line ).second;
+		if ( isNew || inPreproc || !line.StartsWith( wxT( "#include" ) ) )
 		{
 			includes->push_back( line );
 		}
 	}
 }
 
-void CppCodeGenerator::FindDependencies( PObjectBase obj, std::set< PObjectInfo >& info_set )
-{
-	unsigned int ch_count = obj->GetChildCount();
-	if ( ch_count > 0 )
-	{
-		unsigned int i;
-		for ( i = 0; i < ch_count; i++ )
-		{
-			PObjectBase child = obj->GetChild( i );
-			info_set.insert( child->GetObjectInfo() );
-			FindDependencies( child, info_set );
-		}
-	}
-}
-
 void CppCodeGenerator::GenConstructor( PObjectBase class_obj, const EventVector &events )
 {
 	m_source->WriteLn();
@@ -1775,57 +1707,25 @@ void CppCodeGenerator::GenConstruction( PObjectBase obj, bool is_widget )
 	}
 }
 
-void CppCodeGenerator::FindMacros( PObjectBase obj, std::vector<wxString>* macros )
+void CppCodeGenerator::FindMacros( PCodeSummary summary, std::vector<wxString>* macros )
 {
-	// iterate through all of the properties of all objects, add the macros
-	// to the vector
-	unsigned int i;
-
-	for ( i = 0; i < obj->GetPropertyCount(); i++ )
+	// The summary holds the unique macros of all objects, only the wx IDs
+	// have to be skipped here
+	const std::vector< wxString >& values = summary->GetMacros();
+	for ( std::vector< wxString >::const_iterator value = values.begin(); value != values.end(); ++value )
 	{
-		PProperty prop = obj->GetProperty( i );
-		if ( prop->GetType() == PT_MACRO )
+		if ( ( ! value->Contains( wxT("XRCID" ) ) ) &&
+			 ( m_predMacros.end() == m_predMacros.find( *value ) ) )
 		{
-			wxString value = prop->GetValue();
-			// Skip wx IDs
-			if ( ( ! value.Contains( wxT("XRCID" ) ) ) &&
-				 ( m_predMacros.end() == m_predMacros.find( value ) ) )
-			{
-				if ( macros->end() == std::find( macros->begin(), macros->end(), value ) )
-				{
-					macros->push_back( value );
-				}
-			}
+			macros->push_back( *value );
 		}
 	}
-
-	for ( i = 0; i < obj->GetChildCount(); i++ )
-	{
-		FindMacros( obj->GetChild( i ), macros );
-	}
 }
 
-void CppCodeGenerator::FindEventHandlers( PObjectBase obj, EventVector &events )
-{
-	unsigned int i;
-	for ( i = 0; i < obj->GetEventCount(); i++ )
-	{
-		PEvent event = obj->GetEvent( i );
-		if ( !event->GetValue().IsEmpty() )
-			events.push_back( event );
-	}
-
-	for ( i = 0; i < obj->GetChildCount(); i++ )
-	{
-		PObjectBase child = obj->GetChild( i );
-		FindEventHandlers( child, events );
-	}
-}
-
-void CppCodeGenerator::GenDefines( PObjectBase project )
+void CppCodeGenerator::GenDefines( PCodeSummary summary )
 {
 	std::vector< wxString > macros;
-	FindMacros( project, &macros );
+	FindMacros( summary, &macros );
 
 	// Remove the default macro from the set, for backward compatiblity
 	std::vector< wxString >::iterator it;
@@ -1867,7 +1767,7 @@ void CppCodeGenerator::GenSettings( PObjectInfo info, PObjectBase obj )
 	if ( !_template.empty() )
 	{
 		CppTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath );
-		wxString code = parser.ParseTemplate();
+		wxString code = parser.ParseTemplate( wxT( "C++" ), info->GetClassName(), wxT( "settings" ) );
 		if ( !code.empty() )
 		{
 			m_source->WriteLn( code );
@@ -1894,7 +1794,7 @@ void CppCodeGenerator::GenDestruction( PObjectBase obj )
 		if ( !_template.empty() )
 		{
 			CppTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath );
-			wxString code = parser.ParseTemplate();
+			wxString code = parser.ParseTemplate( wxT( "C++" ), obj->GetClassName(), wxT( "destruction" ) );
 			if ( !code.empty() )
 			{
 				m_source->WriteLn( code );
@@ -1932,7 +1832,7 @@ void CppCodeGenerator::GetAddToolbarCode( PObjectInfo info, PObjectBase obj, wxA
 	if ( !_template.empty() )
 	{
 		CppTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath );
-		wxString code = parser.ParseTemplate();
+		wxString code = parser.ParseTemplate( wxT( "C++" ), info->GetClassName(), wxT( "toolbar_add" ) );
 		if ( !code.empty() )
 		{
 			if( codelines.Index( code ) == wxNOT_FOUND ) codelines.Add( code );
@@ -1950,12 +1850,12 @@ void CppCodeGenerator::GetAddToolbarCode( PObjectInfo info, PObjectBase obj, wxA
 ///////////////////////////////////////////////////////////////////////
 
 
-void CppCodeGenerator::GenEmbeddedBitmapIncludes( PObjectBase project )
+void CppCodeGenerator::GenEmbeddedBitmapIncludes( PCodeSummary summary )
 {
 	std::set< wxString > include_set;
 
 	// We begin obtaining the "include" list
-	FindEmbeddedBitmapProperties( project, include_set );
+	FindEmbeddedBitmapProperties( summary, include_set );
 
 	if ( include_set.empty() )
 	{
@@ -1975,62 +1875,45 @@ void CppCodeGenerator::GenEmbeddedBitmapIncludes( PObjectBase project )
 	m_source->WriteLn();
 }
 
-void CppCodeGenerator::FindEmbeddedBitmapProperties( PObjectBase obj, std::set<wxString>& embedset )
+void CppCodeGenerator::FindEmbeddedBitmapProperties( PCodeSummary summary, std::set<wxString>& embedset )
 {
-	// We go through (browse) for each property in "obj" object. If any of the
-	// PT_BITMAP type is found, then the proper "include" string is added
-	// in "set". After that, we recursively do it the same with the child objects.
-	unsigned int i, count;
-
-	count = obj->GetPropertyCount();
-
-	for ( i = 0; i < count; i++ )
-	{
-		PProperty property = obj->GetProperty( i );
-		if ( property->GetType() == PT_BITMAP )
-		{
-			wxString propValue = property->GetValue();
-
-			wxString path;
-			wxString source;
-			wxSize icoSize;
-			TypeConv::ParseBitmapWithResource( propValue, &path, &source, &icoSize );
-
-			wxFileName bmpFileName( path );
-			if ( bmpFileName.GetExt().Upper() == wxT( "XPM" ) )
-			{
-				wxString absPath = TypeConv::MakeAbsolutePath( path, AppData()->GetProjectPath() );
-
-				// It's supposed that "path" contains an absolut path to the file
-				// and not a relative one.
-				wxString relPath = ( m_useRelativePath ? TypeConv::MakeRelativePath( absPath, m_basePath ) : absPath );
-
-				wxString inc;
-				inc << wxT( "#include \"" ) << relPath << wxT( "\"" );
-				embedset.insert( inc );
-			}
-			else if ( source == _("Load From Embedded File") )
-			{
-				wxString absPath = TypeConv::MakeAbsolutePath( path, AppData()->GetProjectPath() );
-				wxString includePath = FileToCArray::Generate( absPath );
-				wxString inc;
-				inc << wxT( "#include \"" ) << includePath << wxT( "\"" );
-				embedset.insert( inc );
-			}
-			// NOTE: This is currently not necessary because the default code already contains this header.
-			//       Because the unique include filtering is not global this cannot be enabled without creating a duplicate entry.
-			//else if (source == _("Load From XRC"))
-			//{
-			//	embedset.insert(wxT("#include <wx/xrc/xmlres.h>"));
-			//}
-		}
-	}
-
-	count = obj->GetChildCount();
-	for ( i = 0; i < count; i++ )
-	{
-		PObjectBase child = obj->GetChild( i );
-		FindEmbeddedBitmapProperties( child, embedset );
+	// We go through (browse) each PT_BITMAP value of the tree, and the proper
+	// "include" string is added in "set".
+	const std::vector< wxString >& bitmaps = summary->GetEmbeddedBitmaps();
+	for ( std::vector< wxString >::const_iterator propValue = bitmaps.begin(); propValue != bitmaps.end(); ++propValue )
+	{
+		wxString path;
+		wxString source;
+		wxSize icoSize;
+		TypeConv::ParseBitmapWithResource( *propValue, &path, &source, &icoSize );
+
+		wxFileName bmpFileName( path );
+		if ( bmpFileName.GetExt().Upper() == wxT( "XPM" ) )
+		{
+			wxString absPath = TypeConv::MakeAbsolutePath( path, AppData()->GetProjectPath() );
+
+			// It's supposed that "path" contains an absolut path to the file
+			// and not a relative one.
+			wxString relPath = ( m_useRelativePath ? TypeConv::MakeRelativePath( absPath, m_basePath ) : absPath );
+
+			wxString inc;
+			inc << wxT( "#include \"" ) << relPath << wxT( "\"" );
+			embedset.insert( inc );
+		}
+		else if ( source == _("Load From Embedded File") )
+		{
+			wxString absPath = TypeConv::MakeAbsolutePath( path, AppData()->GetProjectPath() );
+			wxString includePath = FileToCArray::Generate( absPath );
+			wxString inc;
+			inc << wxT( "#include \"" ) << includePath << wxT( "\"" );
+			embedset.insert( inc );
+		}
+		// NOTE: This is currently not necessary because the default code already contains this header.
+		//       Because the unique include filtering is not global this cannot be enabled without creating a duplicate entry.
+		//else if (source == _("Load From XRC"))
+		//{
+		//	embedset.insert(wxT("#include <wx/xrc/xmlres.h>"));
+		//}
 	}
 }
 
@@ -97,26 +97,16 @@ private:
 	*/
 	wxString GetCode( PObjectBase obj, wxString name);
 
-	/**
-	* Stores the project's objects classes set, for generating the includes.
-	*/
-	void FindDependencies( PObjectBase obj, std::set< PObjectInfo >& info_set );
-
 	/**
 	* Stores the needed "includes" set for the PT_BITMAP properties.
 	*/
-	void FindEmbeddedBitmapProperties( PObjectBase obj, std::set< wxString >& embedset);
+	void FindEmbeddedBitmapProperties( PCodeSummary summary, std::set< wxString >& embedset);
 
 	/**
 	* Stores all the properties for "macro" type objects, so that their
 	* related '#define' can be generated subsequently.
 	*/
-	void FindMacros( PObjectBase obj, std::vector< wxString >* macros );
-
-	/**
-	 * Looks for "non-null" event handlers (PEvent) and collects it into a vector.
-	 */
-	void FindEventHandlers(PObjectBase obj, EventVector &events);
+	void FindMacros( PCodeSummary summary, std::vector< wxString >* macros );
 
 	/**
 	* Generates classes declarations inside the header file.
@@ -139,7 +129,7 @@ private:
 	void GenAttributeDeclaration( PObjectBase obj, Permission perm);
 
 	/**
-	* Recursive function for the validators' variables declaration, used inside GenClassDeclaration.
+	* Generates the validators' variables declaration, used inside GenClassDeclaration.
 	*/
 	void GenValidatorVariables( PObjectBase obj);
 	/**
@@ -159,26 +149,26 @@ private:
 	/**
 	* Generates the '#include' section for files.
 	*/
-	void GenIncludes( PObjectBase project, std::vector< wxString >* includes, std::set< wxString >* templates );
-	void GenObjectIncludes( PObjectBase project, std::vector< wxString >* includes, std::set< wxString >* templates );
-	void GenBaseIncludes( PObjectInfo info, PObjectBase obj, std::vector< wxString >* includes, std::set< wxString >* templates );
-	void AddUniqueIncludes( const wxString& include, std::vector< wxString >* includes );
+	void GenIncludes( PObjectBase project, std::vector< wxString >* includes, StringHashSet* includeSet, std::set< wxString >* templates );
+	void GenObjectIncludes( PObjectBase project, std::vector< wxString >* includes, StringHashSet* includeSet, std::set< wxString >* templates );
+	void GenBaseIncludes( PObjectInfo info, PObjectBase obj, std::vector< wxString >* includes, StringHashSet* includeSet, std::set< wxString >* templates );
+	void AddUniqueIncludes( const wxString& include, std::vector< wxString >* includes, StringHashSet* includeSet );
 
 	/**
 	* Generate a set of all subclasses to forward declare in the generated header file.
 	* Also generate sets of header files to be include in either the source or header file.
 	*/
-	void GenSubclassSets( PObjectBase obj, std::set< wxString >* subclasses, std::set< wxString >* sourceIncludes, std::vector< wxString >* headerIncludes );
+	void GenSubclassSets( PCodeSummary summary, std::set< wxString >* subclasses, std::set< wxString >* sourceIncludes, std::vector< wxString >* headerIncludes, StringHashSet* headerIncludeSet );
 
 	/**
 	* Generates the '#include' section for the embedded bitmap properties.
 	*/
-	void GenEmbeddedBitmapIncludes( PObjectBase project);
+	void GenEmbeddedBitmapIncludes( PCodeSummary summary );
 
 	/**
 	* Generates the '#define' section for macros.
 	*/
-	void GenDefines( PObjectBase project);
+	void GenDefines( PCodeSummary summary );
 
 	/**
 	* Generates an enum with wxWindow identifiers.
@@ -267,6 +257,14 @@ public:
 		m_inheritedCodeParser = CCodeParser(headerFile, sourceFile);
 	}
 
+	/**
+	* Uses the already parsed files, so those of many classes can be parsed in parallel
+	*/
+	void SetParsedFiles( CCodeParser parser )
+	{
+		m_inheritedCodeParser = std::move( parser );
+	}
+
 	/**
 	* Configures the reference path for generating relative paths to
 	* that passed as parameter.
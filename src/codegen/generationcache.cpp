@@ -0,0 +1,189 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "generationcache.h"
+
+#include "codeanalysis.h"
+#include "templateprofile.h"
+
+#include "../md5/md5.hh"
+#include "../model/objectbase.h"
+#include "../rad/appdata.h"
+#include "../rad/mainframe.h"
+#include "../utils/typeconv.h"
+
+#include <ticpp.h>
+#include <wx/fileconf.h>
+#include <wx/filename.h>
+#include <wx/stdpaths.h>
+
+namespace
+{
+	void Update( MD5* md5, const std::string& data )
+	{
+		md5->update( reinterpret_cast< const unsigned char* >( data.c_str() ), data.size() );
+		md5->update( reinterpret_cast< const unsigned char* >( "\n" ), 1 );
+	}
+
+	void Update( MD5* md5, const wxString& data )
+	{
+		Update( md5, std::string( data.utf8_str() ) );
+	}
+
+	// "<size> <time>" of a file, empty if it does not exist
+	wxString GetFileStamp( const wxString& path )
+	{
+		wxFileName file( path );
+		if ( !file.FileExists() )
+		{
+			return wxEmptyString;
+		}
+
+		return wxString::Format( wxT("%s %lld"), file.GetSize().ToString().c_str(), (long long)file.GetModificationTime().GetValue().GetValue() );
+	}
+}
+
+GenerationCache::GenerationCache( const wxString& path, const wxString& file, const wxString& directory )
+{
+	MD5 md5;
+	Update( &md5, path );
+	Update( &md5, file );
+	md5.finalize();
+	char* digest = md5.hex_digest();
+	m_manifest = wxFileName( directory, wxString::FromAscii( digest ) + wxT(".fbcache") ).GetFullPath();
+	delete [] digest;
+}
+
+wxString GenerationCache::GetDefaultDirectory()
+{
+	return wxFileName( wxStandardPaths::Get().GetUserDataDir(), wxT("generation") ).GetFullPath();
+}
+
+wxString GenerationCache::ComputeKey( PObjectBase project, const wxString& language )
+{
+	MD5 md5;
+	Update( &md5, std::string( VERSION ) );
+	Update( &md5, language );
+	Update( &md5, AppData()->GetObjectDatabase()->GetCodeGenSignature() );
+	Update( &md5, AppData()->GetProjectPath() );
+	Update( &md5, AppData()->GetOutputPath() );
+
+	// The whole tree, as it would be saved
+	ticpp::Document doc;
+	project->Serialize( &doc );
+
+	TiXmlPrinter printer;
+	printer.SetStreamPrinting();
+	doc.Accept( &printer );
+	Update( &md5, std::string( printer.CStr(), printer.Size() ) );
+
+	// The contents of the bitmaps can be embedded in the code
+	const std::vector< wxString >& bitmaps = AppData()->GetCodeAnalysis()->GetSummary( project )->GetEmbeddedBitmaps();
+	for ( std::vector< wxString >::const_iterator value = bitmaps.begin(); value != bitmaps.end(); ++value )
+	{
+		wxString path;
+		wxString source;
+		wxSize icoSize;
+		TypeConv::ParseBitmapWithResource( *value, &path, &source, &icoSize );
+
+		const wxString absPath = TypeConv::MakeAbsolutePath( path, AppData()->GetProjectPath() );
+		Update( &md5, absPath );
+		Update( &md5, GetFileStamp( absPath ) );
+	}
+
+	md5.finalize();
+	char* digest = md5.hex_digest();
+	wxString key = wxString::FromAscii( digest );
+	delete [] digest;
+
+	return key;
+}
+
+bool GenerationCache::IsUpToDate( const wxString& language, const wxString& key, const wxArrayString& outputs )
+{
+	// The templates are only profiled if they run
+	if ( TemplateProfile::IsEnabled() )
+	{
+		return false;
+	}
+
+	if ( !wxFileName::FileExists( m_manifest ) )
+	{
+		return false;
+	}
+
+	wxFileConfig manifest( wxEmptyString, wxEmptyString, m_manifest, wxEmptyString, wxCONFIG_USE_LOCAL_FILE );
+	manifest.SetPath( wxT("/") + language );
+
+	if ( manifest.Read( wxT("Key"), wxEmptyString ) != key )
+	{
+		return false;
+	}
+
+	if ( manifest.Read( wxT("Outputs"), 0L ) != (long)outputs.GetCount() )
+	{
+		return false;
+	}
+
+	for ( size_t i = 0; i < outputs.GetCount(); ++i )
+	{
+		if ( manifest.Read( wxString::Format( wxT("Output%u"), (unsigned)i ), wxEmptyString ) != outputs[i] )
+		{
+			return false;
+		}
+
+		// Modified or deleted by someone else
+		const wxString stamp = GetFileStamp( outputs[i] );
+		if ( stamp.empty() || manifest.Read( wxString::Format( wxT("Stamp%u"), (unsigned)i ), wxEmptyString ) != stamp )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void GenerationCache::Store( const wxString& language, const wxString& key, const wxArrayString& outputs )
+{
+	const wxString directory = wxFileName( m_manifest ).GetPath();
+	if ( !wxFileName::DirExists( directory ) && !wxFileName::Mkdir( directory, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+	{
+		wxLogWarning( _("Unable to create the directory of the generation manifests: %s"), directory.c_str() );
+		return;
+	}
+
+	wxFileConfig manifest( wxEmptyString, wxEmptyString, m_manifest, wxEmptyString, wxCONFIG_USE_LOCAL_FILE );
+	manifest.DeleteGroup( wxT("/") + language );
+	manifest.SetPath( wxT("/") + language );
+
+	manifest.Write( wxT("Key"), key );
+	manifest.Write( wxT("Outputs"), (long)outputs.GetCount() );
+	for ( size_t i = 0; i < outputs.GetCount(); ++i )
+	{
+		manifest.Write( wxString::Format( wxT("Output%u"), (unsigned)i ), outputs[i] );
+		manifest.Write( wxString::Format( wxT("Stamp%u"), (unsigned)i ), GetFileStamp( outputs[i] ) );
+	}
+
+	if ( !manifest.Flush() )
+	{
+		wxLogWarning( _("Unable to write the generation manifest: %s"), m_manifest.c_str() );
+	}
+}
@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+@file
+Persistent record of the inputs of the last code generation, used to skip generating unchanged projects.
+*/
+
+#ifndef __GENERATION_CACHE__
+#define __GENERATION_CACHE__
+
+#include "../utils/wxfbdefs.h"
+
+#include <wx/arrstr.h>
+#include <wx/string.h>
+
+/**
+* Manifest of the generated files, stored in the data directory of the user under a hash of their path, so it does not
+* show up in the source tree of the project.
+*
+* For each language it keeps a hash of everything the generated code depends on (the project tree,
+* the code templates, the referenced bitmaps and the paths), and the size and time of the files written.
+* If neither changed, the generation and the file comparison can be skipped.
+*/
+class GenerationCache
+{
+private:
+	wxString m_manifest;
+
+public:
+	/**
+	* The manifest of the files generated to the path with the name, stored in the directory.
+	*/
+	GenerationCache( const wxString& path, const wxString& file, const wxString& directory = GetDefaultDirectory() );
+
+	/**
+	* Directory of the manifests, in the data directory of the user.
+	*/
+	static wxString GetDefaultDirectory();
+
+	/**
+	* Hash of the inputs of the generation of the project in the language.
+	*/
+	static wxString ComputeKey( PObjectBase project, const wxString& language );
+
+	/**
+	* True if the outputs were generated from the same inputs and not modified since.
+	*/
+	bool IsUpToDate( const wxString& language, const wxString& key, const wxArrayString& outputs );
+
+	/**
+	* Records the outputs just generated from the inputs.
+	*/
+	void Store( const wxString& language, const wxString& key, const wxArrayString& outputs );
+};
+
+#endif //__GENERATION_CACHE__
@@ -456,8 +456,8 @@ void LuaCodeGenerator::GenerateInheritedClass( PObjectBase userClasses, PObjectB
 	m_source->WriteLn( wxEmptyString );
 
 
-			EventVector events;
-			FindEventHandlers( form, events );
+			PCodeSummary summary = GetSummary( form );
+			const EventVector& events = summary->GetEventHandlers();
 
 
 			if ( events.size() > 0 )
@@ -523,7 +523,7 @@ wxString LuaCodeGenerator::GenEventEntryForInheritedClass( PObjectBase obj, PObj
 		}
 
 		LuaTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath, m_strUserIDsVec );
-		code = parser.ParseTemplate();
+		code = parser.ParseTemplate( wxT("Lua"), obj_info->GetClassName(), wxT("evt_") + templateName );
 		if(code.length() > 0) return code;
 
 		for ( unsigned int i = 0; i < obj_info->GetBaseClassCount(false); i++ )
@@ -590,11 +590,14 @@ bool LuaCodeGenerator::GenerateCode( PObjectBase project )
 	std::set< wxString > subclasses;
 	std::vector< wxString > headerIncludes;
 
-	GenSubclassSets( project, &subclasses, &headerIncludes );
+	StringHashSet headerIncludeSet;
+
+	PCodeSummary summary = GetSummary( project );
+	GenSubclassSets( summary, &subclasses, &headerIncludes, &headerIncludeSet );
 
 	// Generating  includes
 	std::set< wxString > templates;
-	GenIncludes(project, &headerIncludes, &templates );
+	GenIncludes( project, &headerIncludes, &headerIncludeSet, &templates );
 
 	// Write the include lines
 	std::vector<wxString>::iterator include_it;
@@ -608,7 +611,7 @@ bool LuaCodeGenerator::GenerateCode( PObjectBase project )
 	}
 
 	// Generating "defines" for macros
-	GenDefines( project );
+	GenDefines( summary );
 
 	PProperty propNamespace = project->GetProperty( wxT( "ui_table" ) );
 	if ( propNamespace )
@@ -639,8 +642,8 @@ bool LuaCodeGenerator::GenerateCode( PObjectBase project )
 	{
 		PObjectBase child = project->GetChild( i );
 
-		EventVector events;
-		FindEventHandlers( child, events );
+		PCodeSummary childSummary = GetSummary( child );
+		const EventVector& events = childSummary->GetEventHandlers();
 		GenClassDeclaration( child, false, wxT(""), events, m_strEventHandlerPostfix );
 	}
 
@@ -747,7 +750,7 @@ bool LuaCodeGenerator::GenEventEntry( PObjectBase obj, PObjectInfo obj_info, con
 			}
 
 			LuaTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath, m_strUserIDsVec );
-			wxString code = parser.ParseTemplate();
+			wxString code = parser.ParseTemplate( wxT("Lua"), obj_info->GetClassName(), wxT("evt_") + templateName );
 			wxString strRootCode = parser.RootWxParentToCode();
 			if(code.Find(strRootCode) != -1){
 				code.Replace(strRootCode, strClassName);
@@ -822,7 +825,7 @@ void LuaCodeGenerator::GenDefinedEventHandlers( PObjectInfo info, PObjectBase ob
 		if ( !_template.empty() )
 		{
 			LuaTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath, m_strUserIDsVec );
-			wxString code = parser.ParseTemplate();
+			wxString code = parser.ParseTemplate( wxT("Lua"), info->GetClassName(), wxT("generated_event_handlers") );
 
 			if ( !code.empty() )
 			{
@@ -873,7 +876,7 @@ wxString LuaCodeGenerator::GetCode(PObjectBase obj, wxString name, bool silent/*
 	}
 
 	LuaTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath, m_strUserIDsVec );
-	wxString code = parser.ParseTemplate();
+	wxString code = parser.ParseTemplate( wxT("Lua"), obj->GetClassName(), name );
 
 	//handle unsupported classes
 	std::vector<wxString>::iterator iter = m_strUnsupportedInstances.begin();
@@ -923,94 +926,57 @@ void LuaCodeGenerator::GenClassDeclaration(PObjectBase class_obj, bool /*use_enu
 
 }
 
-void LuaCodeGenerator::GenSubclassSets( PObjectBase obj, std::set< wxString >* subclasses, std::vector< wxString >* headerIncludes )
+void LuaCodeGenerator::GenSubclassSets( PCodeSummary summary, std::set< wxString >* subclasses, std::vector< wxString >* headerIncludes, StringHashSet* headerIncludeSet )
 {
-	// Call GenSubclassForwardDeclarations on all children as well
-	for ( unsigned int i = 0; i < obj->GetChildCount(); i++ )
-	{
-		GenSubclassSets( obj->GetChild( i ), subclasses, headerIncludes );
-	}
-
-	// Fill the set
-	PProperty subclass = obj->GetProperty( wxT("subclass") );
-	if ( subclass )
+	const CodeSummary::SubclassVector& subclassInfos = summary->GetSubclasses();
+	for ( CodeSummary::SubclassVector::const_iterator subclass = subclassInfos.begin(); subclass != subclassInfos.end(); ++subclass )
 	{
-		std::map< wxString, wxString > children;
-		subclass->SplitParentProperty( &children );
-
-		std::map< wxString, wxString >::iterator name;
-		name = children.find( wxT("name") );
-
-		if ( children.end() == name )
-		{
-			// No name, so do nothing
-			return;
-		}
-
-		wxString nameVal = name->second;
-		if ( nameVal.empty() )
-		{
-			// No name, so do nothing
-			return;
-		}
-
-		// Now get the header
-		std::map< wxString, wxString >::iterator header;
-		header = children.find( wxT("header") );
-
-		if ( children.end() == header )
-		{
-			// No header, so do nothing
-			return;
-		}
-
-		wxString headerVal = header->second;
-		if ( headerVal.empty() )
+		if ( subclass->header.empty() )
 		{
 			// No header, so do nothing
-			return;
+			continue;
 		}
 
 		// Got a header
-		PObjectInfo info = obj->GetObjectInfo();
+		PObjectInfo info = subclass->object->GetObjectInfo();
 		if ( !info )
 		{
-			return;
+			continue;
 		}
 
 		PObjectPackage pkg = info->GetPackage();
 		if ( !pkg )
 		{
-			return;
+			continue;
 		}
 
-		wxString include = wxT("require(\"") + headerVal.Trim() +  wxT("\")\n");
-		std::vector< wxString >::iterator it = std::find( headerIncludes->begin(), headerIncludes->end(), include );
-		if ( headerIncludes->end() == it )
+		wxString header = subclass->header;
+		wxString include = wxT("require(\"") + header.Trim() +  wxT("\")\n");
+		if ( headerIncludeSet->insert( include ).second )
 		{
 			headerIncludes->push_back( include );
 		}
 	}
 }
 
-void LuaCodeGenerator::GenIncludes( PObjectBase project, std::vector<wxString>* includes, std::set< wxString >* templates )
+void LuaCodeGenerator::GenIncludes( PObjectBase project, std::vector<wxString>* includes, StringHashSet* includeSet, std::set< wxString >* templates )
 {
-	GenObjectIncludes( project, includes, templates );
+	GenObjectIncludes( project, includes, includeSet, templates );
 }
 
-void LuaCodeGenerator::GenObjectIncludes( PObjectBase project, std::vector< wxString >* includes, std::set< wxString >* templates )
+void LuaCodeGenerator::GenObjectIncludes( PObjectBase project, std::vector< wxString >* includes, StringHashSet* includeSet, std::set< wxString >* templates )
 {
 	// Fill the set
 	PCodeInfo code_info = project->GetObjectInfo()->GetCodeInfo( wxT("Lua") );
 	if (code_info)
 	{
 		LuaTemplateParser parser( project, code_info->GetTemplate( wxT("include") ), m_i18n, m_useRelativePath, m_basePath, m_strUserIDsVec );
-		wxString include = parser.ParseTemplate();
+		wxString include = parser.ParseTemplate( wxT("Lua"), project->GetClassName(), wxT("include") );
 		if ( !include.empty() )
 		{
 			if ( templates->insert( include ).second )
 			{
-				AddUniqueIncludes( include, includes );
+				AddUniqueIncludes( include, includes, includeSet );
 			}
 		}
 	}
@@ -1018,14 +984,14 @@ void LuaCodeGenerator::GenObjectIncludes( PObjectBase project, std::vector< wxSt
 	// Call GenIncludes on all children as well
 	for ( unsigned int i = 0; i < project->GetChildCount(); i++ )
 	{
-		GenObjectIncludes( project->GetChild(i), includes, templates );
+		GenObjectIncludes( project->GetChild(i), includes, includeSet, templates );
 	}
 
 	// Generate includes for base classes
-	GenBaseIncludes( project->GetObjectInfo(), project, includes, templates );
+	GenBaseIncludes( project->GetObjectInfo(), project, includes, includeSet, templates );
 }
 
-void LuaCodeGenerator::GenBaseIncludes( PObjectInfo info, PObjectBase obj, std::vector< wxString >* includes, std::set< wxString >* templates )
+void LuaCodeGenerator::GenBaseIncludes( PObjectInfo info, PObjectBase obj, std::vector< wxString >* includes, StringHashSet* includeSet, std::set< wxString >* templates )
 {
 	if ( !info )
 	{
@@ -1036,25 +1002,25 @@ void LuaCodeGenerator::GenBaseIncludes( PObjectInfo info, PObjectBase obj, std::
 	for ( unsigned int i = 0; i < info->GetBaseClassCount(false); i++ )
 	{
 		PObjectInfo base_info = info->GetBaseClass( i, false );
-		GenBaseIncludes( base_info, obj, includes, templates );
+		GenBaseIncludes( base_info, obj, includes, includeSet, templates );
 	}
 
 	PCodeInfo code_info = info->GetCodeInfo( wxT("Lua") );
 	if ( code_info )
 	{
 		LuaTemplateParser parser( obj, code_info->GetTemplate( wxT("include") ), m_i18n, m_useRelativePath, m_basePath, m_strUserIDsVec );
-		wxString include = parser.ParseTemplate();
+		wxString include = parser.ParseTemplate( wxT("Lua"), info->GetClassName(), wxT("include") );
 		if ( !include.empty() )
 		{
 			if ( templates->insert( include ).second )
 			{
-				AddUniqueIncludes( include, includes );
+				AddUniqueIncludes( include, includes, includeSet );
 			}
 		}
 	}
 }
 
-void LuaCodeGenerator::AddUniqueIncludes( const wxString& include, std::vector< wxString >* includes )
+void LuaCodeGenerator::AddUniqueIncludes( const wxString& include, std::vector< wxString >* includes, StringHashSet* includeSet )
 {
 	// Split on newlines to only generate unique include lines
 	// This strips blank lines and trims
@@ -1067,29 +1033,13 @@ void LuaCodeGenerator::AddUniqueIncludes( const wxString& include, std::vector<
 		line.Trim( true );
 
 		// If it is an include, it must be unique to be written
-		std::vector< wxString >::iterator it = std::find( includes->begin(), includes->end(), line );
-		if ( includes->end() == it )
+		if ( includeSet->insert( line ).second )
 		{
 			includes->push_back( line );
 		}
 	}
 }
 
-void LuaCodeGenerator::FindDependencies( PObjectBase obj, std::set< PObjectInfo >& info_set )
-{
-	unsigned int ch_count = obj->GetChildCount();
-	if (ch_count > 0)
-	{
-		unsigned int i;
-		for (i = 0; i<ch_count; i++)
-		{
-			PObjectBase child = obj->GetChild(i);
-			info_set.insert(child->GetObjectInfo());
-			FindDependencies(child, info_set);
-		}
-	}
-}
-
 void LuaCodeGenerator::GenConstructor( PObjectBase class_obj, const EventVector &events, wxString &strClassName )
 {
 	PProperty propName = class_obj->GetProperty( wxT("name") );
@@ -1418,7 +1368,7 @@ void LuaCodeGenerator::GenDestruction( PObjectBase obj )
 		if ( !_template.empty() )
 		{
 			LuaTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath, m_strUserIDsVec );
-			wxString code = parser.ParseTemplate();
+			wxString code = parser.ParseTemplate( wxT("Lua"), obj->GetClassName(), wxT( "destruction" ) );
 			if ( !code.empty() )
 			{
 				m_source->WriteLn( code );
@@ -1434,60 +1384,34 @@ void LuaCodeGenerator::GenDestruction( PObjectBase obj )
 	}
 }
 
-void LuaCodeGenerator::FindMacros( PObjectBase obj, std::vector<wxString>* macros )
+void LuaCodeGenerator::FindMacros( PCodeSummary summary, std::vector<wxString>* macros )
 {
-	// iterate through all of the properties of all objects, add the macros
-	// to the vector
-	unsigned int i;
+	// The summary holds the unique macros of all objects, only the empty
+	// values and the wx IDs have to be skipped here
+	StringHashSet macroSet;
 
-	for ( i = 0; i < obj->GetPropertyCount(); i++ )
+	const std::vector< wxString >& values = summary->GetMacros();
+	for ( std::vector< wxString >::const_iterator it = values.begin(); it != values.end(); ++it )
 	{
-		PProperty prop = obj->GetProperty( i );
-		if ( prop->GetType() == PT_MACRO )
-		{
-			wxString value = prop->GetValue();
-			if( value.IsEmpty() ) continue;
+		if ( it->IsEmpty() ) continue;
 
-			// Skip wx IDs
-			if ( ( ! value.Contains( wxT("XRCID" ) ) ) &&
-				 ( m_predMacros.end() == m_predMacros.find( value ) ) )
+		const wxString& value = *it;
+
+		if ( ( ! value.Contains( wxT("XRCID" ) ) ) &&
+			 ( m_predMacros.end() == m_predMacros.find( value ) ) )
+		{
+			if ( macroSet.insert( value ).second )
 			{
-				if ( macros->end() == std::find( macros->begin(), macros->end(), value ) )
-				{
-					macros->push_back( value );
-				}
+				macros->push_back( value );
 			}
 		}
 	}
-
-	for ( i = 0; i < obj->GetChildCount(); i++ )
-	{
-		FindMacros( obj->GetChild( i ), macros );
-	}
-}
-
-void LuaCodeGenerator::FindEventHandlers(PObjectBase obj, EventVector &events)
-{
-  unsigned int i;
-  unsigned int evt_cnt = obj->GetEventCount();
-  for (i=0; i < evt_cnt; i++)
-  {
-	PEvent event = obj->GetEvent(i);
-	if (!event->GetValue().IsEmpty())
-	  events.push_back(event);
-  }
-
-  for (i=0; i < obj->GetChildCount(); i++)
-  {
-	PObjectBase child = obj->GetChild(i);
-	FindEventHandlers(child,events);
-  }
 }
 
-void LuaCodeGenerator::GenDefines( PObjectBase project)
+void LuaCodeGenerator::GenDefines( PCodeSummary summary )
 {
 	std::vector< wxString > macros;
-	FindMacros( project, &macros );
+	FindMacros( summary, &macros );
 	m_strUserIDsVec.erase(m_strUserIDsVec.begin(),m_strUserIDsVec.end());
 
 	// Remove the default macro from the set, for backward compatiblity
@@ -1530,7 +1454,7 @@ void LuaCodeGenerator::GenSettings(PObjectInfo info, PObjectBase obj, wxString &
 	if ( !_template.empty() )
 	{
 		LuaTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath, m_strUserIDsVec );
-		wxString code = parser.ParseTemplate();
+		wxString code = parser.ParseTemplate( wxT("Lua"), info->GetClassName(), wxT("settings") );
 
 		wxString strRootCode = parser.RootWxParentToCode();
 		if(code.Find(strRootCode) != -1){
@@ -1573,7 +1497,7 @@ void LuaCodeGenerator::GetAddToolbarCode( PObjectInfo info, PObjectBase obj, wxA
 	if ( !_template.empty() )
 	{
 		LuaTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath, m_strUserIDsVec );
-		wxString code = parser.ParseTemplate();
+		wxString code = parser.ParseTemplate( wxT("Lua"), info->GetClassName(), wxT( "toolbar_add" ) );
 		if ( !code.empty() )
 		{
 			if( codelines.Index( code ) == wxNOT_FOUND ) codelines.Add( code );
@@ -102,21 +102,11 @@ private:
 	*/
 	wxString GetCode( PObjectBase obj, wxString name, bool silent = false, wxString strSelf = wxT(""));
 
-	/**
-	* Stores the project's objects classes set, for generating the includes.
-	*/
-	void FindDependencies( PObjectBase obj, std::set< PObjectInfo >& info_set );
-
 	/**
 	* Stores all the properties for "macro" type objects, so that their
 	* related '#define' can be generated subsequently.
 	*/
-	void FindMacros( PObjectBase obj, std::vector< wxString >* macros );
-
-	/**
-	 * Looks for "non-null" event handlers (PEvent) and collects it into a vector.
-	 */
-	void FindEventHandlers(PObjectBase obj, EventVector &events);
+	void FindMacros( PCodeSummary summary, std::vector< wxString >* macros );
 
 	/**
 	* Generates classes declarations inside the header file.
@@ -150,20 +140,20 @@ private:
 	/**
 	* Generates the 'import' section for files.
 	*/
-	void GenIncludes( PObjectBase project, std::vector< wxString >* includes, std::set< wxString >* templates );
-	void GenObjectIncludes( PObjectBase project, std::vector< wxString >* includes, std::set< wxString >* templates );
-	void GenBaseIncludes( PObjectInfo info, PObjectBase obj, std::vector< wxString >* includes, std::set< wxString >* templates );
-	void AddUniqueIncludes( const wxString& include, std::vector< wxString >* includes );
+	void GenIncludes( PObjectBase project, std::vector< wxString >* includes, StringHashSet* includeSet, std::set< wxString >* templates );
+	void GenObjectIncludes( PObjectBase project, std::vector< wxString >* includes, StringHashSet* includeSet, std::set< wxString >* templates );
+	void GenBaseIncludes( PObjectInfo info, PObjectBase obj, std::vector< wxString >* includes, StringHashSet* includeSet, std::set< wxString >* templates );
+	void AddUniqueIncludes( const wxString& include, std::vector< wxString >* includes, StringHashSet* includeSet );
 
 	/**
 	* Generate a set of all subclasses to forward declare in the generated file.
 	*/
-	void GenSubclassSets( PObjectBase obj, std::set< wxString >* subclasses, std::vector< wxString >* headerIncludes );
+	void GenSubclassSets( PCodeSummary summary, std::set< wxString >* subclasses, std::vector< wxString >* headerIncludes, StringHashSet* headerIncludeSet );
 
 	/**
 	* Generates the '#define' section for macros.
 	*/
-	void GenDefines( PObjectBase project);
+	void GenDefines( PCodeSummary summary );
 
 	/**
 	* Generates the constructor for a class
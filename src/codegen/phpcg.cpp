@@ -421,8 +421,8 @@ void PHPCodeGenerator::GenerateInheritedClass( PObjectBase userClasses, PObjectB
 	m_source->WriteLn( code );
 
 	// Do events
-	EventVector events;
-	FindEventHandlers( form, events );
+	PCodeSummary summary = GetSummary( form );
+	const EventVector& events = summary->GetEventHandlers();
 
 	if ( events.size() > 0 )
 	{
@@ -504,11 +504,14 @@ bool PHPCodeGenerator::GenerateCode( PObjectBase project )
 	std::set< wxString > subclasses;
 	std::vector< wxString > headerIncludes;
 
-	GenSubclassSets( project, &subclasses, &headerIncludes );
+	StringHashSet headerIncludeSet;
+
+	PCodeSummary summary = GetSummary( project );
+	GenSubclassSets( summary, &subclasses, &headerIncludes, &headerIncludeSet );
 
 	// Generating in the .h header file those include from components dependencies.
 	std::set< wxString > templates;
-	GenIncludes(project, &headerIncludes, &templates );
+	GenIncludes( project, &headerIncludes, &headerIncludeSet, &templates );
 
 	// Write the include lines
 	std::vector<wxString>::iterator include_it;
@@ -530,7 +533,7 @@ bool PHPCodeGenerator::GenerateCode( PObjectBase project )
 	}
 
 	// Generating "defines" for macros
-	GenDefines( project );
+	GenDefines( summary );
 
 	wxString eventHandlerPostfix;
 	PProperty eventKindProp = project->GetProperty( wxT("skip_php_events") );
@@ -548,8 +551,8 @@ bool PHPCodeGenerator::GenerateCode( PObjectBase project )
 	{
 		PObjectBase child = project->GetChild( i );
 
-		EventVector events;
-		FindEventHandlers( child, events );
+		PCodeSummary childSummary = GetSummary( child );
+		const EventVector& events = childSummary->GetEventHandlers();
 		//GenClassDeclaration( child, useEnum, classDecoration, events, eventHandlerPrefix, eventHandlerPostfix );
 		GenClassDeclaration( child, false, wxT(""), events, eventHandlerPostfix );
 	}
@@ -652,7 +655,7 @@ bool PHPCodeGenerator::GenEventEntry( PObjectBase obj, PObjectInfo obj_info, con
 				_template.Replace( wxT("#handler"), wxT("array(@$this, \"") + handlerName + wxT("\")") );
 
 			PHPTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath );
-			m_source->WriteLn( parser.ParseTemplate() );
+			m_source->WriteLn( parser.ParseTemplate( wxT("PHP"), obj_info->GetClassName(), wxT("evt_") + templateName ) );
 			return true;
 		}
 	}
@@ -722,7 +725,7 @@ void PHPCodeGenerator::GenDefinedEventHandlers( PObjectInfo info, PObjectBase ob
 		if ( !_template.empty() )
 		{
 			PHPTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath );
-			wxString code = parser.ParseTemplate();
+			wxString code = parser.ParseTemplate( wxT("PHP"), info->GetClassName(), wxT("generated_event_handlers") );
 
 			if ( !code.empty() )
 			{
@@ -766,7 +769,7 @@ wxString PHPCodeGenerator::GetCode(PObjectBase obj, wxString name, bool silent)
 	}
 
 	PHPTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath );
-	wxString code = parser.ParseTemplate();
+	wxString code = parser.ParseTemplate( wxT("PHP"), obj->GetClassName(), name );
 
 	return code;
 }
@@ -813,94 +816,56 @@ void PHPCodeGenerator::GenClassDeclaration(PObjectBase class_obj, bool /*use_enu
 	m_source->WriteLn( wxT("") );
 }
 
-void PHPCodeGenerator::GenSubclassSets( PObjectBase obj, std::set< wxString >* subclasses, std::vector< wxString >* headerIncludes )
+void PHPCodeGenerator::GenSubclassSets( PCodeSummary summary, std::set< wxString >* subclasses, std::vector< wxString >* headerIncludes, StringHashSet* headerIncludeSet )
 {
-	// Call GenSubclassForwardDeclarations on all children as well
-	for ( unsigned int i = 0; i < obj->GetChildCount(); i++ )
+	const CodeSummary::SubclassVector& subclassInfos = summary->GetSubclasses();
+	for ( CodeSummary::SubclassVector::const_iterator subclass = subclassInfos.begin(); subclass != subclassInfos.end(); ++subclass )
 	{
-		GenSubclassSets( obj->GetChild( i ), subclasses, headerIncludes );
-	}
-
-	// Fill the set
-	PProperty subclass = obj->GetProperty( wxT("subclass") );
-	if ( subclass )
-	{
-		std::map< wxString, wxString > children;
-		subclass->SplitParentProperty( &children );
-
-		std::map< wxString, wxString >::iterator name;
-		name = children.find( wxT("name") );
-
-		if ( children.end() == name )
-		{
-			// No name, so do nothing
-			return;
-		}
-
-		wxString nameVal = name->second;
-		if ( nameVal.empty() )
-		{
-			// No name, so do nothing
-			return;
-		}
-
-		// Now get the header
-		std::map< wxString, wxString >::iterator header;
-		header = children.find( wxT("header") );
-
-		if ( children.end() == header )
-		{
-			// No header, so do nothing
-			return;
-		}
-
-		wxString headerVal = header->second;
-		if ( headerVal.empty() )
+		if ( subclass->header.empty() )
 		{
 			// No header, so do nothing
-			return;
+			continue;
 		}
 
 		// Got a header
-		PObjectInfo info = obj->GetObjectInfo();
+		PObjectInfo info = subclass->object->GetObjectInfo();
 		if ( !info )
 		{
-			return;
+			continue;
 		}
 
 		PObjectPackage pkg = info->GetPackage();
 		if ( !pkg )
 		{
-			return;
+			continue;
 		}
 
-		wxString include = wxT("include_once ") + headerVal + wxT(";");
-		std::vector< wxString >::iterator it = std::find( headerIncludes->begin(), headerIncludes->end(), include );
-		if ( headerIncludes->end() == it )
+		wxString include = wxT("include_once ") + subclass->header + wxT(";");
+		if ( headerIncludeSet->insert( include ).second )
 		{
 			headerIncludes->push_back( include );
 		}
 	}
 }
 
-void PHPCodeGenerator::GenIncludes( PObjectBase project, std::vector<wxString>* includes, std::set< wxString >* templates )
+void PHPCodeGenerator::GenIncludes( PObjectBase project, std::vector<wxString>* includes, StringHashSet* includeSet, std::set< wxString >* templates )
 {
-	GenObjectIncludes( project, includes, templates );
+	GenObjectIncludes( project, includes, includeSet, templates );
 }
 
-void PHPCodeGenerator::GenObjectIncludes( PObjectBase project, std::vector< wxString >* includes, std::set< wxString >* templates )
+void PHPCodeGenerator::GenObjectIncludes( PObjectBase project, std::vector< wxString >* includes, StringHashSet* includeSet, std::set< wxString >* templates )
 {
 	// Fill the set
 	PCodeInfo code_info = project->GetObjectInfo()->GetCodeInfo( wxT("PHP") );
 	if (code_info)
 	{
 		PHPTemplateParser parser( project, code_info->GetTemplate( wxT("include") ), m_i18n, m_useRelativePath, m_basePath );
-		wxString include = parser.ParseTemplate();
+		wxString include = parser.ParseTemplate( wxT("PHP"), project->GetClassName(), wxT("include") );
 		if ( !include.empty() )
 		{
 			if ( templates->insert( include ).second )
 			{
-				AddUniqueIncludes( include, includes );
+				AddUniqueIncludes( include, includes, includeSet );
 			}
 		}
 	}
@@ -908,14 +873,14 @@ void PHPCodeGenerator::GenObjectIncludes( PObjectBase project, std::vector< wxSt
 	// Call GenIncludes on all children as well
 	for ( unsigned int i = 0; i < project->GetChildCount(); i++ )
 	{
-		GenObjectIncludes( project->GetChild(i), includes, templates );
+		GenObjectIncludes( project->GetChild(i), includes, includeSet, templates );
 	}
 
 	// Generate includes for base classes
-	GenBaseIncludes( project->GetObjectInfo(), project, includes, templates );
+	GenBaseIncludes( project->GetObjectInfo(), project, includes, includeSet, templates );
 }
 
-void PHPCodeGenerator::GenBaseIncludes( PObjectInfo info, PObjectBase obj, std::vector< wxString >* includes, std::set< wxString >* templates )
+void PHPCodeGenerator::GenBaseIncludes( PObjectInfo info, PObjectBase obj, std::vector< wxString >* includes, StringHashSet* includeSet, std::set< wxString >* templates )
 {
 	if ( !info )
 	{
@@ -926,25 +891,25 @@ void PHPCodeGenerator::GenBaseIncludes( PObjectInfo info, PObjectBase obj, std::
 	for ( unsigned int i = 0; i < info->GetBaseClassCount(); i++ )
 	{
 		PObjectInfo base_info = info->GetBaseClass( i );
-		GenBaseIncludes( base_info, obj, includes, templates );
+		GenBaseIncludes( base_info, obj, includes, includeSet, templates );
 	}
 
 	PCodeInfo code_info = info->GetCodeInfo( wxT("PHP") );
 	if ( code_info )
 	{
 		PHPTemplateParser parser( obj, code_info->GetTemplate( wxT("include") ), m_i18n, m_useRelativePath, m_basePath );
-		wxString include = parser.ParseTemplate();
+		wxString include = parser.ParseTemplate( wxT("PHP"), info->GetClassName(), wxT("include") );
 		if ( !include.empty() )
 		{
 			if ( templates->insert( include ).second )
 			{
-				AddUniqueIncludes( include, includes );
+				AddUniqueIncludes( include, includes, includeSet );
 			}
 		}
 	}
 }
 
-void PHPCodeGenerator::AddUniqueIncludes( const wxString& include, std::vector< wxString >* includes )
+void PHPCodeGenerator::AddUniqueIncludes( const wxString& include, std::vector< wxString >* includes, StringHashSet* includeSet )
 {
 	// Split on newlines to only generate unique include lines
 	// This strips blank lines and trims
@@ -956,37 +921,15 @@ void PHPCodeGenerator::AddUniqueIncludes( const wxString& include, std::vector<
 		line.Trim( false );
 		line.Trim( true );
 
-		// If it is not an include line, it will be written
-		if ( !line.StartsWith( wxT("import") ) )
-		{
-			includes->push_back( line );
-			continue;
-		}
-
-		// If it is an include, it must be unique to be written
-		std::vector< wxString >::iterator it = std::find( includes->begin(), includes->end(), line );
-		if ( includes->end() == it )
+		// If it is an import, it must be unique to be written
+		bool isNew = includeSet->insert( line ).second;
+		if ( isNew || !line.StartsWith( wxT("import") ) )
 		{
 			includes->push_back( line );
 		}
 	}
 }
 
-void PHPCodeGenerator::FindDependencies( PObjectBase obj, std::set< PObjectInfo >& info_set )
-{
-	unsigned int ch_count = obj->GetChildCount();
-	if (ch_count > 0)
-	{
-		unsigned int i;
-		for (i = 0; i<ch_count; i++)
-		{
-			PObjectBase child = obj->GetChild(i);
-			info_set.insert(child->GetObjectInfo());
-			FindDependencies(child, info_set);
-		}
-	}
-}
-
 void PHPCodeGenerator::GenConstructor( PObjectBase class_obj, const EventVector &events )
 {
 	m_source->WriteLn();
@@ -1270,7 +1213,7 @@ void PHPCodeGenerator::GenDestruction( PObjectBase obj )
 		if ( !_template.empty() )
 		{
 			PHPTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath );
-			wxString code = parser.ParseTemplate();
+			wxString code = parser.ParseTemplate( wxT("PHP"), obj->GetClassName(), wxT( "destruction" ) );
 			if ( !code.empty() )
 			{
 				m_source->WriteLn( code );
@@ -1286,59 +1229,34 @@ void PHPCodeGenerator::GenDestruction( PObjectBase obj )
 	}
 }
 
-void PHPCodeGenerator::FindMacros( PObjectBase obj, std::vector<wxString>* macros )
+void PHPCodeGenerator::FindMacros( PCodeSummary summary, std::vector<wxString>* macros )
 {
-	// iterate through all of the properties of all objects, add the macros
-	// to the vector
-	unsigned int i;
+	// The summary holds the unique macros of all objects, only the empty
+	// values and the wx IDs have to be skipped here
+	StringHashSet macroSet;
 
-	for ( i = 0; i < obj->GetPropertyCount(); i++ )
+	const std::vector< wxString >& values = summary->GetMacros();
+	for ( std::vector< wxString >::const_iterator it = values.begin(); it != values.end(); ++it )
 	{
-		PProperty prop = obj->GetProperty( i );
-		if ( prop->GetType() == PT_MACRO )
-		{
-			wxString value = prop->GetValue();
-			if( value.IsEmpty() ) continue;
+		if ( it->IsEmpty() ) continue;
+
+		const wxString& value = *it;
 
-			// Skip wx IDs
-			if ( ( ! value.Contains( wxT("XRCID" ) ) ) &&
-				 ( m_predMacros.end() == m_predMacros.find( value ) ) )
+		if ( ( ! value.Contains( wxT("XRCID" ) ) ) &&
+			 ( m_predMacros.end() == m_predMacros.find( value ) ) )
+		{
+			if ( macroSet.insert( value ).second )
 			{
-				if ( macros->end() == std::find( macros->begin(), macros->end(), value ) )
-				{
-					macros->push_back( value );
-				}
+				macros->push_back( value );
 			}
 		}
 	}
-
-	for ( i = 0; i < obj->GetChildCount(); i++ )
-	{
-		FindMacros( obj->GetChild( i ), macros );
-	}
-}
-
-void PHPCodeGenerator::FindEventHandlers(PObjectBase obj, EventVector &events)
-{
-  unsigned int i;
-  for (i=0; i < obj->GetEventCount(); i++)
-  {
-	PEvent event = obj->GetEvent(i);
-	if (!event->GetValue().IsEmpty())
-	  events.push_back(event);
-  }
-
-  for (i=0; i < obj->GetChildCount(); i++)
-  {
-	PObjectBase child = obj->GetChild(i);
-	FindEventHandlers(child,events);
-  }
 }
 
-void PHPCodeGenerator::GenDefines( PObjectBase project)
+void PHPCodeGenerator::GenDefines( PCodeSummary summary )
 {
 	std::vector< wxString > macros;
-	FindMacros( project, &macros );
+	FindMacros( summary, &macros );
 
 	// Remove the default macro from the set, for backward compatiblity
 	std::vector< wxString >::iterator it;
@@ -1379,7 +1297,7 @@ void PHPCodeGenerator::GenSettings(PObjectInfo info, PObjectBase obj)
 	if ( !_template.empty() )
 	{
 		PHPTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath );
-		wxString code = parser.ParseTemplate();
+		wxString code = parser.ParseTemplate( wxT("PHP"), info->GetClassName(), wxT("settings") );
 		if ( !code.empty() )
 		{
 			m_source->WriteLn(code);
@@ -1416,7 +1334,7 @@ void PHPCodeGenerator::GetAddToolbarCode( PObjectInfo info, PObjectBase obj, wxA
 	if ( !_template.empty() )
 	{
 		PHPTemplateParser parser( obj, _template, m_i18n, m_useRelativePath, m_basePath );
-		wxString code = parser.ParseTemplate();
+		wxString code = parser.ParseTemplate( wxT("PHP"), info->GetClassName(), wxT( "toolbar_add" ) );
 		if ( !code.empty() )
 		{
 			if( codelines.Index( code ) == wxNOT_FOUND ) codelines.Add( code );
@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "templateprofile.h"
+
+#include "../utils/stringutils.h"
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/log.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+	struct Counter
+	{
+		unsigned long long calls;
+		long long microseconds;
+		unsigned long long bytes;
+	};
+
+	// language, class, template
+	typedef std::tuple< wxString, wxString, wxString > Key;
+	typedef std::map< Key, Counter > CounterMap;
+
+	std::atomic< bool > s_enabled( false );
+	std::mutex s_mutex;
+	CounterMap s_counters;
+
+	wxString CsvField( const wxString& value )
+	{
+		if ( value.find_first_of( wxT(",\"\n") ) == wxString::npos )
+		{
+			return value;
+		}
+
+		wxString quoted( value );
+		quoted.Replace( wxT("\""), wxT("\"\"") );
+		return wxT("\"") + quoted + wxT("\"");
+	}
+}
+
+void TemplateProfile::Enable( bool enable )
+{
+	std::lock_guard< std::mutex > lock( s_mutex );
+	if ( enable )
+	{
+		s_counters.clear();
+	}
+	s_enabled = enable;
+}
+
+bool TemplateProfile::IsEnabled()
+{
+	return s_enabled;
+}
+
+void TemplateProfile::Record( const wxString& language, const wxString& className, const wxString& templateName,
+	long long microseconds, size_t bytes )
+{
+	std::lock_guard< std::mutex > lock( s_mutex );
+	Counter& counter = s_counters[ Key( language, className, templateName ) ];
+	++counter.calls;
+	counter.microseconds += microseconds;
+	counter.bytes += bytes;
+}
+
+bool TemplateProfile::WriteReport( const wxString& path )
+{
+	std::vector< CounterMap::value_type > sorted;
+	{
+		std::lock_guard< std::mutex > lock( s_mutex );
+		sorted.assign( s_counters.begin(), s_counters.end() );
+	}
+
+	std::stable_sort( sorted.begin(), sorted.end(), []( const CounterMap::value_type& a, const CounterMap::value_type& b )
+	{
+		return a.second.microseconds > b.second.microseconds;
+	} );
+
+	const bool json = ( wxFileName( path ).GetExt().Lower() == wxT("json") );
+
+	wxString report;
+	if ( json )
+	{
+		report << wxT("[\n");
+	}
+	else
+	{
+		report << wxT("language,class,template,calls,microseconds,bytes\n");
+	}
+
+	for ( size_t i = 0; i < sorted.size(); ++i )
+	{
+		const Key& key = sorted[i].first;
+		const Counter& counter = sorted[i].second;
+		if ( json )
+		{
+			report << wxT("  { \"language\": ") << StringUtils::JsonString( std::get< 0 >( key ) )
+				<< wxT(", \"class\": ") << StringUtils::JsonString( std::get< 1 >( key ) )
+				<< wxT(", \"template\": ") << StringUtils::JsonString( std::get< 2 >( key ) )
+				<< wxString::Format( wxT(", \"calls\": %llu, \"microseconds\": %lld, \"bytes\": %llu }"),
+					counter.calls, counter.microseconds, counter.bytes )
+				<< ( i + 1 < sorted.size() ? wxT(",\n") : wxT("\n") );
+		}
+		else
+		{
+			report << CsvField( std::get< 0 >( key ) ) << wxT(",") << CsvField( std::get< 1 >( key ) ) << wxT(",")
+				<< CsvField( std::get< 2 >( key ) )
+				<< wxString::Format( wxT(",%llu,%lld,%llu\n"), counter.calls, counter.microseconds, counter.bytes );
+		}
+	}
+
+	if ( json )
+	{
+		report << wxT("]\n");
+	}
+
+	wxFFile file( path, wxT("wb") );
+	if ( !file.IsOpened() || !file.Write( report, wxConvUTF8 ) )
+	{
+		wxLogError( _("Unable to write the template profile: %s"), path.c_str() );
+		return false;
+	}
+
+	return true;
+}
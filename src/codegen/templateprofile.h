@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+@file
+Optional counters of the code templates run by the generators, to find the slow ones.
+*/
+
+#ifndef __TEMPLATE_PROFILE__
+#define __TEMPLATE_PROFILE__
+
+#include <wx/string.h>
+
+/**
+* Records, for each template of each class and language, how many times it was run, the time spent in it and the
+* size of the code it produced.
+*
+* The counting is off until enabled, the generators then pass the name of the templates they parse to
+* TemplateParser::ParseTemplate(). The inner templates (#foreach, #ifnotnull, ...) are counted with the template
+* holding them.
+*/
+namespace TemplateProfile
+{
+	/**
+	* Starts or stops the counting, starting clears the previous counts.
+	*/
+	void Enable( bool enable );
+
+	bool IsEnabled();
+
+	/**
+	* Adds a run of a template.
+	*/
+	void Record( const wxString& language, const wxString& className, const wxString& templateName,
+		long long microseconds, size_t bytes );
+
+	/**
+	* Writes the counts, the templates with the most time first. The report is JSON if the extension of the file is
+	* .json, CSV otherwise. Logs an error and returns false if the file cannot be written.
+	*/
+	bool WriteReport( const wxString& path );
+}
+
+#endif //__TEMPLATE_PROFILE__
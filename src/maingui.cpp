@@ -24,17 +24,31 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "maingui.h"
 
+#include "codegen/codewriter.h"
+#include "codegen/templateprofile.h"
 #include "model/objectbase.h"
+#include "model/projectstorage.h"
 #include "rad/appdata.h"
+#include "rad/geninheritclass/geninhertclass.h"
 #include "rad/mainframe.h"
+#include "rad/memoryreport.h"
 #include "utils/typeconv.h"
 #include "utils/wxfbexception.h"
+#include "utils/wxfbipc.h"
 
 #include <wx/clipbrd.h>
 #include <wx/cmdline.h>
 #include <wx/config.h>
+#include <wx/dir.h>
+#include <wx/fswatcher.h>
 #include <wx/stdpaths.h>
+#include <wx/stopwatch.h>
 #include <wx/sysopt.h>
+#include <wx/timer.h>
+
+#include <map>
+#include <memory>
+#include <set>
 
 #if wxVERSION_NUMBER >= 2905 && wxVERSION_NUMBER <= 3100
 #include <wx/xrc/xh_auinotbk.h>
@@ -72,16 +86,312 @@ static const wxCmdLineEntryDesc s_cmdLineDesc[] = {
 	  "Override the code_generation property from the passed file and generate the passed "
 	  "languages. Separate multiple languages with commas.",
 	  wxCMD_LINE_VAL_STRING, 0 },
+	{ wxCMD_LINE_SWITCH, nullptr, "server",
+	  "Run as a code generation server, keeping the application loaded to answer the requests "
+	  "of --generate --connect.",
+	  wxCMD_LINE_VAL_STRING, 0 },
+	{ wxCMD_LINE_SWITCH, nullptr, "connect",
+	  "With --generate, send the request to a running code generation server. The files are "
+	  "generated in this process if there is no server.",
+	  wxCMD_LINE_VAL_STRING, 0 },
+	{ wxCMD_LINE_SWITCH, nullptr, "stop-server", "Stop a running code generation server.",
+	  wxCMD_LINE_VAL_STRING, 0 },
+	{ wxCMD_LINE_OPTION, nullptr, "watch",
+	  "Watch the project files of the passed directory and regenerate the code of those that "
+	  "change, or whose embedded bitmaps change.",
+	  wxCMD_LINE_VAL_STRING, 0 },
+	{ wxCMD_LINE_OPTION, nullptr, "convert",
+	  "Convert the passed project to the passed file, in the binary format if its extension is "
+	  ".fbpb, in XML otherwise.",
+	  wxCMD_LINE_VAL_STRING, 0 },
+	{ wxCMD_LINE_SWITCH, nullptr, "upgrade",
+	  "Convert the passed project files of older versions to the current version, in parallel. "
+	  "The original of each converted file is kept as .bak.",
+	  wxCMD_LINE_VAL_STRING, 0 },
+	{ wxCMD_LINE_OPTION, nullptr, "profile-templates",
+	  "With --generate, count the runs, the time and the output of each code template and write "
+	  "them to the passed file, as JSON if its extension is .json, as CSV otherwise.",
+	  wxCMD_LINE_VAL_STRING, 0 },
+	{ wxCMD_LINE_SWITCH, nullptr, "inherited",
+	  "With --generate, also generate the inherited classes of all the forms, named after the "
+	  "project and the form. The existing C++ files keep their user code, the existing files of "
+	  "the other languages are left untouched.",
+	  wxCMD_LINE_VAL_STRING, 0 },
+	{ wxCMD_LINE_SWITCH, nullptr, "report-memory",
+	  "Load the passed project and print the estimated memory of its objects, values, undo "
+	  "history and caches, as JSON.",
+	  wxCMD_LINE_VAL_STRING, 0 },
+	{ wxCMD_LINE_OPTION, nullptr, "service",
+	  "Endpoint of the code generation server, a socket path or a port number on localhost.",
+	  wxCMD_LINE_VAL_STRING, 0 },
 	{ wxCMD_LINE_SWITCH, "h", "help", "Show this help message.", wxCMD_LINE_VAL_STRING,
 	  wxCMD_LINE_OPTION_HELP },
 	{ wxCMD_LINE_SWITCH, "v", "version", "Print version information.", wxCMD_LINE_VAL_STRING, 0 },
-	{ wxCMD_LINE_PARAM, nullptr, nullptr, "File to open.", wxCMD_LINE_VAL_STRING,
-	  wxCMD_LINE_PARAM_OPTIONAL },
+	{ wxCMD_LINE_PARAM, nullptr, nullptr, "File to open, or files to generate.", wxCMD_LINE_VAL_STRING,
+	  wxCMD_LINE_PARAM_OPTIONAL | wxCMD_LINE_PARAM_MULTIPLE },
 	{ wxCMD_LINE_NONE, nullptr, nullptr, nullptr, wxCMD_LINE_VAL_NONE, 0 }
 };
 
 IMPLEMENT_APP( MyApp )
 
+namespace
+{
+	// Collects the errors logged while generating a project
+	class GenerationLog : public wxLog
+	{
+	private:
+		wxString m_errors;
+
+	protected:
+		void DoLogTextAtLevel( wxLogLevel level, const wxString& msg ) override
+		{
+			if ( level <= wxLOG_Error )
+			{
+				if ( !m_errors.empty() )
+				{
+					m_errors << wxT(" ");
+				}
+				m_errors << msg;
+			}
+		}
+
+	public:
+		const wxString& GetErrors() const { return m_errors; }
+	};
+
+	// Generates the code of a project, overriding its code_generation property if languages is not empty
+	bool GenerateProject( const wxString& file, const wxString& languages )
+	{
+		if ( !AppData()->LoadProject( file, true ) )
+		{
+			wxLogError( wxT("Unable to load project: %s"), file.c_str() );
+			return false;
+		}
+
+		if ( !languages.empty() )
+		{
+			PObjectBase project = AppData()->GetProjectData();
+			PProperty codeGen = project->GetProperty( _("code_generation") );
+			if ( codeGen )
+			{
+				codeGen->SetValue( languages );
+			}
+		}
+		AppData()->GenerateCode( false, true );
+		return true;
+	}
+
+	// Generates the inherited classes of all the forms of the loaded project, with the names proposed by the dialog
+	bool GenerateInheritedClasses()
+	{
+		PObjectBase project = AppData()->GetProjectData();
+		if ( project->IsNull( _("file") ) )
+		{
+			wxLogError( _("You must set the \"file\" property of the project before generating inherited classes.") );
+			return false;
+		}
+
+		wxString path;
+		try
+		{
+			path = AppData()->GetOutputPath();
+		}
+		catch ( wxFBException& ex )
+		{
+			wxLogError( ex.what() );
+			return false;
+		}
+
+		std::vector< GenClassDetails > classes;
+		GenInheritedClassDlg::GetDefaultClasses( project, &classes );
+		return AppData()->GenerateInheritedClasses( classes, path, true );
+	}
+
+	// Regenerates the projects of a directory when they, or their embedded bitmaps, change
+	class ProjectWatcher : public wxEvtHandler
+	{
+	private:
+		// Bursts of writes within this time regenerate once
+		static const int DEBOUNCE_MS = 250;
+
+		wxString m_dir;
+		wxString m_languages;
+		std::unique_ptr< wxFileSystemWatcher > m_watcher;
+		wxTimer m_timer;
+
+		std::set< wxString > m_pending;
+
+		// Embedded bitmap -> projects using it, and the directories watched outside m_dir for them
+		std::map< wxString, std::set< wxString > > m_dependencies;
+		std::set< wxString > m_watchedDirs;
+
+		static wxString Normalize( const wxFileName& file )
+		{
+			wxFileName normalized( file );
+			normalized.Normalize( wxPATH_NORM_DOTS | wxPATH_NORM_ABSOLUTE | wxPATH_NORM_LONG );
+			return normalized.GetFullPath();
+		}
+
+		void Start()
+		{
+			// The watcher needs a running event loop
+			m_watcher.reset( new wxFileSystemWatcher );
+			m_watcher->SetOwner( this );
+			if ( !m_watcher->AddTree( wxFileName::DirName( m_dir ) ) )
+			{
+				wxLogError( wxT("Unable to watch %s"), m_dir.c_str() );
+				wxTheApp->ExitMainLoop();
+				return;
+			}
+
+			// Bring everything up to date first, this also finds the dependencies
+			wxArrayString projects;
+			wxDir::GetAllFiles( m_dir, &projects, wxT("*.fbp") );
+			for ( size_t i = 0; i < projects.GetCount(); ++i )
+			{
+				m_pending.insert( Normalize( wxFileName( projects[i] ) ) );
+			}
+			Generate();
+
+			wxLogMessage( wxT("Watching %s"), m_dir.c_str() );
+		}
+
+		void UpdateDependencies( const wxString& file )
+		{
+			for ( auto& dependency : m_dependencies )
+			{
+				dependency.second.erase( file );
+			}
+
+			PObjectBase project = AppData()->GetProjectData();
+			if ( !project )
+			{
+				return;
+			}
+
+			const std::vector< wxString >& bitmaps = AppData()->GetCodeAnalysis()->GetSummary( project )->GetEmbeddedBitmaps();
+			for ( std::vector< wxString >::const_iterator value = bitmaps.begin(); value != bitmaps.end(); ++value )
+			{
+				wxString path;
+				wxString source;
+				wxSize icoSize;
+				TypeConv::ParseBitmapWithResource( *value, &path, &source, &icoSize );
+
+				wxFileName bitmap( TypeConv::MakeAbsolutePath( path, AppData()->GetProjectPath() ) );
+				if ( source != _("Load From Embedded File") && bitmap.GetExt().Upper() != wxT("XPM") )
+				{
+					continue;
+				}
+
+				const wxString bitmapPath = Normalize( bitmap );
+				m_dependencies[ bitmapPath ].insert( file );
+
+				// Bitmaps outside the tree need their own watch
+				const wxString bitmapDir = Normalize( wxFileName::DirName( bitmap.GetPath() ) );
+				if ( !bitmapDir.StartsWith( m_dir ) && m_watchedDirs.insert( bitmapDir ).second )
+				{
+					m_watcher->Add( wxFileName::DirName( bitmapDir ) );
+				}
+			}
+		}
+
+		void Generate()
+		{
+			std::set< wxString > pending;
+			pending.swap( m_pending );
+
+			for ( std::set< wxString >::iterator file = pending.begin(); file != pending.end(); ++file )
+			{
+				if ( !wxFileName::FileExists( *file ) )
+				{
+					continue;
+				}
+
+				wxStopWatch watch;
+				if ( GenerateProject( *file, m_languages ) )
+				{
+					UpdateDependencies( *file );
+					wxLogMessage( wxT("Generated %s in %ld ms"), file->c_str(), watch.Time() );
+				}
+			}
+		}
+
+		void OnFileSystemEvent( wxFileSystemWatcherEvent& event )
+		{
+			if ( !( event.GetChangeType() & ( wxFSW_EVENT_CREATE | wxFSW_EVENT_MODIFY | wxFSW_EVENT_RENAME ) ) )
+			{
+				return;
+			}
+
+			const wxFileName& changed = ( event.GetChangeType() & wxFSW_EVENT_RENAME ? event.GetNewPath() : event.GetPath() );
+			const wxString path = Normalize( changed );
+
+			if ( changed.GetExt().Lower() == wxT("fbp") )
+			{
+				m_pending.insert( path );
+			}
+			else if ( !ProjectStorage::GetProjectOfForm( path ).empty() )
+			{
+				m_pending.insert( ProjectStorage::GetProjectOfForm( path ) );
+			}
+			else
+			{
+				std::map< wxString, std::set< wxString > >::iterator dependency = m_dependencies.find( path );
+				if ( dependency == m_dependencies.end() || dependency->second.empty() )
+				{
+					return;
+				}
+				m_pending.insert( dependency->second.begin(), dependency->second.end() );
+			}
+
+			m_timer.StartOnce( DEBOUNCE_MS );
+		}
+
+		void OnTimer( wxTimerEvent& )
+		{
+			Generate();
+		}
+
+	public:
+		ProjectWatcher( const wxString& dir, const wxString& languages )
+		:
+		m_dir( Normalize( wxFileName::DirName( dir ) ) ),
+		m_languages( languages ),
+		m_timer( this )
+		{
+			Bind( wxEVT_FSWATCHER, &ProjectWatcher::OnFileSystemEvent, this );
+			Bind( wxEVT_TIMER, &ProjectWatcher::OnTimer, this );
+			CallAfter( &ProjectWatcher::Start );
+		}
+	};
+
+	// Answers a request of the code generation server
+	wxString GenerateRequested( const wxString& languages, const wxArrayString& files )
+	{
+		wxString reply;
+		for ( size_t i = 0; i < files.GetCount(); ++i )
+		{
+			GenerationLog log;
+			wxLog* previous = wxLog::SetActiveTarget( &log );
+			bool generated = GenerateProject( files[i], languages );
+			wxLog::SetActiveTarget( previous );
+
+			if ( generated && log.GetErrors().empty() )
+			{
+				reply << wxT("OK ") << files[i] << wxT("\n");
+			}
+			else
+			{
+				wxString errors = log.GetErrors();
+				errors.Replace( wxT("\n"), wxT(" ") );
+				reply << wxT("ERROR ") << files[i] << wxT(": ") << errors << wxT("\n");
+				wxLogError( wxT("%s: %s"), files[i].c_str(), errors.c_str() );
+			}
+		}
+		return reply;
+	}
+}
+
 int MyApp::OnRun()
 {
 	// Abnormal Termination Handling
@@ -126,14 +436,60 @@ int MyApp::OnRun()
 		return EXIT_SUCCESS;
 	}
 
-	// Get project to load
+	wxString service = wxFBIPC::GetGenerationService();
+	parser.Found( wxT("service"), &service );
+
+	if ( parser.Found( wxT("stop-server") ) )
+	{
+		if ( !wxFBIPC::StopGenerationServer( service ) )
+		{
+			wxLogError( _("There is no code generation server on %s."), service.c_str() );
+			return 7;
+		}
+		return 0;
+	}
+
+	// Get project to load, all the passed projects are generated
+	wxArrayString projects;
+	for ( size_t i = 0; i < parser.GetParamCount(); ++i )
+	{
+		projects.Add( parser.GetParam( i ) );
+	}
+
 	wxString projectToLoad = wxEmptyString;
-	if ( parser.GetParamCount() > 0 )
+	if ( !projects.IsEmpty() )
 	{
-		projectToLoad = parser.GetParam();
+		projectToLoad = projects[0];
 	}
 
 	bool justGenerate = false;
+	bool serve = parser.Found( wxT("server") );
+	wxString watchDir;
+	bool watch = parser.Found( wxT("watch"), &watchDir );
+	if ( watch && !wxDirExists( watchDir ) )
+	{
+		wxLogError( _("The directory to watch does not exist: %s"), watchDir.c_str() );
+		return 2;
+	}
+	wxString convertTo;
+	bool convert = parser.Found( wxT("convert"), &convertTo );
+	if ( convert && projects.GetCount() != 1 )
+	{
+		wxLogError( _("You must pass one project file to convert.") );
+		return 2;
+	}
+	bool upgrade = parser.Found( wxT("upgrade") );
+	if ( upgrade && projects.IsEmpty() )
+	{
+		wxLogError( _("You must pass a path to a project file. Nothing to upgrade.") );
+		return 2;
+	}
+	bool reportMemory = parser.Found( wxT("report-memory") );
+	if ( reportMemory && projects.IsEmpty() )
+	{
+		wxLogError( _("You must pass a path to a project file. Nothing to report.") );
+		return 2;
+	}
 	wxString language;
 	bool hasLanguage = parser.Found( wxT("l"), &language );
 	if ( parser.Found( wxT("g") ) )
@@ -157,34 +513,43 @@ int MyApp::OnRun()
 		// generate code
 		justGenerate = true;
 	}
-	else
+	else if ( !serve && !watch && !convert && !upgrade && !reportMemory )
 	{
 		delete wxLog::SetActiveTarget( new wxLogGui );
 	}
 
+	wxString profileFile;
+	bool profile = justGenerate && parser.Found( wxT("profile-templates"), &profileFile );
+	bool inherited = justGenerate && parser.Found( wxT("inherited") );
+
 	// Create singleton AppData - wait to initialize until sure that this is not the second
 	// instance of a project file.
 	AppDataCreate( dataDir );
 
-	// Make passed project name absolute
+	// Make passed project names absolute
 	try
 	{
-		if ( !projectToLoad.empty() )
+		for ( size_t i = 0; i < projects.GetCount(); ++i )
 		{
-			wxFileName projectPath( projectToLoad );
+			wxFileName projectPath( projects[i] );
 			if ( !projectPath.IsOk() )
 			{
-				THROW_WXFBEX( wxT("This path is invalid: ") << projectToLoad );
+				THROW_WXFBEX( wxT("This path is invalid: ") << projects[i] );
 			}
 
 			if ( !projectPath.IsAbsolute() )
 			{
 				if ( !projectPath.MakeAbsolute() )
 				{
-					THROW_WXFBEX( wxT("Could not make path absolute: ") << projectToLoad );
+					THROW_WXFBEX( wxT("Could not make path absolute: ") << projects[i] );
 				}
 			}
-			projectToLoad = projectPath.GetFullPath();
+			projects[i] = projectPath.GetFullPath();
+		}
+
+		if ( !projects.IsEmpty() )
+		{
+			projectToLoad = projects[0];
 		}
 	}
 	catch ( wxFBException& ex )
@@ -192,8 +557,19 @@ int MyApp::OnRun()
 		wxLogError( ex.what() );
 	}
 
+	// Let a running server generate the projects, it has everything loaded already
+	if ( justGenerate && !profile && !inherited && parser.Found( wxT("connect") ) )
+	{
+		wxString reply;
+		if ( wxFBIPC::RequestGeneration( service, ( hasLanguage ? language : wxString() ), projects, &reply ) )
+		{
+			std::cout << reply.utf8_str() << std::flush;
+			return ( reply.Contains( wxT("ERROR ") ) ? 6 : 0 );
+		}
+	}
+
 	// If the project is already loaded in another instance, switch to that instance and quit
-	if ( !projectToLoad.empty() && !justGenerate )
+	if ( !projectToLoad.empty() && !justGenerate && !serve && !watch && !convert && !upgrade && !reportMemory )
 	{
 		if ( ::wxFileExists( projectToLoad ) )
 		{
@@ -251,7 +627,7 @@ int MyApp::OnRun()
 	config->SetPath( wxT("/") );
 
 	m_frame = new MainFrame( NULL ,wxID_ANY, (int)style, wxPoint( x, y ), wxSize( w, h ) );
-	if ( !justGenerate )
+	if ( !justGenerate && !serve && !watch && !convert && !upgrade && !reportMemory )
 	{
 		m_frame->Show( TRUE );
 		SetTopWindow( m_frame );
@@ -273,39 +649,103 @@ int MyApp::OnRun()
 	::wxSetWorkingDirectory( dataDir );
 	#endif
 
-	if ( !projectToLoad.empty() )
+	if ( serve )
 	{
-		if ( AppData()->LoadProject( projectToLoad, justGenerate ) )
+		if ( !AppData()->CreateGenerationServer( service, GenerateRequested ) )
 		{
-			if ( justGenerate )
+			return 7;
+		}
+
+		wxLogMessage( wxT("Code generation server listening on %s"), service.c_str() );
+		AppData()->NewProject();
+		return wxApp::OnRun();
+	}
+
+	if ( watch )
+	{
+		if ( hasLanguage )
+		{
+			language.Replace( wxT(","), wxT("|"), true );
+		}
+
+		// The object database stays loaded between the generations
+		ProjectWatcher watcher( watchDir, ( hasLanguage ? language : wxString() ) );
+		AppData()->NewProject();
+		return wxApp::OnRun();
+	}
+
+	if ( convert )
+	{
+		if ( !AppData()->LoadProject( projectToLoad, true ) )
+		{
+			wxLogError( wxT("Unable to load project: %s"), projectToLoad.c_str() );
+			return 6;
+		}
+
+		try
+		{
+			wxFileName output( convertTo );
+			output.MakeAbsolute();
+			AppData()->WriteProject( output.GetFullPath() );
+		}
+		catch ( wxFBException& ex )
+		{
+			wxLogError( ex.what() );
+			return 6;
+		}
+		return 0;
+	}
+
+	if ( upgrade )
+	{
+		return ( AppData()->UpgradeProjects( projects ) ? 0 : 6 );
+	}
+
+	if ( reportMemory )
+	{
+		if ( !AppData()->LoadProject( projectToLoad, true ) )
+		{
+			wxLogError( wxT("Unable to load project: %s"), projectToLoad.c_str() );
+			return 6;
+		}
+		return ( MemoryReport::Write( MemoryReport::Build( NULL ), wxEmptyString ) ? 0 : 6 );
+	}
+
+	if ( justGenerate )
+	{
+		TemplateProfile::Enable( profile );
+
+		bool generated = true;
+		for ( size_t i = 0; i < projects.GetCount(); ++i )
+		{
+			if ( GenerateProject( projects[i], ( hasLanguage ? language : wxString() ) ) )
 			{
-				if ( hasLanguage )
-				{
-					PObjectBase project = AppData()->GetProjectData();
-					PProperty codeGen = project->GetProperty( _("code_generation") );
-					if ( codeGen )
-					{
-						codeGen->SetValue( language );
-					}
-				}
-				AppData()->GenerateCode( false, true );
-				return 0;
+				generated = ( !inherited || GenerateInheritedClasses() ) && generated;
 			}
 			else
 			{
-				m_frame->InsertRecentProject( projectToLoad );
-				return wxApp::OnRun();
+				generated = false;
 			}
 		}
-		else
+
+		if ( profile && !TemplateProfile::WriteReport( profileFile ) )
 		{
-			wxLogError( wxT("Unable to load project: %s"), projectToLoad.c_str() );
+			generated = false;
 		}
+		return ( generated ? 0 : 6 );
 	}
 
-	if ( justGenerate )
+	if ( !projectToLoad.empty() )
 	{
-		return 6;
+		if ( AppData()->LoadProject( projectToLoad, justGenerate ) )
+		{
+			m_frame->InsertRecentProject( projectToLoad );
+			return wxApp::OnRun();
+		}
+		else
+		{
+			wxLogError( wxT("Unable to load project: %s"), projectToLoad.c_str() );
+		}
 	}
 
 	AppData()->NewProject();
@@ -330,6 +770,9 @@ bool MyApp::OnInit()
 
 int MyApp::OnExit()
 {
+	// Do not leave generated files half written
+	FileCodeWriter::WaitForPendingWrites();
+
 	MacroDictionary::Destroy();
 	AppDataDestroy();
 
@@ -0,0 +1,666 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "binaryproject.h"
+
+#include "objectbase.h"
+
+#include "../utils/fileutils.h"
+#include "../utils/wxfbexception.h"
+
+#include <ticpp.h>
+#include <wx/ffile.h>
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <wx/mstream.h>
+#include <wx/zstream.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	// Includes the terminating NUL, so a text file never matches
+	const char SIGNATURE[] = "wxFBbin";
+	const size_t SIGNATURE_SIZE = sizeof( SIGNATURE );
+
+	const wxChar* EXTENSION = wxT("fbpb");
+
+	enum Compression
+	{
+		COMPRESSION_NONE = 0,
+		COMPRESSION_DEFLATE = 1
+	};
+
+	void WriteVarint( std::string& out, uint64_t value )
+	{
+		while ( value >= 0x80 )
+		{
+			out.push_back( static_cast< char >( ( value & 0x7F ) | 0x80 ) );
+			value >>= 7;
+		}
+		out.push_back( static_cast< char >( value ) );
+	}
+
+	/**
+	* Encodes the tree in one pass, collecting the string table, which is written before it.
+	*/
+	class Writer
+	{
+	private:
+		std::string m_tree;
+
+		std::vector< std::string > m_strings;
+		std::unordered_map< std::string, uint32_t > m_indices;
+
+		// Shortcuts to the index of the names by descriptor, and of the values by interned buffer
+		std::unordered_map< const void*, uint32_t > m_names;
+		std::unordered_map< const std::string*, uint32_t > m_values;
+
+		uint32_t Intern( const std::string& value )
+		{
+			std::pair< std::unordered_map< std::string, uint32_t >::iterator, bool > inserted =
+				m_indices.insert( std::make_pair( value, (uint32_t)m_strings.size() ) );
+			if ( inserted.second )
+			{
+				m_strings.push_back( value );
+			}
+			return inserted.first->second;
+		}
+
+		uint32_t InternName( const void* descriptor, const wxString& name )
+		{
+			std::unordered_map< const void*, uint32_t >::iterator it = m_names.find( descriptor );
+			if ( it != m_names.end() )
+			{
+				return it->second;
+			}
+
+			const uint32_t index = Intern( std::string( name.utf8_str() ) );
+			m_names.insert( std::make_pair( descriptor, index ) );
+			return index;
+		}
+
+		uint32_t InternValue( const InternedString& value )
+		{
+			const std::string& utf8 = value.GetUTF8();
+			std::unordered_map< const std::string*, uint32_t >::iterator it = m_values.find( &utf8 );
+			if ( it != m_values.end() )
+			{
+				return it->second;
+			}
+
+			const uint32_t index = Intern( utf8 );
+			m_values.insert( std::make_pair( &utf8, index ) );
+			return index;
+		}
+
+	public:
+		void WriteObject( PObjectBase obj )
+		{
+			WriteVarint( m_tree, InternName( obj->GetObjectInfo().get(), obj->GetClassName() ) );
+			m_tree.push_back( obj->GetExpanded() ? 1 : 0 );
+
+			const PropertyMap& properties = obj->GetPropertyMap();
+			WriteVarint( m_tree, properties.size() );
+			for ( PropertyMap::const_iterator prop = properties.begin(); prop != properties.end(); ++prop )
+			{
+				WriteVarint( m_tree, InternName( prop->second->GetPropertyInfo().get(), prop->first ) );
+				WriteVarint( m_tree, InternValue( prop->second->GetInternedValue() ) );
+			}
+
+			// As in the XML format, only the events with a handler
+			const EventMap& events = obj->GetEventMap();
+			size_t handlers = 0;
+			for ( EventMap::const_iterator event = events.begin(); event != events.end(); ++event )
+			{
+				if ( !event->second->GetInternedValue().empty() )
+				{
+					++handlers;
+				}
+			}
+
+			WriteVarint( m_tree, handlers );
+			for ( EventMap::const_iterator event = events.begin(); event != events.end(); ++event )
+			{
+				if ( !event->second->GetInternedValue().empty() )
+				{
+					WriteVarint( m_tree, InternName( event->second->GetEventInfo().get(), event->first ) );
+					WriteVarint( m_tree, InternValue( event->second->GetInternedValue() ) );
+				}
+			}
+
+			WriteVarint( m_tree, obj->GetChildCount() );
+			for ( unsigned int i = 0; i < obj->GetChildCount(); ++i )
+			{
+				WriteObject( obj->GetChild( i ) );
+			}
+		}
+
+		std::string GetPayload()
+		{
+			std::string payload;
+			WriteVarint( payload, m_strings.size() );
+			for ( std::vector< std::string >::iterator value = m_strings.begin(); value != m_strings.end(); ++value )
+			{
+				WriteVarint( payload, value->size() );
+				payload.append( *value );
+			}
+			payload.append( m_tree );
+			return payload;
+		}
+	};
+
+	/**
+	* Bounds checked reading of a buffer.
+	*/
+	class Cursor
+	{
+	protected:
+		const char* m_pos;
+		const char* m_end;
+		wxString m_path;
+
+		void Corrupt()
+		{
+			THROW_WXFBEX( _("The binary project is corrupt: ") << m_path )
+		}
+
+	public:
+		Cursor( const char* data, size_t size, const wxString& path )
+		:
+		m_pos( data ),
+		m_end( data + size ),
+		m_path( path )
+		{
+		}
+
+		const char* GetPosition() const { return m_pos; }
+		size_t GetRemaining() const { return m_end - m_pos; }
+
+		unsigned char ReadByte()
+		{
+			if ( m_pos == m_end )
+			{
+				Corrupt();
+			}
+			return static_cast< unsigned char >( *m_pos++ );
+		}
+
+		uint64_t ReadVarint()
+		{
+			uint64_t value = 0;
+			for ( unsigned int shift = 0; shift < 64; shift += 7 )
+			{
+				const unsigned char byte = ReadByte();
+				value |= static_cast< uint64_t >( byte & 0x7F ) << shift;
+				if ( !( byte & 0x80 ) )
+				{
+					return value;
+				}
+			}
+
+			Corrupt();
+			return 0;
+		}
+
+		// Number of entries that follow, each one takes at least a byte
+		size_t ReadCount()
+		{
+			const uint64_t count = ReadVarint();
+			if ( count > GetRemaining() )
+			{
+				Corrupt();
+			}
+			return static_cast< size_t >( count );
+		}
+
+		std::string_view ReadBytes( size_t size )
+		{
+			if ( size > GetRemaining() )
+			{
+				Corrupt();
+			}
+			std::string_view bytes( m_pos, size );
+			m_pos += size;
+			return bytes;
+		}
+	};
+
+	/**
+	* The string table at the start of the payload, and the indices to it that follow.
+	*/
+	class Payload : public Cursor
+	{
+	protected:
+		std::vector< std::string_view > m_strings;
+
+		size_t ReadIndex()
+		{
+			const uint64_t index = ReadVarint();
+			if ( index >= m_strings.size() )
+			{
+				Corrupt();
+			}
+			return static_cast< size_t >( index );
+		}
+
+	public:
+		Payload( const std::string& payload, const wxString& path )
+		:
+		Cursor( payload.data(), payload.size(), path )
+		{
+			const size_t count = ReadCount();
+			m_strings.reserve( count );
+			for ( size_t i = 0; i < count; ++i )
+			{
+				m_strings.push_back( ReadBytes( ReadCount() ) );
+			}
+		}
+	};
+
+	/**
+	* Creates the objects as ObjectDatabase::CreateObject does from the XML elements.
+	*/
+	class Reader : public Payload
+	{
+	private:
+		PObjectDatabase m_database;
+
+		// Converted on first use
+		std::vector< wxString > m_names;
+		std::vector< InternedString > m_values;
+		std::vector< bool > m_valueLoaded;
+
+		const wxString& GetName( size_t index )
+		{
+			if ( m_names[ index ].empty() )
+			{
+				m_names[ index ] = wxString::FromUTF8( m_strings[ index ].data(), m_strings[ index ].size() );
+			}
+			return m_names[ index ];
+		}
+
+		const InternedString& GetValue( size_t index )
+		{
+			if ( !m_valueLoaded[ index ] )
+			{
+				m_values[ index ] = InternedString::FromUTF8( m_strings[ index ].data(), m_strings[ index ].size() );
+				m_valueLoaded[ index ] = true;
+			}
+			return m_values[ index ];
+		}
+
+		// The properties, events and children of an object
+		void SkipContents()
+		{
+			for ( size_t count = ReadCount() * 2; count > 0; --count )
+			{
+				ReadIndex();
+			}
+			for ( size_t count = ReadCount() * 2; count > 0; --count )
+			{
+				ReadIndex();
+			}
+			for ( size_t count = ReadCount(); count > 0; --count )
+			{
+				ReadIndex();
+				ReadByte();
+				SkipContents();
+			}
+		}
+
+	public:
+		Reader( PObjectDatabase database, const std::string& payload, const wxString& path )
+		:
+		Payload( payload, path ),
+		m_database( database )
+		{
+			m_names.resize( m_strings.size() );
+			m_values.resize( m_strings.size() );
+			m_valueLoaded.resize( m_strings.size(), false );
+		}
+
+		PObjectBase ReadObject( PObjectBase parent )
+		{
+			const std::string_view className = m_strings[ ReadIndex() ];
+			const bool expanded = ( ReadByte() != 0 );
+
+			PObjectBase newobject = m_database->CreateObject( std::string( className ), parent );
+
+			// It is possible the CreateObject returns an "item" containing the object, e.g. SizerItem or SplitterItem
+			PObjectBase object = newobject;
+			if ( object && object->GetChildCount() > 0 )
+			{
+				object = object->GetChild( 0 );
+			}
+
+			if ( !object )
+			{
+				// Not valid here, skipped with its children as when loading the XML
+				SkipContents();
+				return newobject;
+			}
+
+			object->SetExpanded( expanded );
+
+			for ( size_t count = ReadCount(); count > 0; --count )
+			{
+				const size_t name = ReadIndex();
+				const size_t value = ReadIndex();
+
+				PProperty prop = object->GetProperty( GetName( name ) );
+				if ( prop )
+				{
+					prop->SetInternedValue( GetValue( value ) );
+				}
+				else if ( !m_strings[ value ].empty() )
+				{
+					wxLogError( _("The property named \"%s\" of class \"%s\" is not supported by this version of wxFormBuilder.\nIf you save this project, YOU WILL LOSE DATA"),
+								GetName( name ).c_str(), object->GetClassName().c_str() );
+				}
+			}
+
+			for ( size_t count = ReadCount(); count > 0; --count )
+			{
+				const size_t name = ReadIndex();
+				const size_t value = ReadIndex();
+
+				PEvent event = object->GetEvent( GetName( name ) );
+				if ( event )
+				{
+					event->SetInternedValue( GetValue( value ) );
+				}
+			}
+
+			if ( parent )
+			{
+				// set up parent/child relationship
+				parent->AddChild( newobject );
+				newobject->SetParent( parent );
+			}
+
+			for ( size_t count = ReadCount(); count > 0; --count )
+			{
+				ReadObject( object );
+			}
+
+			return newobject;
+		}
+	};
+
+	/**
+	* Creates the elements ObjectBase::SerializeObject creates, for the conversions and the text representation.
+	*/
+	class XmlReader : public Payload
+	{
+	private:
+		std::string ReadString()
+		{
+			const std::string_view value = m_strings[ ReadIndex() ];
+			return std::string( value.data(), value.size() );
+		}
+
+		void ReadValues( TiXmlElement* element, const char* tag )
+		{
+			for ( size_t count = ReadCount(); count > 0; --count )
+			{
+				TiXmlElement* value = new TiXmlElement( tag );
+				element->LinkEndChild( value );
+				value->SetAttribute( "name", ReadString() );
+
+				const std::string text = ReadString();
+				if ( !text.empty() )
+				{
+					value->LinkEndChild( new TiXmlText( text ) );
+				}
+			}
+		}
+
+	public:
+		XmlReader( const std::string& payload, const wxString& path )
+		:
+		Payload( payload, path )
+		{
+		}
+
+		void ReadObject( TiXmlElement* element )
+		{
+			element->SetValue( "object" );
+			element->SetAttribute( "class", ReadString() );
+			element->SetAttribute( "expanded", ReadByte() != 0 ? 1 : 0 );
+
+			ReadValues( element, "property" );
+			ReadValues( element, "event" );
+
+			for ( size_t count = ReadCount(); count > 0; --count )
+			{
+				TiXmlElement* child = new TiXmlElement( "object" );
+				element->LinkEndChild( child );
+				ReadObject( child );
+			}
+		}
+	};
+
+	std::string WriteHeader( int major, int minor, Compression compression, size_t size )
+	{
+		std::string header( SIGNATURE, SIGNATURE_SIZE );
+		WriteVarint( header, major );
+		WriteVarint( header, minor );
+		header.push_back( compression );
+		WriteVarint( header, size );
+		return header;
+	}
+
+	// Checks the header and gets the uncompressed payload
+	std::string ReadPayload( const std::string& data, const wxString& path, uint64_t* major, uint64_t* minor )
+	{
+		Cursor header( data.data(), data.size(), path );
+		if ( header.ReadBytes( SIGNATURE_SIZE ) != std::string_view( SIGNATURE, SIGNATURE_SIZE ) )
+		{
+			THROW_WXFBEX( _("Not a binary project: ") << path )
+		}
+
+		*major = header.ReadVarint();
+		*minor = header.ReadVarint();
+
+		const unsigned char compression = header.ReadByte();
+		const uint64_t size = header.ReadVarint();
+
+		std::string payload;
+		if ( COMPRESSION_DEFLATE == compression )
+		{
+			// Limits the allocation if the size is damaged
+			if ( size > (uint64_t)header.GetRemaining() * 1032 + 1024 )
+			{
+				THROW_WXFBEX( _("The binary project is corrupt: ") << path )
+			}
+
+			payload.resize( static_cast< size_t >( size ) );
+
+			wxMemoryInputStream compressed( header.GetPosition(), header.GetRemaining() );
+			wxZlibInputStream zlib( compressed, wxZLIB_ZLIB );
+			if ( !payload.empty() && zlib.Read( &payload[0], payload.size() ).LastRead() != payload.size() )
+			{
+				THROW_WXFBEX( _("The binary project is corrupt: ") << path )
+			}
+		}
+		else if ( COMPRESSION_NONE == compression && size == header.GetRemaining() )
+		{
+			payload.assign( header.GetPosition(), header.GetRemaining() );
+		}
+		else
+		{
+			THROW_WXFBEX( _("The binary project is corrupt: ") << path )
+		}
+
+		return payload;
+	}
+}
+
+bool BinaryProject::HasBinaryExtension( const wxString& path )
+{
+	return wxFileName( path ).GetExt().Lower() == EXTENSION;
+}
+
+bool BinaryProject::IsBinaryFile( const wxString& path )
+{
+	wxFFile file( path, wxT("rb") );
+	if ( !file.IsOpened() )
+	{
+		return false;
+	}
+
+	char signature[ SIGNATURE_SIZE ];
+	return file.Read( signature, SIGNATURE_SIZE ) == SIGNATURE_SIZE && 0 == memcmp( signature, SIGNATURE, SIGNATURE_SIZE );
+}
+
+void BinaryProject::ReadVersion( const wxString& path, int* major, int* minor )
+{
+	// The header is the signature and two varints
+	wxFFile file( path, wxT("rb") );
+	char header[ SIGNATURE_SIZE + 20 ];
+	const size_t size = ( file.IsOpened() ? file.Read( header, sizeof( header ) ) : 0 );
+
+	const std::string data( header, size );
+	if ( !IsEncoded( data ) )
+	{
+		THROW_WXFBEX( _("Not a binary project: ") << path )
+	}
+	GetVersion( data, path, major, minor );
+}
+
+PObjectBase BinaryProject::Read( PObjectDatabase database, const wxString& path, int major, int minor )
+{
+	std::string data;
+	if ( !FileUtils::ReadFile( path, &data ) )
+	{
+		THROW_WXFBEX( _("Unable to read file: ") << path )
+	}
+
+	uint64_t fileMajor, fileMinor;
+	const std::string payload = ReadPayload( data, path, &fileMajor, &fileMinor );
+	if ( fileMajor != (uint64_t)major || fileMinor != (uint64_t)minor )
+	{
+		THROW_WXFBEX( wxString::Format( _("The binary project %s has the file version %d.%d instead of %d.%d."),
+										path.c_str(), (int)fileMajor, (int)fileMinor, major, minor ) )
+	}
+
+	Reader reader( database, payload, path );
+	return reader.ReadObject( PObjectBase() );
+}
+
+void BinaryProject::ReadXml( const wxString& path, TiXmlDocument* document )
+{
+	std::string data;
+	if ( !FileUtils::ReadFile( path, &data ) )
+	{
+		THROW_WXFBEX( _("Unable to read file: ") << path )
+	}
+
+	int major, minor;
+	GetVersion( data, path, &major, &minor );
+
+	// The same layout as the XML project files
+	document->LinkEndChild( new TiXmlDeclaration( "1.0", "UTF-8", "yes" ) );
+	TiXmlElement* root = new TiXmlElement( "wxFormBuilder_Project" );
+	document->LinkEndChild( root );
+
+	TiXmlElement* fileVersion = new TiXmlElement( "FileVersion" );
+	fileVersion->SetAttribute( "major", major );
+	fileVersion->SetAttribute( "minor", minor );
+	root->LinkEndChild( fileVersion );
+
+	TiXmlElement* object = new TiXmlElement( "object" );
+	root->LinkEndChild( object );
+	DecodeToXml( data, path, object );
+}
+
+void BinaryProject::Write( PObjectBase project, const wxString& path, int major, int minor )
+{
+	Writer writer;
+	writer.WriteObject( project );
+	const std::string payload = writer.GetPayload();
+
+	const std::string header = WriteHeader( major, minor, COMPRESSION_DEFLATE, payload.size() );
+
+	// The string table already removed most of the redundancy, favour the speed
+	wxMemoryOutputStream compressed;
+	{
+		wxZlibOutputStream zlib( compressed, wxZ_BEST_SPEED, wxZLIB_ZLIB );
+		zlib.Write( payload.data(), payload.size() );
+		zlib.Close();
+	}
+
+	wxStreamBuffer* buffer = compressed.GetOutputStreamBuffer();
+
+	wxTempFile file( path );
+	if ( !file.IsOpened() ||
+		 !file.Write( header.data(), header.size() ) ||
+		 !file.Write( buffer->GetBufferStart(), compressed.GetLength() ) ||
+		 !file.Commit() )
+	{
+		THROW_WXFBEX( _("Unable to write file: ") << path )
+	}
+}
+
+std::string BinaryProject::Encode( PObjectBase obj, int major, int minor )
+{
+	Writer writer;
+	writer.WriteObject( obj );
+	const std::string payload = writer.GetPayload();
+
+	return WriteHeader( major, minor, COMPRESSION_NONE, payload.size() ) + payload;
+}
+
+bool BinaryProject::IsEncoded( const std::string& data )
+{
+	return data.size() >= SIGNATURE_SIZE && 0 == memcmp( data.data(), SIGNATURE, SIGNATURE_SIZE );
+}
+
+void BinaryProject::GetVersion( const std::string& data, const wxString& name, int* major, int* minor )
+{
+	Cursor header( data.data(), data.size(), name );
+	header.ReadBytes( SIGNATURE_SIZE );
+	*major = (int)header.ReadVarint();
+	*minor = (int)header.ReadVarint();
+}
+
+PObjectBase BinaryProject::Decode( PObjectDatabase database, const std::string& data, const wxString& name )
+{
+	uint64_t major, minor;
+	const std::string payload = ReadPayload( data, name, &major, &minor );
+
+	Reader reader( database, payload, name );
+	return reader.ReadObject( PObjectBase() );
+}
+
+void BinaryProject::DecodeToXml( const std::string& data, const wxString& name, TiXmlElement* element )
+{
+	uint64_t major, minor;
+	const std::string payload = ReadPayload( data, name, &major, &minor );
+
+	XmlReader reader( payload, name );
+	reader.ReadObject( element );
+}
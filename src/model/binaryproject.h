@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+@file
+Compact binary encoding of projects, for very large projects.
+*/
+
+#ifndef __BINARY_PROJECT__
+#define __BINARY_PROJECT__
+
+#include "database.h"
+
+#include <wx/string.h>
+
+#include <string>
+
+class TiXmlDocument;
+class TiXmlElement;
+
+/**
+* Binary project files (.fbpb) hold the same tree as the XML project files.
+*
+* The header has a signature, the file version of the project and the compression used. The names and values are
+* stored once in a string table, the tree refers to them by index, and all the numbers are variable length.
+* The whole payload is compressed with deflate.
+*/
+namespace BinaryProject
+{
+	/**
+	* True if the file name has the extension of the binary projects, used to choose the format to save.
+	*/
+	bool HasBinaryExtension( const wxString& path );
+
+	/**
+	* True if the file starts with the signature of the binary projects.
+	*/
+	bool IsBinaryFile( const wxString& path );
+
+	/**
+	* Gets the file version of the project stored in the file. Throws a wxFBException if it is not a binary project.
+	*/
+	void ReadVersion( const wxString& path, int* major, int* minor );
+
+	/**
+	* Creates the project stored in the file. Only files of the passed version can be read, the others are read
+	* with ReadXml and converted as XML projects. Throws a wxFBException on failure.
+	*/
+	PObjectBase Read( PObjectDatabase database, const wxString& path, int major, int minor );
+
+	/**
+	* Fills the document as if the project stored in the file was loaded from an XML project file, with its file
+	* version, so the files of any version can be converted. Throws a wxFBException on failure.
+	*/
+	void ReadXml( const wxString& path, TiXmlDocument* document );
+
+	/**
+	* Writes the project to the file with the passed version. Throws a wxFBException on failure.
+	*/
+	void Write( PObjectBase project, const wxString& path, int major, int minor );
+
+	/**
+	* Encodes an object and its children in memory with the passed version, uncompressed, as for the clipboard.
+	*/
+	std::string Encode( PObjectBase obj, int major, int minor );
+
+	/**
+	* True if the data starts with the signature, otherwise it should be XML.
+	*/
+	bool IsEncoded( const std::string& data );
+
+	/**
+	* Gets the version of the encoded data. The name identifies the data in the errors, it throws a wxFBException if
+	* the data is corrupt.
+	*/
+	void GetVersion( const std::string& data, const wxString& name, int* major, int* minor );
+
+	/**
+	* Creates the objects of the encoded data, which must have the current version. Throws a wxFBException on failure.
+	*/
+	PObjectBase Decode( PObjectDatabase database, const std::string& data, const wxString& name );
+
+	/**
+	* Fills the element with the XML of the encoded data, as ObjectBase::SerializeObject does, of any version.
+	* Throws a wxFBException on failure.
+	*/
+	void DecodeToXml( const std::string& data, const wxString& name, TiXmlElement* element );
+}
+
+#endif //__BINARY_PROJECT__
@@ -25,11 +25,13 @@
 
 #include "database.h"
 
+#include "../md5/md5.hh"
 #include "../rad/bitmaps.h"
 #include "../utils/debug.h"
 #include "../utils/stringutils.h"
 #include "../utils/typeconv.h"
 #include "../utils/wxfbexception.h"
+#include "objectarena.h"
 #include "objectbase.h"
 
 #include <ticpp.h>
@@ -37,6 +39,8 @@
 #include <wx/filename.h>
 #include <wx/stdpaths.h>
 
+#include <fstream>
+
 //#define DEBUG_PRINT(x) cout << x
 
 #define OBJINFO_TAG "objectinfo"
@@ -86,6 +90,8 @@ void ObjectPackage::AppendPackage( PObjectPackage package )
 ///////////////////////////////////////////////////////////////////////////////
 
 ObjectDatabase::ObjectDatabase()
+:
+m_arena( new ObjectArena )
 {
 	//InitObjectTypes();
 	//  InitWidgetTypes();
@@ -141,12 +147,17 @@ PObjectPackage ObjectDatabase::GetPackage(unsigned int idx)
 * @todo La herencia de propiedades ha de ser de forma recursiva.
 */
 
+void ObjectDatabase::ResetArena()
+{
+	m_arena.reset( new ObjectArena );
+}
+
 PObjectBase ObjectDatabase::NewObject(PObjectInfo obj_info)
 {
 	PObjectBase object;
 
 	// Llagados aquí el objeto se crea seguro...
-	object = PObjectBase(new ObjectBase(obj_info->GetClassName()));
+	object = std::allocate_shared< ObjectBase >( ArenaAllocator< ObjectBase >( m_arena ), obj_info->GetClassName() );
 	object->SetObjectTypeName(obj_info->GetObjectTypeName()); // *FIXME*
 
 	object->SetObjectInfo(obj_info);
@@ -164,19 +175,19 @@ PObjectBase ObjectDatabase::NewObject(PObjectInfo obj_info)
 		{
 			prop_info = class_info->GetPropertyInfo(i);
 
-			PProperty property(new Property(prop_info, object));
+			PProperty property = std::allocate_shared< Property >( ArenaAllocator< Property >( m_arena ), prop_info, object );
 
 			// Set the default value, either from the property info, or an override from this class
-			wxString defaultValue = prop_info->GetDefaultValue();
+			// The default of the property info is shared, not copied
+			property->SetDefaultValue();
 			if ( base > 0 )
 			{
 				wxString defaultValueTemp = obj_info->GetBaseClassDefaultPropertyValue( base - 1, prop_info->GetName() );
 				if ( !defaultValueTemp.empty() )
 				{
-					defaultValue = defaultValueTemp;
+					property->SetValue( defaultValueTemp );
 				}
 			}
-			property->SetValue( defaultValue );
 
 			// Las propiedades están implementadas con una estructura "map",
 			// ello implica que no habrá propiedades duplicadas.
@@ -191,7 +202,7 @@ PObjectBase ObjectDatabase::NewObject(PObjectInfo obj_info)
 		for (i=0; i < class_info->GetEventCount(); i++)
 		{
 		  event_info = class_info->GetEventInfo(i);
-		  PEvent event(new Event(event_info,object));
+		  PEvent event = std::allocate_shared< Event >( ArenaAllocator< Event >( m_arena ), event_info, object );
 		  // notice that for event there isn't a default value on its creation
 		  // because there is not handler at the moment
 		  object->AddEvent(event);
@@ -379,40 +390,36 @@ PObjectBase ObjectDatabase::CopyObject(PObjectBase obj)
 
 	PObjectInfo objInfo = obj->GetObjectInfo();
 
-	PObjectBase copyObj = NewObject(objInfo); // creamos la copia
-	assert(copyObj);
+	// The copy has the same class, so the same properties and events: the storage is copied as is,
+	// without setting the defaults or counting a new instance, the name is copied too
+	PObjectBase copyObj = std::allocate_shared< ObjectBase >( ArenaAllocator< ObjectBase >( m_arena ), obj->GetClassName() );
+	copyObj->SetObjectTypeName( obj->GetObjectTypeName() );
+	copyObj->SetObjectInfo( objInfo );
+	copyObj->SetExpanded( obj->GetExpanded() );
 
-	// copiamos las propiedades
-	unsigned int i;
-	unsigned int count = obj->GetPropertyCount();
-	for (i = 0; i < count; i++)
+	// The maps are walked in order, so each insertion goes at the end
+	for ( PropertyMap::iterator prop = obj->m_properties.begin(); prop != obj->m_properties.end(); ++prop )
 	{
-		PProperty objProp = obj->GetProperty(i);
-		assert(objProp);
-
-		PProperty copyProp = copyObj->GetProperty(objProp->GetName());
-		assert(copyProp);
-
-		wxString propValue = objProp->GetValue();
-		copyProp->SetValue(propValue);
+		PProperty copyProp = std::allocate_shared< Property >( ArenaAllocator< Property >( m_arena ), prop->second->GetPropertyInfo(), copyObj );
+		copyProp->SetInternedValue( prop->second->GetInternedValue() );
+		copyObj->m_properties.insert( copyObj->m_properties.end(), PropertyMap::value_type( prop->first, copyProp ) );
 	}
 
 	// ...and the event handlers
-	count = obj->GetEventCount();
-	for (i = 0; i < count; i++)
+	for ( EventMap::iterator event = obj->m_events.begin(); event != obj->m_events.end(); ++event )
 	{
-	  PEvent event = obj->GetEvent(i);
-	  PEvent copyEvent = copyObj->GetEvent(event->GetName());
-	  copyEvent->SetValue(event->GetValue());
+		PEvent copyEvent = std::allocate_shared< Event >( ArenaAllocator< Event >( m_arena ), event->second->GetEventInfo(), copyObj );
+		copyEvent->SetInternedValue( event->second->GetInternedValue() );
+		copyObj->m_events.insert( copyObj->m_events.end(), EventMap::value_type( event->first, copyEvent ) );
 	}
 
 	// creamos recursivamente los hijos
-	count = obj->GetChildCount();
-	for (i = 0; i<count; i++)
+	copyObj->m_children.reserve( obj->m_children.size() );
+	for ( ObjectBaseVector::iterator child = obj->m_children.begin(); child != obj->m_children.end(); ++child )
 	{
-		PObjectBase childCopy = CopyObject(obj->GetChild(i));
-		copyObj->AddChild(childCopy);
-		childCopy->SetParent(copyObj);
+		PObjectBase childCopy = CopyObject( *child );
+		copyObj->m_children.push_back( childCopy );
+		childCopy->SetParent( copyObj );
 	}
 
 	return copyObj;
@@ -909,6 +916,16 @@ void ObjectDatabase::LoadCodeGen( const wxString& file )
 		ticpp::Document doc;
 		XMLUtils::LoadXMLFile( doc, true, file );
 
+		// Keep track of the templates, so the generated code can be cached
+		std::ifstream templateFile( file.mb_str( wxConvFile ), std::ios::binary | std::ios::in );
+		if ( templateFile )
+		{
+			MD5 md5( templateFile );
+			char* digest = md5.hex_digest();
+			m_codeGenSignature << wxString::FromAscii( digest ) << wxT(" ");
+			delete [] digest;
+		}
+
 		// read the codegen element
 		ticpp::Element* elem_codegen = doc.FirstChildElement("codegen");
 		std::string language;
@@ -1464,6 +1481,18 @@ PropertyType ObjectDatabase::ParsePropertyType( wxString str )
 	return result;
 }
 
+wxString ObjectDatabase::GetPropertyTypeName( PropertyType type ) const
+{
+	for ( PTMap::const_iterator it = m_propTypes.begin(); it != m_propTypes.end(); ++it )
+	{
+		if ( it->second == type )
+		{
+			return it->first;
+		}
+	}
+	return wxEmptyString;
+}
+
 wxString  ObjectDatabase::ParseObjectType( wxString str )
 {
 	return str;
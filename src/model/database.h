@@ -151,6 +151,12 @@ class ObjectDatabase
 
   PTLangTemplateMap m_propertyTypeTemplates;
 
+  // Digests of the code template files loaded, in order
+  wxString m_codeGenSignature;
+
+  // Memory pool for the objects of the current project
+  PObjectArena m_arena;
+
   /**
    * Initialize the property type map.
    */
@@ -206,6 +212,18 @@ class ObjectDatabase
 
   PObjectBase NewObject(PObjectInfo obj_info);
 
+  /**
+   * Allocates the next objects from a new pool, the pool of the previous project is released with its last object.
+   */
+  void ResetArena();
+
+  PObjectArena GetArena() { return m_arena; }
+
+  /**
+   * Name of a property type as written in the descriptions, empty if unknown.
+   */
+  wxString GetPropertyTypeName( PropertyType type ) const;
+
   /**
    * Obtiene la información de un objeto a partir del nombre de la clase.
    */
@@ -227,6 +245,12 @@ class ObjectDatabase
    * objetos.
    */
   wxString GetXmlPath()		{ return m_xmlPath; 		}
+
+  /**
+   * Identifies the code templates loaded, changes when any template file changes.
+   */
+  const wxString& GetCodeGenSignature() { return m_codeGenSignature; }
+
   wxString GetIconPath()	{ return m_iconPath; 		}
   wxString GetPluginPath()	{ return m_pluginPath; 		}
 
@@ -254,8 +278,9 @@ class ObjectDatabase
 
   /**
    * Crea un objeto como copia de otro.
+   *
+   * The whole subtree is copied, including the names, which have to be made unique by the caller.
    */
-
   PObjectBase CopyObject(PObjectBase obj);
 
   /**
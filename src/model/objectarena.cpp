@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "objectarena.h"
+
+#include <new>
+
+ObjectArena::ObjectArena()
+:
+m_current( NULL ),
+m_remaining( 0 ),
+m_used( 0 )
+{
+}
+
+ObjectArena::~ObjectArena()
+{
+	for ( std::vector< char* >::iterator block = m_blocks.begin(); block != m_blocks.end(); ++block )
+	{
+		::operator delete( *block );
+	}
+}
+
+void* ObjectArena::Allocate( size_t size )
+{
+	size = RoundUp( size );
+
+	// Big allocations are not worth pooling
+	if ( size > BLOCK_SIZE / 4 )
+	{
+		return ::operator new( size );
+	}
+
+	std::lock_guard< std::mutex > lock( m_mutex );
+	m_used += size;
+
+	std::unordered_map< size_t, void* >::iterator free = m_free.find( size );
+	if ( free != m_free.end() && free->second )
+	{
+		void* chunk = free->second;
+		free->second = *static_cast< void** >( chunk );
+		return chunk;
+	}
+
+	if ( m_remaining < size )
+	{
+		m_current = static_cast< char* >( ::operator new( BLOCK_SIZE ) );
+		m_remaining = BLOCK_SIZE;
+		m_blocks.push_back( m_current );
+	}
+
+	void* chunk = m_current;
+	m_current += size;
+	m_remaining -= size;
+	return chunk;
+}
+
+void ObjectArena::Deallocate( void* ptr, size_t size )
+{
+	size = RoundUp( size );
+
+	if ( size > BLOCK_SIZE / 4 )
+	{
+		::operator delete( ptr );
+		return;
+	}
+
+	std::lock_guard< std::mutex > lock( m_mutex );
+	m_used -= size;
+
+	void*& head = m_free[ size ];
+	*static_cast< void** >( ptr ) = head;
+	head = ptr;
+}
+
+size_t ObjectArena::GetReservedSize() const
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+	return m_blocks.size() * BLOCK_SIZE;
+}
+
+size_t ObjectArena::GetUsedSize() const
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+	return m_used;
+}
@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+@file
+Memory pool for the objects of a project.
+*/
+
+#ifndef __OBJECT_ARENA__
+#define __OBJECT_ARENA__
+
+#include "../utils/wxfbdefs.h"
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+* Allocates the objects, properties and events of a project in large blocks.
+*
+* The objects are still owned through shared_ptr, allocated with ArenaAllocator: each one keeps the arena alive,
+* so all the blocks are released at once when the last object of the project is destroyed.
+* The memory of the objects destroyed while editing is reused for new objects of the same size.
+* The arena is locked on each call, the objects can be created and destroyed by worker threads.
+*/
+class ObjectArena
+{
+private:
+	static const size_t BLOCK_SIZE = 256 * 1024;
+	static const size_t ALIGNMENT = alignof( std::max_align_t );
+
+	std::vector< char* > m_blocks;
+	char* m_current;
+	size_t m_remaining;
+
+	// Released chunks by size, linked through their first bytes
+	std::unordered_map< size_t, void* > m_free;
+
+	size_t m_used;
+
+	mutable std::mutex m_mutex;
+
+	static size_t RoundUp( size_t size ) { return ( size + ALIGNMENT - 1 ) & ~( ALIGNMENT - 1 ); }
+
+public:
+	ObjectArena();
+	~ObjectArena();
+
+	ObjectArena( const ObjectArena& ) = delete;
+	ObjectArena& operator=( const ObjectArena& ) = delete;
+
+	void* Allocate( size_t size );
+	void Deallocate( void* ptr, size_t size );
+
+	/**
+	* Bytes reserved in blocks.
+	*/
+	size_t GetReservedSize() const;
+
+	/**
+	* Bytes of the objects alive.
+	*/
+	size_t GetUsedSize() const;
+};
+
+/**
+* Standard allocator over an ObjectArena, for std::allocate_shared.
+*/
+template < class T >
+class ArenaAllocator
+{
+	template < class U > friend class ArenaAllocator;
+
+private:
+	PObjectArena m_arena;
+
+public:
+	typedef T value_type;
+
+	explicit ArenaAllocator( PObjectArena arena ) : m_arena( arena ) {}
+
+	template < class U >
+	ArenaAllocator( const ArenaAllocator< U >& other ) : m_arena( other.m_arena ) {}
+
+	T* allocate( size_t n ) { return static_cast< T* >( m_arena->Allocate( n * sizeof( T ) ) ); }
+	void deallocate( T* ptr, size_t n ) { m_arena->Deallocate( ptr, n * sizeof( T ) ); }
+
+	template < class U >
+	bool operator==( const ArenaAllocator< U >& other ) const { return m_arena == other.m_arena; }
+
+	template < class U >
+	bool operator!=( const ArenaAllocator< U >& other ) const { return m_arena != other.m_arena; }
+};
+
+#endif //__OBJECT_ARENA__
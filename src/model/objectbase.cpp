@@ -58,7 +58,8 @@ EventInfo::EventInfo(const wxString &name, const wxString &eventClass,
 
 bool Property::IsDefaultValue()
 {
-	return (m_info->GetDefaultValue() == m_value);
+	// Interned values are equal when they share the buffer
+	return (m_info->m_def_value == m_value);
 }
 
 bool Property::IsNull()
@@ -67,22 +68,23 @@ bool Property::IsNull()
 	{
 		case PT_BITMAP:
 		{
+			const wxString value = GetValue();
 			wxString path;
-			size_t semicolonIndex = m_value.find_first_of( wxT(";") );
-			if ( semicolonIndex != m_value.npos )
+			size_t semicolonIndex = value.find_first_of( wxT(";") );
+			if ( semicolonIndex != value.npos )
 			{
-				path = m_value.substr( 0, semicolonIndex );
+				path = value.substr( 0, semicolonIndex );
 			}
 			else
 			{
-				path = m_value;
+				path = value;
 			}
 
 			return path.empty();
 		}
 		case PT_WXSIZE:
 		{
-			return ( wxDefaultSize == TypeConv::StringToSize( m_value ) );
+			return ( wxDefaultSize == TypeConv::StringToSize( GetValue() ) );
 		}
 		default:
 		{
@@ -93,7 +95,7 @@ bool Property::IsNull()
 
 void Property::SetDefaultValue()
 {
-	m_value = m_info->GetDefaultValue();
+	m_value = m_info->m_def_value;
 }
 
 void Property::SetValue(const wxFontContainer &font)
@@ -131,25 +133,25 @@ void Property::SetValue(const double val )
 
 wxFontContainer Property::GetValueAsFont()
 {
-	return TypeConv::StringToFont( m_value );
+	return TypeConv::StringToFont( GetValue() );
 }
 
 wxColour Property::GetValueAsColour()
 {
-	return TypeConv::StringToColour(m_value);
+	return TypeConv::StringToColour(GetValue());
 }
 wxPoint Property::GetValueAsPoint()
 {
-	return TypeConv::StringToPoint(m_value);
+	return TypeConv::StringToPoint(GetValue());
 }
 wxSize Property::GetValueAsSize()
 {
-	return TypeConv::StringToSize(m_value);
+	return TypeConv::StringToSize(GetValue());
 }
 
 wxBitmap Property::GetValueAsBitmap()
 {
-	return TypeConv::StringToBitmap( m_value );
+	return TypeConv::StringToBitmap( GetValue() );
 }
 
 int Property::GetValueAsInteger()
@@ -161,13 +163,13 @@ int Property::GetValueAsInteger()
 	case PT_EDIT_OPTION:
 	case PT_OPTION:
 	case PT_MACRO:
-		result = TypeConv::GetMacroValue(m_value);
+		result = TypeConv::GetMacroValue(GetValue());
 		break;
 	case PT_BITLIST:
-		result = TypeConv::BitlistToInt(m_value);
+		result = TypeConv::BitlistToInt(GetValue());
 		break;
 	default:
-		result = TypeConv::StringToInt(m_value);
+		result = TypeConv::StringToInt(GetValue());
 		break;
 	}
 	return result;
@@ -180,17 +182,17 @@ wxString Property::GetValueAsString()
 
 wxString Property::GetValueAsText()
 {
-	return TypeConv::StringToText(m_value);
+	return TypeConv::StringToText(GetValue());
 }
 
 wxArrayString Property::GetValueAsArrayString()
 {
-	return TypeConv::StringToArrayString(m_value);
+	return TypeConv::StringToArrayString(GetValue());
 }
 
 double Property::GetValueAsFloat()
 {
-	return TypeConv::StringToFloat(m_value);
+	return TypeConv::StringToFloat(GetValue());
 }
 
 void Property::SplitParentProperty( std::map< wxString, wxString >* children )
@@ -204,7 +206,7 @@ void Property::SplitParentProperty( std::map< wxString, wxString >* children )
 	std::list< PropertyChild >* myChildren = m_info->GetChildren();
 	std::list< PropertyChild >::iterator it = myChildren->begin();
 
-	wxStringTokenizer tkz( m_value, wxT(";"), wxTOKEN_RET_EMPTY_ALL );
+	wxStringTokenizer tkz( GetValue(), wxT(";"), wxTOKEN_RET_EMPTY_ALL );
 	while ( tkz.HasMoreTokens() )
 	{
 		if ( myChildren->end() == it )
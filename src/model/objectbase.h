@@ -33,6 +33,7 @@
 #ifndef __OBJ__
 #define __OBJ__
 
+#include "../utils/internedstring.h"
 #include "../utils/wxfbdefs.h"
 #include "types.h"
 
@@ -87,7 +88,7 @@ class PropertyInfo
 private:
 	wxString       m_name;
 	PropertyType m_type;
-	wxString       m_def_value;
+	InternedString m_def_value;
 	POptionList  m_opt_list;
 	std::list< PropertyChild > m_children; // Only used for parent properties
 	wxString		m_description;
@@ -114,7 +115,7 @@ class EventInfo
 private:
 	wxString m_name;
 	wxString m_eventClass;
-  wxString m_defaultValue;
+  InternedString m_defaultValue;
   wxString m_description;
 
 public:
@@ -137,7 +138,7 @@ private:
 	PPropertyInfo m_info;   // pointer to its descriptor
 	WPObjectBase  m_object; // pointer to the owner object
 
-	wxString m_value;
+	InternedString m_value;
 
 public:
 	Property(PPropertyInfo info, PObjectBase obj = PObjectBase())
@@ -148,7 +149,9 @@ public:
 
 	PObjectBase GetObject() { return m_object.lock(); }
 	wxString GetName()                 { return m_info->GetName(); }
-	wxString GetValue()                { return m_value; }
+	const wxString& GetValue()         { return m_value.ToString(); }
+	const InternedString& GetInternedValue() { return m_value; }
+	void SetInternedValue( const InternedString& val ) { m_value = val; }
 	void SetValue( wxString& val )     { m_value = val; }
 	void SetValue( const wxChar* val )       { m_value = val;	}
 
@@ -192,7 +195,7 @@ class Event
 private:
   PEventInfo  m_info;   // pointer to its descriptor
   WPObjectBase m_object; // pointer to the owner object
-  wxString    m_value;  // handler function name
+  InternedString m_value;  // handler function name
 
 public:
   Event (PEventInfo info, PObjectBase obj)
@@ -200,7 +203,9 @@ public:
   {}
 
   void SetValue(const wxString &value) { m_value = value; }
-  wxString GetValue()                  { return m_value; }
+  const wxString& GetValue()           { return m_value.ToString(); }
+  const InternedString& GetInternedValue() { return m_value; }
+  void SetInternedValue(const InternedString &value) { m_value = value; }
   wxString GetName()                   { return m_info->GetName(); }
   PObjectBase GetObject()              { return m_object.lock(); }
   PEventInfo GetEventInfo()            { return m_info; }
@@ -272,6 +277,7 @@ namespace ticpp
 class ObjectBase : public IObject, public std::enable_shared_from_this<ObjectBase>
 {
 	friend class wxFBDataObject;
+	friend class ObjectDatabase;
 private:
 	wxString     m_class;  // class name
 	wxString     m_type;   // type of object
@@ -361,6 +367,12 @@ public:
 
 	unsigned int GetEventCount()    { return m_events.size(); }
 
+	/**
+	* All the properties and events, for walking them in order without the lookups of the indexed getters.
+	*/
+	const PropertyMap& GetPropertyMap() { return m_properties; }
+	const EventMap& GetEventMap()       { return m_events; }
+
 	/**
 	* Obtiene una propiedad del objeto.
 	* @todo esta función deberá lanzar una excepción en caso de no encontrarse
@@ -0,0 +1,252 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "projectstorage.h"
+
+#include "objectbase.h"
+
+#include "../utils/fileutils.h"
+#include "../utils/parallel.h"
+#include "../utils/typeconv.h"
+#include "../utils/wxfbexception.h"
+
+#include <ticpp.h>
+#include <wx/dir.h>
+#include <wx/file.h>
+#include <wx/filename.h>
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+
+namespace
+{
+	const char* PROJECT_TAG = "wxFormBuilder_Project";
+	const char* OBJECT_TAG = "object";
+	const char* FORM_ROOT_TAG = "wxFormBuilder_Form";
+	const char* FORM_TAG = "form";
+	const char* FILE_TAG = "file";
+	const char* FORMS_SUFFIX = "_forms";
+	const char* FORM_EXTENSION = "fbf";
+	const char* STORAGE_ATTRIBUTE = "storage";
+	const char* SPLIT_STORAGE = "split";
+
+	struct FormFile
+	{
+		wxString path;
+		std::string nativePath;
+		TiXmlDocument document;
+		std::string error;
+	};
+
+	std::string Print( const TiXmlDocument& document )
+	{
+		TiXmlPrinter printer;
+		document.Accept( &printer );
+		return std::string( printer.CStr(), printer.Size() );
+	}
+
+	// Unchanged files are not touched, so their time stamps and the version control stay quiet
+	void WriteIfChanged( const wxString& path, const std::string& contents )
+	{
+		std::string current;
+		if ( FileUtils::ReadFile( path, &current ) && current == contents )
+		{
+			return;
+		}
+
+		wxTempFile file( path );
+		if ( !file.IsOpened() || !file.Write( contents.data(), contents.size() ) || !file.Commit() )
+		{
+			THROW_WXFBEX( _("Unable to write file: ") << path )
+		}
+	}
+
+	// Name of the file of a form, from its name if it is a valid file name
+	wxString GetFormFileName( PObjectBase form, size_t index, std::set< wxString >& used )
+	{
+		wxString name = form->GetPropertyAsString( wxT("name") );
+		if ( name.empty() || name.find_first_of( wxFileName::GetForbiddenChars() + wxT("/\\") ) != wxString::npos )
+		{
+			name = wxString::Format( wxT("form%u"), (unsigned)index );
+		}
+
+		wxString fileName = name + wxT(".") + FORM_EXTENSION;
+		for ( unsigned int i = 1; !used.insert( fileName.Lower() ).second; ++i )
+		{
+			fileName = wxString::Format( wxT("%s_%u.%s"), name.c_str(), i, FORM_EXTENSION );
+		}
+
+		return fileName;
+	}
+}
+
+bool ProjectStorage::IsSplit( ticpp::Element* root )
+{
+	const char* storage = root->GetTiXmlPointer()->Attribute( STORAGE_ATTRIBUTE );
+	return ( storage && 0 == strcmp( storage, SPLIT_STORAGE ) );
+}
+
+wxString ProjectStorage::GetFormsDirectory( const wxString& projectFile )
+{
+	wxFileName file( projectFile );
+	return wxFileName( file.GetPath(), file.GetName() + FORMS_SUFFIX ).GetFullPath();
+}
+
+wxString ProjectStorage::GetProjectOfForm( const wxString& formFile )
+{
+	wxFileName file( formFile );
+	if ( file.GetExt().Lower() != FORM_EXTENSION )
+	{
+		return wxEmptyString;
+	}
+
+	wxArrayString dirs = file.GetDirs();
+	if ( dirs.IsEmpty() || !dirs.Last().EndsWith( FORMS_SUFFIX ) )
+	{
+		return wxEmptyString;
+	}
+
+	const wxString projectName = dirs.Last().Left( dirs.Last().length() - strlen( FORMS_SUFFIX ) );
+	file.RemoveLastDir();
+	return wxFileName( file.GetPath(), projectName, wxT("fbp") ).GetFullPath();
+}
+
+void ProjectStorage::LoadForms( PObjectDatabase database, ticpp::Element* xmlProject, PObjectBase project, const wxString& projectPath )
+{
+	std::vector< std::unique_ptr< FormFile > > forms;
+
+	TiXmlElement* element = xmlProject->GetTiXmlPointer();
+	for ( TiXmlElement* reference = element->FirstChildElement( FORM_TAG ); reference; reference = reference->NextSiblingElement( FORM_TAG ) )
+	{
+		const char* fileName = reference->Attribute( FILE_TAG );
+		if ( !fileName )
+		{
+			THROW_WXFBEX( _("The project has a form without file") )
+		}
+
+		wxFileName path( wxString::FromUTF8( fileName ) );
+		path.MakeAbsolute( projectPath );
+
+		forms.emplace_back( new FormFile );
+		forms.back()->path = path.GetFullPath();
+		forms.back()->nativePath = std::string( forms.back()->path.mb_str( wxConvFile ) );
+	}
+
+	if ( forms.empty() )
+	{
+		return;
+	}
+
+	// Only the parsing runs in parallel, the objects are created in order in this thread
+	ParallelFor( forms.size(), [ &forms ]( size_t i )
+	{
+		FormFile& form = *forms[i];
+		if ( !form.document.LoadFile( form.nativePath.c_str(), TIXML_ENCODING_UTF8 ) )
+		{
+			form.error = form.document.ErrorDesc();
+		}
+	} );
+
+	for ( std::vector< std::unique_ptr< FormFile > >::iterator form = forms.begin(); form != forms.end(); ++form )
+	{
+		if ( !( *form )->error.empty() )
+		{
+			THROW_WXFBEX( _("Unable to load form file: ") << ( *form )->path << wxT("\n") << _WXSTR( ( *form )->error ) )
+		}
+
+		TiXmlElement* root = ( *form )->document.FirstChildElement( FORM_ROOT_TAG );
+		TiXmlElement* object = ( root ? root->FirstChildElement( OBJECT_TAG ) : NULL );
+		if ( !object )
+		{
+			THROW_WXFBEX( _("Not a form file: ") << ( *form )->path )
+		}
+
+		ticpp::Element xmlForm( object );
+		if ( !database->CreateObject( &xmlForm, project ) )
+		{
+			THROW_WXFBEX( _("Unable to load form file: ") << ( *form )->path )
+		}
+	}
+}
+
+void ProjectStorage::Save( PObjectBase project, ticpp::Document* document, const wxString& projectFile )
+{
+	TiXmlDocument* projectDocument = document->GetTiXmlPointer();
+	TiXmlElement* root = projectDocument->FirstChildElement( PROJECT_TAG );
+	TiXmlElement* xmlProject = ( root ? root->FirstChildElement( OBJECT_TAG ) : NULL );
+	if ( !xmlProject )
+	{
+		THROW_WXFBEX( _("Invalid project document") )
+	}
+
+	TiXmlElement* fileVersion = root->FirstChildElement( "FileVersion" );
+	if ( !fileVersion )
+	{
+		THROW_WXFBEX( _("Invalid project document") )
+	}
+	root->SetAttribute( STORAGE_ATTRIBUTE, SPLIT_STORAGE );
+
+	const wxString formsDir = GetFormsDirectory( projectFile );
+	const wxString formsDirName = wxFileName( formsDir ).GetFullName();
+	if ( !wxFileName::DirExists( formsDir ) && !wxFileName::Mkdir( formsDir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+	{
+		THROW_WXFBEX( _("Unable to create directory: ") << formsDir )
+	}
+
+	// The forms are serialized as the children of the project, in the same order
+	std::set< wxString > used;
+	TiXmlElement* xmlForm = xmlProject->FirstChildElement( OBJECT_TAG );
+	for ( unsigned int i = 0; i < project->GetChildCount() && xmlForm; ++i )
+	{
+		const wxString fileName = GetFormFileName( project->GetChild( i ), i, used );
+
+		TiXmlDocument formDocument;
+		formDocument.InsertEndChild( *projectDocument->FirstChild() ); // declaration
+		TiXmlElement formRoot( FORM_ROOT_TAG );
+		formRoot.InsertEndChild( *fileVersion );
+		formRoot.InsertEndChild( *xmlForm );
+		formDocument.InsertEndChild( formRoot );
+
+		WriteIfChanged( wxFileName( formsDir, fileName ).GetFullPath(), Print( formDocument ) );
+
+		// The reference is relative to the project, with the same separator on every platform
+		TiXmlElement reference( FORM_TAG );
+		reference.SetAttribute( FILE_TAG, std::string( ( formsDirName + wxT("/") + fileName ).utf8_str() ) );
+
+		TiXmlElement* replaced = xmlForm;
+		xmlForm = xmlForm->NextSiblingElement( OBJECT_TAG );
+		xmlProject->ReplaceChild( replaced, reference );
+	}
+
+	// Files of removed or renamed forms
+	wxArrayString files;
+	wxDir::GetAllFiles( formsDir, &files, wxString( wxT("*.") ) + FORM_EXTENSION, wxDIR_FILES );
+	for ( size_t i = 0; i < files.GetCount(); ++i )
+	{
+		if ( used.find( wxFileName( files[i] ).GetFullName().Lower() ) == used.end() )
+		{
+			wxRemoveFile( files[i] );
+		}
+	}
+
+	WriteIfChanged( projectFile, Print( *projectDocument ) );
+}
@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+@file
+Project layout with each form stored in its own file.
+*/
+
+#ifndef __PROJECT_STORAGE__
+#define __PROJECT_STORAGE__
+
+#include "database.h"
+
+#include <wx/string.h>
+
+namespace ticpp
+{
+	class Document;
+	class Element;
+}
+
+/**
+* Reads and writes projects with the "split_forms" property set.
+*
+* The project file keeps the project properties and a <form file="..."/> element in place of each form,
+* the forms are stored in the directory "<project file name>_forms" next to it, as .fbf files. The root element of the
+* project file has the attribute storage="split", the file version is that of the other projects.
+*/
+namespace ProjectStorage
+{
+	/**
+	* True if the root element of the project document is that of a project with split forms.
+	*/
+	bool IsSplit( ticpp::Element* root );
+
+	/**
+	* Directory of the form files of a project file.
+	*/
+	wxString GetFormsDirectory( const wxString& projectFile );
+
+	/**
+	* Project file owning a form file, empty if the file is not in a forms directory.
+	*/
+	wxString GetProjectOfForm( const wxString& formFile );
+
+	/**
+	* Creates the forms referenced by the serialized project as its children, from their files.
+	* The files are parsed in parallel, throws a wxFBException if any of them can not be read.
+	*/
+	void LoadForms( PObjectDatabase database, ticpp::Element* xmlProject, PObjectBase project, const wxString& projectPath );
+
+	/**
+	* Writes the project file and the form files, each form file only if its contents changed.
+	* The form files of removed forms are deleted. Throws a wxFBException on failure.
+	*/
+	void Save( PObjectBase project, ticpp::Document* document, const wxString& projectFile );
+}
+
+#endif //__PROJECT_STORAGE__
@@ -0,0 +1,430 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "searchindex.h"
+
+#include "objectbase.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+	// Long values (string lists, code) are only indexed up to here
+	const size_t MAX_INDEXED_LENGTH = 1024;
+
+	// Bytes of multibyte UTF-8 characters are letters, they are compared as they are
+	bool IsWordChar( char c )
+	{
+		const unsigned char u = static_cast< unsigned char >( c );
+		return u >= 0x80 || ( u >= '0' && u <= '9' ) || ( u >= 'a' && u <= 'z' ) || ( u >= 'A' && u <= 'Z' );
+	}
+
+	bool IsLower( char c ) { return c >= 'a' && c <= 'z'; }
+	bool IsUpper( char c ) { return c >= 'A' && c <= 'Z'; }
+
+	std::string Lower( const std::string& value, size_t start, size_t end )
+	{
+		std::string lower( value, start, end - start );
+		for ( std::string::iterator c = lower.begin(); c != lower.end(); ++c )
+		{
+			if ( IsUpper( *c ) )
+			{
+				*c = *c - 'A' + 'a';
+			}
+		}
+		return lower;
+	}
+
+	struct SortedMatch
+	{
+		wxString name;
+		wxString field;
+		SearchIndex::Match match;
+	};
+}
+
+SearchIndex::SearchIndex()
+:
+m_generation( 0 ),
+m_built( false ),
+m_stale( false )
+{
+}
+
+void SearchIndex::Tokenize( const std::string& value, bool humps, std::vector< std::string >* tokens )
+{
+	const size_t length = std::min( value.size(), MAX_INDEXED_LENGTH );
+
+	size_t i = 0;
+	while ( i < length )
+	{
+		while ( i < length && !IsWordChar( value[i] ) )
+		{
+			++i;
+		}
+
+		const size_t start = i;
+		while ( i < length && IsWordChar( value[i] ) )
+		{
+			++i;
+		}
+
+		if ( start == i )
+		{
+			break;
+		}
+
+		tokens->push_back( Lower( value, start, i ) );
+
+		if ( humps )
+		{
+			// Each tail of the word starting at a hump is a word too
+			for ( size_t hump = start + 1; hump < i; ++hump )
+			{
+				if ( IsLower( value[ hump - 1 ] ) && IsUpper( value[ hump ] ) )
+				{
+					tokens->push_back( Lower( value, hump, i ) );
+				}
+			}
+		}
+	}
+
+	std::sort( tokens->begin(), tokens->end() );
+	tokens->erase( std::unique( tokens->begin(), tokens->end() ), tokens->end() );
+}
+
+void SearchIndex::CollectFields( PObjectBase obj, FieldVector* fields )
+{
+	Field objClass = { obj->GetObjectInfo().get(), InternedString( obj->GetClassName() ) };
+	fields->push_back( objClass );
+
+	const PropertyMap& properties = obj->GetPropertyMap();
+	for ( PropertyMap::const_iterator it = properties.begin(); it != properties.end(); ++it )
+	{
+		PProperty prop = it->second;
+		if ( !prop->GetInternedValue().empty() && ( it->first == wxT("name") || !prop->IsDefaultValue() ) )
+		{
+			Field field = { prop->GetPropertyInfo().get(), prop->GetInternedValue() };
+			fields->push_back( field );
+		}
+	}
+
+	const EventMap& events = obj->GetEventMap();
+	for ( EventMap::const_iterator it = events.begin(); it != events.end(); ++it )
+	{
+		PEvent event = it->second;
+		if ( !event->GetInternedValue().empty() )
+		{
+			Field field = { event->GetEventInfo().get(), event->GetInternedValue() };
+			fields->push_back( field );
+		}
+	}
+}
+
+void SearchIndex::AddTokens( ObjectBase* obj, const Field& field )
+{
+	std::vector< std::string > tokens;
+	Tokenize( field.value.GetUTF8(), true, &tokens );
+
+	for ( std::vector< std::string >::iterator token = tokens.begin(); token != tokens.end(); ++token )
+	{
+		m_postings[ *token ].insert( Posting( obj, field.info ) );
+	}
+}
+
+void SearchIndex::RemoveTokens( ObjectBase* obj, const Field& field )
+{
+	std::vector< std::string > tokens;
+	Tokenize( field.value.GetUTF8(), true, &tokens );
+
+	for ( std::vector< std::string >::iterator token = tokens.begin(); token != tokens.end(); ++token )
+	{
+		std::map< std::string, PostingSet >::iterator postings = m_postings.find( *token );
+		if ( postings != m_postings.end() )
+		{
+			postings->second.erase( Posting( obj, field.info ) );
+			if ( postings->second.empty() )
+			{
+				m_postings.erase( postings );
+			}
+		}
+	}
+}
+
+void SearchIndex::Index( PObjectBase obj )
+{
+	FieldVector fields;
+	CollectFields( obj, &fields );
+
+	Entry& entry = m_entries[ obj.get() ];
+	entry.object = obj;
+	entry.generation = m_generation;
+
+	// Only the values that changed are tokenized again, the values are interned so comparing them is cheap
+	for ( FieldVector::iterator old = entry.fields.begin(); old != entry.fields.end(); ++old )
+	{
+		bool kept = false;
+		for ( FieldVector::iterator field = fields.begin(); field != fields.end() && !kept; ++field )
+		{
+			kept = ( field->info == old->info && field->value == old->value );
+		}
+
+		if ( !kept )
+		{
+			RemoveTokens( obj.get(), *old );
+		}
+	}
+
+	for ( FieldVector::iterator field = fields.begin(); field != fields.end(); ++field )
+	{
+		bool indexed = false;
+		for ( FieldVector::iterator old = entry.fields.begin(); old != entry.fields.end() && !indexed; ++old )
+		{
+			indexed = ( field->info == old->info && field->value == old->value );
+		}
+
+		if ( !indexed )
+		{
+			AddTokens( obj.get(), *field );
+		}
+	}
+
+	entry.fields.swap( fields );
+}
+
+void SearchIndex::IndexTree( PObjectBase obj )
+{
+	Index( obj );
+
+	for ( unsigned int i = 0; i < obj->GetChildCount(); ++i )
+	{
+		IndexTree( obj->GetChild( i ) );
+	}
+}
+
+void SearchIndex::Unindex( ObjectBase* obj )
+{
+	std::unordered_map< ObjectBase*, Entry >::iterator entry = m_entries.find( obj );
+	if ( entry == m_entries.end() )
+	{
+		return;
+	}
+
+	for ( FieldVector::iterator field = entry->second.fields.begin(); field != entry->second.fields.end(); ++field )
+	{
+		RemoveTokens( obj, *field );
+	}
+
+	m_entries.erase( entry );
+}
+
+void SearchIndex::UnindexTree( PObjectBase obj )
+{
+	Unindex( obj.get() );
+
+	for ( unsigned int i = 0; i < obj->GetChildCount(); ++i )
+	{
+		UnindexTree( obj->GetChild( i ) );
+	}
+}
+
+void SearchIndex::CollectPostings( const std::string& prefix, PostingSet* postings ) const
+{
+	for ( std::map< std::string, PostingSet >::const_iterator it = m_postings.lower_bound( prefix );
+		it != m_postings.end() && 0 == it->first.compare( 0, prefix.size(), prefix ); ++it )
+	{
+		postings->insert( it->second.begin(), it->second.end() );
+	}
+}
+
+void SearchIndex::AddObject( PObjectBase obj )
+{
+	if ( !obj || !m_built || m_stale )
+	{
+		return;
+	}
+
+	// The items holding the object were inserted with it
+	while ( obj->GetParent() && obj->GetParent()->GetObjectInfo()->GetObjectType()->IsItem() )
+	{
+		obj = obj->GetParent();
+	}
+
+	IndexTree( obj );
+}
+
+void SearchIndex::RemoveObject( PObjectBase obj )
+{
+	if ( !obj || !m_built || m_stale )
+	{
+		return;
+	}
+
+	while ( obj->GetParent() && obj->GetParent()->GetObjectInfo()->GetObjectType()->IsItem() )
+	{
+		obj = obj->GetParent();
+	}
+
+	UnindexTree( obj );
+}
+
+void SearchIndex::UpdateProperty( PProperty prop )
+{
+	PObjectBase obj = prop->GetObject();
+	if ( obj && m_built && !m_stale )
+	{
+		Index( obj );
+	}
+}
+
+void SearchIndex::UpdateEvent( PEvent event )
+{
+	PObjectBase obj = event->GetObject();
+	if ( obj && m_built && !m_stale )
+	{
+		Index( obj );
+	}
+}
+
+void SearchIndex::Invalidate()
+{
+	m_stale = true;
+}
+
+SearchIndex::MatchVector SearchIndex::Search( PObjectBase project, const wxString& query, size_t maxMatches )
+{
+	MatchVector matches;
+	if ( !project )
+	{
+		return matches;
+	}
+
+	if ( !m_built || m_stale )
+	{
+		// Objects not found in the tree any more are dropped
+		++m_generation;
+		IndexTree( project );
+
+		for ( std::unordered_map< ObjectBase*, Entry >::iterator entry = m_entries.begin(); entry != m_entries.end(); )
+		{
+			if ( entry->second.generation != m_generation )
+			{
+				for ( FieldVector::iterator field = entry->second.fields.begin(); field != entry->second.fields.end(); ++field )
+				{
+					RemoveTokens( entry->first, *field );
+				}
+				entry = m_entries.erase( entry );
+			}
+			else
+			{
+				++entry;
+			}
+		}
+
+		m_built = true;
+		m_stale = false;
+	}
+
+	std::vector< std::string > words;
+	Tokenize( std::string( query.utf8_str() ), false, &words );
+	if ( words.empty() )
+	{
+		return matches;
+	}
+
+	PostingSet postings;
+	CollectPostings( words[0], &postings );
+	for ( size_t i = 1; i < words.size() && !postings.empty(); ++i )
+	{
+		PostingSet wordPostings;
+		CollectPostings( words[i], &wordPostings );
+
+		PostingSet both;
+		std::set_intersection( postings.begin(), postings.end(), wordPostings.begin(), wordPostings.end(),
+			std::inserter( both, both.end() ) );
+		postings.swap( both );
+	}
+
+	std::vector< SortedMatch > sorted;
+	sorted.reserve( postings.size() );
+	for ( PostingSet::iterator posting = postings.begin(); posting != postings.end(); ++posting )
+	{
+		std::unordered_map< ObjectBase*, Entry >::iterator entry = m_entries.find( posting->first );
+		if ( entry == m_entries.end() )
+		{
+			continue;
+		}
+
+		SortedMatch found;
+		found.match.object = entry->second.object.lock();
+		if ( !found.match.object )
+		{
+			continue;
+		}
+
+		if ( posting->second != found.match.object->GetObjectInfo().get() )
+		{
+			const PropertyMap& properties = found.match.object->GetPropertyMap();
+			for ( PropertyMap::const_iterator it = properties.begin(); it != properties.end() && !found.match.property; ++it )
+			{
+				if ( it->second->GetPropertyInfo().get() == posting->second )
+				{
+					found.match.property = it->second;
+					found.field = it->first;
+				}
+			}
+
+			const EventMap& events = found.match.object->GetEventMap();
+			for ( EventMap::const_iterator it = events.begin(); it != events.end() && !found.match.property && !found.match.event; ++it )
+			{
+				if ( it->second->GetEventInfo().get() == posting->second )
+				{
+					found.match.event = it->second;
+					found.field = it->first;
+				}
+			}
+
+			if ( !found.match.property && !found.match.event )
+			{
+				continue;
+			}
+		}
+
+		found.name = found.match.object->GetPropertyAsString( wxT("name") );
+		sorted.push_back( found );
+	}
+
+	std::sort( sorted.begin(), sorted.end(), []( const SortedMatch& a, const SortedMatch& b )
+	{
+		const int byName = a.name.CmpNoCase( b.name );
+		return ( byName != 0 ? byName < 0 : a.field < b.field );
+	} );
+
+	const size_t count = std::min( sorted.size(), maxMatches );
+	matches.reserve( count );
+	for ( size_t i = 0; i < count; ++i )
+	{
+		matches.push_back( sorted[i].match );
+	}
+
+	return matches;
+}
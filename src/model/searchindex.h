@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+@file
+Inverted index of the words of a project, for the project search.
+*/
+
+#ifndef __SEARCH_INDEX__
+#define __SEARCH_INDEX__
+
+#include "../utils/internedstring.h"
+#include "../utils/wxfbdefs.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+/**
+* Maps the words of the class names, property values and event handlers of the objects to the objects.
+*
+* The index is owned by ApplicationData and kept up to date from the same changes it notifies. Changes notified
+* without the objects involved (undo, paste, ...) only mark it as stale, it is then brought up to date before the
+* next search, reindexing only the objects whose values changed. Nothing is indexed until the first search.
+*
+* The properties with their default value are not indexed, except the names, so the most common values do not
+* fill the index.
+*/
+class SearchIndex
+{
+public:
+	/**
+	* An object with a value matching the search, that of its class if both the property and the event are empty.
+	*/
+	struct Match
+	{
+		PObjectBase object;
+		PProperty property;
+		PEvent event;
+	};
+
+	typedef std::vector< Match > MatchVector;
+
+private:
+	// A value of an object, identified by the descriptor of the property, the event or the class
+	struct Field
+	{
+		const void* info;
+		InternedString value;
+	};
+
+	typedef std::vector< Field > FieldVector;
+
+	struct Entry
+	{
+		WPObjectBase object;
+		FieldVector fields;
+		unsigned int generation;
+	};
+
+	typedef std::pair< ObjectBase*, const void* > Posting;
+	typedef std::set< Posting > PostingSet;
+
+	std::map< std::string, PostingSet > m_postings;
+	std::unordered_map< ObjectBase*, Entry > m_entries;
+
+	unsigned int m_generation;
+	bool m_built;
+	bool m_stale;
+
+	static void Tokenize( const std::string& value, bool humps, std::vector< std::string >* tokens );
+	static void CollectFields( PObjectBase obj, FieldVector* fields );
+
+	void AddTokens( ObjectBase* obj, const Field& field );
+	void RemoveTokens( ObjectBase* obj, const Field& field );
+
+	void Index( PObjectBase obj );
+	void IndexTree( PObjectBase obj );
+	void Unindex( ObjectBase* obj );
+	void UnindexTree( PObjectBase obj );
+
+	void CollectPostings( const std::string& prefix, PostingSet* postings ) const;
+
+public:
+	SearchIndex();
+
+	/**
+	* Indexes an object and its children, after they have been inserted.
+	*/
+	void AddObject( PObjectBase obj );
+
+	/**
+	* Drops an object and its children, after they have been removed.
+	*/
+	void RemoveObject( PObjectBase obj );
+
+	/**
+	* Reindexes the object of a property or event after its value changed.
+	*/
+	void UpdateProperty( PProperty prop );
+	void UpdateEvent( PEvent event );
+
+	/**
+	* The tree changed in an unknown way, the index is checked against it on the next search.
+	*/
+	void Invalidate();
+
+	/**
+	* Gets the values of the project where each word of the query starts a word, ignoring case.
+	*
+	* The words of the values are split at anything but letters and digits, and at the humps of the camel case,
+	* so "click" finds "OnButtonClick". The matches are sorted by the names of the objects.
+	*/
+	MatchVector Search( PObjectBase project, const wxString& query, size_t maxMatches );
+
+	/**
+	* Sizes of the index, for the memory report.
+	*/
+	size_t GetObjectCount() const { return m_entries.size(); }
+	size_t GetWordCount() const { return m_postings.size(); }
+};
+
+#endif //__SEARCH_INDEX__
@@ -26,9 +26,89 @@
 #include "xrcfilter.h"
 
 #include "../utils/debug.h"
+#include "../utils/fileutils.h"
+#include "../utils/stringutils.h"
 #include "../utils/typeconv.h"
+#include "../utils/wxfbexception.h"
 #include "objectbase.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <memory>
+
+namespace
+{
+	// Position after the markup starting at pos, skipping the quoted attribute values, npos if it is not closed
+	size_t FindMarkupEnd( const std::string& xml, size_t pos )
+	{
+		const char* terminator = NULL;
+		if ( 0 == xml.compare( pos, 4, "<!--" ) )
+		{
+			terminator = "-->";
+		}
+		else if ( 0 == xml.compare( pos, 9, "<![CDATA[" ) )
+		{
+			terminator = "]]>";
+		}
+		else if ( 0 == xml.compare( pos, 2, "<?" ) )
+		{
+			terminator = "?>";
+		}
+
+		if ( terminator )
+		{
+			const size_t end = xml.find( terminator, pos + 2 );
+			return ( end == std::string::npos ? end : end + strlen( terminator ) );
+		}
+
+		char quote = 0;
+		for ( size_t i = pos + 1; i < xml.size(); ++i )
+		{
+			if ( quote )
+			{
+				quote = ( xml[i] == quote ? 0 : quote );
+			}
+			else if ( xml[i] == '"' || xml[i] == '\'' )
+			{
+				quote = xml[i];
+			}
+			else if ( xml[i] == '>' )
+			{
+				return i + 1;
+			}
+		}
+		return std::string::npos;
+	}
+
+	bool IsTag( const std::string& xml, size_t pos, const std::string& name )
+	{
+		const size_t end = pos + 1 + name.size();
+		return 0 == xml.compare( pos + 1, name.size(), name ) && end < xml.size() &&
+			( xml[ end ] == '>' || xml[ end ] == '/' || isspace( static_cast< unsigned char >( xml[ end ] ) ) );
+	}
+
+	// Only UTF-8 files are streamed, the others go through XMLUtils::LoadXMLFile, which converts them
+	bool IsUTF8( const std::string& xml )
+	{
+		if ( 0 != xml.compare( 0, 5, "<?xml" ) )
+		{
+			return false;
+		}
+
+		std::string declaration = xml.substr( 0, FindMarkupEnd( xml, 0 ) );
+		std::transform( declaration.begin(), declaration.end(), declaration.begin(), ::tolower );
+		return declaration.find( "encoding=\"utf-8\"" ) != std::string::npos ||
+			declaration.find( "encoding='utf-8'" ) != std::string::npos;
+	}
+}
+
+XrcLoader::XrcLoader()
+:
+m_rowOffset( 0 )
+{
+}
+
 PObjectBase XrcLoader::GetProject( ticpp::Document* xrcDoc )
 {
 	assert( m_objDb );
@@ -54,6 +134,124 @@ PObjectBase XrcLoader::GetProject( ticpp::Document* xrcDoc )
 	return project;
 }
 
+PObjectBase XrcLoader::GetProject( const wxString& path )
+{
+	assert( m_objDb );
+
+	std::string xml;
+	if ( !FileUtils::ReadFile( path, &xml ) )
+	{
+		THROW_WXFBEX( _("Unable to read file: ") << path )
+	}
+
+	if ( !IsUTF8( xml ) )
+	{
+		ticpp::Document doc;
+		XMLUtils::LoadXMLFile( doc, false, path );
+		return GetProject( &doc );
+	}
+
+	PObjectBase project( m_objDb->CreateObject( "Project" ) );
+	TiXmlBase::SetCondenseWhiteSpace( false );
+
+	// The root is the first element
+	size_t pos = xml.find( '<' );
+	size_t end = std::string::npos;
+	while ( pos != std::string::npos && ( end = FindMarkupEnd( xml, pos ) ) != std::string::npos &&
+		( xml[ pos + 1 ] == '?' || xml[ pos + 1 ] == '!' ) )
+	{
+		pos = xml.find( '<', end );
+	}
+
+	if ( pos == std::string::npos || end == std::string::npos || !IsTag( xml, pos, "resource" ) )
+	{
+		wxLogError( _( "Missing root element \"resource\"" ) );
+		return project;
+	}
+
+	if ( xml[ end - 2 ] == '/' )
+	{
+		return project;
+	}
+
+	// Each object of the resource is parsed and imported on its own, the document is never held as a whole
+	unsigned int depth = 0;
+	size_t objectStart = std::string::npos;
+	size_t counted = 0;
+	m_rowOffset = 0;
+	for ( pos = xml.find( '<', end ); pos != std::string::npos; pos = xml.find( '<', end ) )
+	{
+		end = FindMarkupEnd( xml, pos );
+		if ( end == std::string::npos )
+		{
+			wxLogError( _("Unterminated markup at line %i"), m_rowOffset + (int)std::count( xml.begin() + counted, xml.begin() + pos, '\n' ) + 1 );
+			break;
+		}
+
+		if ( xml[ pos + 1 ] == '?' || xml[ pos + 1 ] == '!' )
+		{
+			continue;
+		}
+
+		size_t objectEnd = std::string::npos;
+		if ( xml[ pos + 1 ] == '/' )
+		{
+			if ( 0 == depth )
+			{
+				// End of the resource
+				break;
+			}
+
+			if ( 0 == --depth )
+			{
+				objectEnd = end;
+			}
+		}
+		else
+		{
+			if ( 0 == depth && IsTag( xml, pos, "object" ) )
+			{
+				objectStart = pos;
+			}
+
+			if ( xml[ end - 2 ] != '/' )
+			{
+				++depth;
+			}
+			else if ( 0 == depth )
+			{
+				objectEnd = end;
+			}
+		}
+
+		if ( objectEnd == std::string::npos || objectStart == std::string::npos )
+		{
+			continue;
+		}
+
+		// The rows of the elements are relative to the object
+		m_rowOffset += (int)std::count( xml.begin() + counted, xml.begin() + objectStart, '\n' );
+		counted = objectStart;
+
+		TiXmlDocument doc;
+		doc.Parse( xml.substr( objectStart, objectEnd - objectStart ).c_str(), NULL, TIXML_ENCODING_UTF8 );
+		if ( doc.Error() || !doc.RootElement() )
+		{
+			wxLogError( _("Unable to parse the object found on line %i: %s"), m_rowOffset + doc.ErrorRow(), _WXSTR( doc.ErrorDesc() ).c_str() );
+		}
+		else
+		{
+			ticpp::Element element( doc.RootElement() );
+			GetObject( &element, project );
+		}
+
+		objectStart = std::string::npos;
+	}
+
+	m_rowOffset = 0;
+	return project;
+}
+
 PObjectBase XrcLoader::GetObject( ticpp::Element *xrcObj, PObjectBase parent )
 {
 	// First, create the object by the name, the modify the properties
@@ -131,18 +329,19 @@ PObjectBase XrcLoader::GetObject( ticpp::Element *xrcObj, PObjectBase parent )
 		IComponent *comp = objInfo->GetComponent();
 		if ( !comp )
 		{
-			wxLogError( _("No component found for class \"%s\", found on line %i."), _WXSTR( className ).c_str(), xrcObj->Row() );
+			wxLogError( _("No component found for class \"%s\", found on line %i."), _WXSTR( className ).c_str(), xrcObj->Row() + m_rowOffset );
 		}
 		else
 		{
-			ticpp::Element *fbObj = comp->ImportFromXrc( xrcObj );
+			// The converted element is only needed to create the object
+			std::unique_ptr< ticpp::Element > fbObj( comp->ImportFromXrc( xrcObj ) );
 			if ( !fbObj )
 			{
-				wxLogError( _("ImportFromXrc returned NULL for class \"%s\", found on line %i."), _WXSTR( className ).c_str(), xrcObj->Row() );
+				wxLogError( _("ImportFromXrc returned NULL for class \"%s\", found on line %i."), _WXSTR( className ).c_str(), xrcObj->Row() + m_rowOffset );
 			}
 			else
 			{
-				object = m_objDb->CreateObject( fbObj, parent );
+				object = m_objDb->CreateObject( fbObj.get(), parent );
 				if ( !object )
 				{
 					// Unable to create the object and add it to the parent - probably needs a sizer
@@ -159,7 +358,7 @@ PObjectBase XrcLoader::GetObject( ticpp::Element *xrcObj, PObjectBase parent )
 
 						if ( sizer )
 						{
-							object = m_objDb->CreateObject( fbObj, sizer );
+							object = m_objDb->CreateObject( fbObj.get(), sizer );
 							if ( object )
 							{
 								parent->AddChild( newsizer );
@@ -171,7 +370,7 @@ PObjectBase XrcLoader::GetObject( ticpp::Element *xrcObj, PObjectBase parent )
 
 				if ( !object )
 				{
-					wxLogError( wxT( "CreateObject failed for class \"%s\", with parent \"%s\", found on line %i" ), _WXSTR( className ).c_str(), parent->GetClassName().c_str(), xrcObj->Row() );
+					wxLogError( wxT( "CreateObject failed for class \"%s\", with parent \"%s\", found on line %i" ), _WXSTR( className ).c_str(), parent->GetClassName().c_str(), xrcObj->Row() + m_rowOffset );
 				}
 				else
 				{
@@ -202,13 +401,13 @@ PObjectBase XrcLoader::GetObject( ticpp::Element *xrcObj, PObjectBase parent )
 		{
 			parent->AddChild( object );
 			object->SetParent( parent );
-			wxLogError( wxT( "Unknown class \"%s\" found on line %i, replaced with a wxPanel" ), _WXSTR( className ).c_str(), xrcObj->Row() );
+			wxLogError( wxT( "Unknown class \"%s\" found on line %i, replaced with a wxPanel" ), _WXSTR( className ).c_str(), xrcObj->Row() + m_rowOffset );
 		}
 		else
 		{
 			wxString msg( wxString::Format(
 			                  wxT( "Unknown class \"%s\" found on line %i, and could not replace with a wxPanel as child of \"%s:%s\"" ),
-			                  _WXSTR( className ).c_str(), xrcObj->Row(), parent->GetPropertyAsString( wxT( "name" ) ).c_str(), parent->GetClassName().c_str() ) );
+			                  _WXSTR( className ).c_str(), xrcObj->Row() + m_rowOffset, parent->GetPropertyAsString( wxT( "name" ) ).c_str(), parent->GetClassName().c_str() ) );
 
 			wxLogError( msg );
 		}
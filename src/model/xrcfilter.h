@@ -38,9 +38,13 @@ class XrcLoader
  private:
   PObjectDatabase m_objDb;
 
+  // Added to the rows of the elements in the messages, when they are parsed apart from the file
+  int m_rowOffset;
+
   PObjectBase GetObject(ticpp::Element *xrcObj, PObjectBase parent);
 
  public:
+  XrcLoader();
 
   void SetObjectDatabase(PObjectDatabase db) { m_objDb = db; }
 
@@ -48,6 +52,14 @@ class XrcLoader
    * Dado un árbol XML en formato XRC, crea el arbol de objetos asociado.
    */
   PObjectBase GetProject(ticpp::Document* xrcDoc);
+
+  /**
+   * Imports the XRC file one object of the resource at a time. The text of the file is read at once, but
+   * only the DOM of the current object is built, instead of the DOM of the whole file. Files not in UTF-8
+   * are loaded with XMLUtils::LoadXMLFile, which converts them. Throws a wxFBException if the file cannot
+   * be read.
+   */
+  PObjectBase GetProject(const wxString& path);
 };
 
 #endif //__XRC_FILTER__
@@ -34,12 +34,18 @@
 #include "../codegen/luacg.h"
 #include "../codegen/phpcg.h"
 #include "../codegen/pythoncg.h"
+#include "../model/binaryproject.h"
 #include "../model/objectbase.h"
+#include "../model/projectstorage.h"
+#include "../model/searchindex.h"
+#include "../utils/parallel.h"
 #include "../utils/stringutils.h"
 #include "../utils/typeconv.h"
 #include "../utils/wxfbexception.h"
 #include "../utils/wxfbipc.h"
 #include "dataobject/dataobject.h"
+#include "geninheritclass/geninhertclass.h"
+#include "memoryreport.h"
 #include "xrcpreview/xrcpreview.h"
 
 #include <ticpp.h>
@@ -51,6 +57,10 @@
 #include <wx/fs_mem.h>
 #include <wx/tokenzr.h>
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
 using namespace TypeConv;
 
 
@@ -96,6 +106,7 @@ class InsertObjectCmd : public Command
 
 	public:
 		InsertObjectCmd( ApplicationData *data, PObjectBase object, PObjectBase parent, int pos = -1 );
+		size_t GetMemorySize() const override;
 };
 
 /**
@@ -118,6 +129,7 @@ class RemoveObjectCmd : public Command
 
 	public:
 		RemoveObjectCmd( ApplicationData *data, PObjectBase object );
+		size_t GetMemorySize() const override;
 };
 
 /**
@@ -137,6 +149,7 @@ class ModifyPropertyCmd : public Command
 
 	public:
 		ModifyPropertyCmd( PProperty prop, wxString value );
+		size_t GetMemorySize() const override;
 };
 
 /**
@@ -156,6 +169,7 @@ class ModifyEventHandlerCmd : public Command
 
 	public:
 		ModifyEventHandlerCmd( PEvent event, wxString value );
+		size_t GetMemorySize() const override;
 };
 
 /**
@@ -201,6 +215,7 @@ class CutObjectCmd : public Command
 
 	public:
 		CutObjectCmd( ApplicationData *data, PObjectBase object );
+		size_t GetMemorySize() const override;
 };
 
 /**
@@ -224,6 +239,29 @@ class ReparentObjectCmd : public Command
 		ReparentObjectCmd ( PObjectBase sizeritem, PObjectBase sizer );
 };
 
+/**
+* Inserts several copies of an object next to each other, undone at once.
+*/
+
+class DuplicateObjectCmd : public Command
+{
+
+	private:
+		ApplicationData *m_data;
+		PObjectBase m_parent;
+		std::vector< PObjectBase > m_objects;
+		unsigned int m_pos;
+		PObjectBase m_oldSelected;
+
+	protected:
+		void DoExecute() override;
+		void DoRestore() override;
+
+	public:
+		DuplicateObjectCmd( ApplicationData *data, const std::vector< PObjectBase >& objects, PObjectBase parent, unsigned int pos );
+		size_t GetMemorySize() const override;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // Implementación de los Comandos
 ///////////////////////////////////////////////////////////////////////////////
@@ -275,6 +313,12 @@ void InsertObjectCmd::DoRestore()
 	m_data->SelectObject( m_oldSelected );
 }
 
+size_t InsertObjectCmd::GetMemorySize() const
+{
+	// Once undone, the command is all that keeps the object
+	return ( m_object->GetParent() ? 0 : MemoryReport::GetTreeSize( m_object ) );
+}
+
 //-----------------------------------------------------------------------------
 
 RemoveObjectCmd::RemoveObjectCmd( ApplicationData *data, PObjectBase object )
@@ -303,6 +347,11 @@ void RemoveObjectCmd::DoRestore()
 	m_data->SelectObject( m_oldSelected, true, false );
 }
 
+size_t RemoveObjectCmd::GetMemorySize() const
+{
+	return ( m_object->GetParent() ? 0 : MemoryReport::GetTreeSize( m_object ) );
+}
+
 //-----------------------------------------------------------------------------
 
 ModifyPropertyCmd::ModifyPropertyCmd( PProperty prop, wxString value )
@@ -321,6 +370,12 @@ void ModifyPropertyCmd::DoRestore()
 	m_property->SetValue( m_oldValue );
 }
 
+size_t ModifyPropertyCmd::GetMemorySize() const
+{
+	// The buffers, allocated with their capacity and stored in the internal character type
+	return ( m_oldValue.capacity() + m_newValue.capacity() ) * sizeof( wxStringCharType );
+}
+
 //-----------------------------------------------------------------------------
 
 ModifyEventHandlerCmd::ModifyEventHandlerCmd( PEvent event, wxString value )
@@ -339,6 +394,11 @@ void ModifyEventHandlerCmd::DoRestore()
 	m_event->SetValue( m_oldValue );
 }
 
+size_t ModifyEventHandlerCmd::GetMemorySize() const
+{
+	return ( m_oldValue.capacity() + m_newValue.capacity() ) * sizeof( wxStringCharType );
+}
+
 //-----------------------------------------------------------------------------
 
 ShiftChildCmd::ShiftChildCmd( PObjectBase object, int pos )
@@ -407,6 +467,11 @@ void CutObjectCmd::DoRestore()
 	m_data->SelectObject( m_oldSelected, true, false );
 }
 
+size_t CutObjectCmd::GetMemorySize() const
+{
+	return ( m_object->GetParent() ? 0 : MemoryReport::GetTreeSize( m_object ) );
+}
+
 //-----------------------------------------------------------------------------
 
 ReparentObjectCmd ::ReparentObjectCmd ( PObjectBase sizeritem, PObjectBase sizer )
@@ -432,6 +497,58 @@ void ReparentObjectCmd::DoRestore()
 	m_oldSizer->ChangeChildPosition( m_sizeritem, m_oldPosition);
 }
 
+//-----------------------------------------------------------------------------
+
+DuplicateObjectCmd::DuplicateObjectCmd( ApplicationData *data, const std::vector< PObjectBase >& objects,
+                                        PObjectBase parent, unsigned int pos )
+		: m_data( data ), m_parent( parent ), m_objects( objects ), m_pos( pos )
+{
+	m_oldSelected = data->GetSelectedObject();
+}
+
+void DuplicateObjectCmd::DoExecute()
+{
+	for ( size_t i = 0; i < m_objects.size(); i++ )
+	{
+		m_parent->AddChild( m_pos + (unsigned int)i, m_objects[i] );
+		m_objects[i]->SetParent( m_parent );
+	}
+
+	// Select the last copy
+	PObjectBase obj = m_objects.back();
+	while ( obj && obj->GetObjectInfo()->GetObjectType()->IsItem() )
+	{
+		if ( obj->GetChildCount() > 0 )
+			obj = obj->GetChild( 0 );
+		else
+			return;
+	}
+	m_data->SelectObject( obj, false, false );
+}
+
+void DuplicateObjectCmd::DoRestore()
+{
+	for ( std::vector< PObjectBase >::iterator obj = m_objects.begin(); obj != m_objects.end(); ++obj )
+	{
+		m_parent->RemoveChild( *obj );
+		( *obj )->SetParent( PObjectBase() );
+	}
+	m_data->SelectObject( m_oldSelected );
+}
+
+size_t DuplicateObjectCmd::GetMemorySize() const
+{
+	size_t size = 0;
+	for ( std::vector< PObjectBase >::const_iterator object = m_objects.begin(); object != m_objects.end(); ++object )
+	{
+		if ( !( *object )->GetParent() )
+		{
+			size += MemoryReport::GetTreeSize( *object );
+		}
+	}
+	return size;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // ApplicationData
 ///////////////////////////////////////////////////////////////////////////////
@@ -468,6 +585,8 @@ ApplicationData::ApplicationData( const wxString &rootdir )
 		m_objDb( new ObjectDatabase() ),
 		m_manager( new wxFBManager ),
 		m_ipc( new wxFBIPC ),
+		m_codeAnalysis( new CodeAnalysis ),
+		m_searchIndex( new SearchIndex ),
 		m_fbpVerMajor( 1 ),
 		m_fbpVerMinor(15)
 {
@@ -622,6 +741,46 @@ void ApplicationData::ResolveSubtreeNameConflicts( PObjectBase obj, PObjectBase
 		ResolveSubtreeNameConflicts( obj->GetChild( i ), topObj );
 }
 
+void ApplicationData::AllocateSubtreeNames( PObjectBase obj, std::set< wxString >& name_set, std::map< wxString, int >& suffixes )
+{
+	// Ignore item objects
+	while ( obj && obj->GetObjectInfo()->GetObjectType()->IsItem() )
+	{
+		if ( obj->GetChildCount() > 0 )
+			obj = obj->GetChild( 0 );
+		else
+			return;
+	}
+
+	PProperty nameProp = obj->GetProperty( wxT( "name" ) );
+
+	if ( nameProp )
+	{
+		// Same naming as ResolveNameConflict, but the numbering of each name continues from the last copy
+		const wxString originalName = nameProp->GetValue();
+		wxString name = originalName;
+
+		if ( name_set.find( name ) != name_set.end() )
+		{
+			int& i = suffixes[ originalName ];
+
+			do
+			{
+				i++;
+				name = wxString::Format( wxT( "%s%i" ), originalName.c_str(), i );
+			}
+			while ( name_set.find( name ) != name_set.end() );
+
+			nameProp->SetValue( name );
+		}
+
+		name_set.insert( name );
+	}
+
+	for ( unsigned int i = 0 ; i < obj->GetChildCount() ; i++ )
+		AllocateSubtreeNames( obj->GetChild( i ), name_set, suffixes );
+}
+
 int ApplicationData::CalcPositionOfInsertion( PObjectBase selected, PObjectBase parent )
 {
 	int pos = -1;
@@ -920,7 +1079,7 @@ bool ApplicationData::PasteObjectFromClipboard( PObjectBase parent )
         }
 	}
 
-    if ( wxTheClipboard->IsSupported( wxFBDataObjectFormat ) )
+    if ( wxTheClipboard->IsSupported( wxFBBinaryDataObjectFormat ) || wxTheClipboard->IsSupported( wxFBDataObjectFormat ) )
     {
         wxFBDataObject data;
         if ( wxTheClipboard->GetData( data ) )
@@ -950,7 +1109,7 @@ bool ApplicationData::CanPasteObjectFromClipboard()
         }
 	}
 
-	bool canPaste = wxTheClipboard->IsSupported( wxFBDataObjectFormat );
+	bool canPaste = wxTheClipboard->IsSupported( wxFBBinaryDataObjectFormat ) || wxTheClipboard->IsSupported( wxFBDataObjectFormat );
 
 	if( wxTheClipboard->IsOpened() )
 		wxTheClipboard->Close();
@@ -970,6 +1129,104 @@ void ApplicationData::CopyObject( PObjectBase obj )
 	CheckProjectTree( m_project );
 }
 
+bool ApplicationData::DuplicateObject( PObjectBase obj, unsigned int count )
+{
+	if ( !obj || count == 0 )
+	{
+		return false;
+	}
+
+	try
+	{
+		// The item holding the object is duplicated too, with the layout
+		PObjectBase source = obj;
+		PObjectBase parent = source->GetParent();
+
+		while ( parent && parent->GetObjectInfo()->GetObjectType()->IsItem() )
+		{
+			source = parent;
+			parent = source->GetParent();
+		}
+
+		if ( !parent )
+		{
+			return false;
+		}
+
+		// Check the number of children of this type allowed
+		PObjectType parentType = parent->GetObjectInfo()->GetObjectType();
+		PObjectType sourceType = source->GetObjectInfo()->GetObjectType();
+
+		bool aui = false;
+		if ( parentType->GetName() == wxT( "form" ) )
+		{
+			aui = parent->GetPropertyAsInteger( wxT( "aui_managed" ) ) != 0;
+		}
+
+		int max = parentType->FindChildType( sourceType, aui );
+		if ( max > 0 )
+		{
+			unsigned int siblings = 0;
+			for ( unsigned int i = 0; i < parent->GetChildCount(); i++ )
+			{
+				if ( parent->GetChild( i )->GetObjectInfo()->GetObjectType() == sourceType )
+					siblings++;
+			}
+
+			if ( siblings + count > (unsigned int)max )
+			{
+				wxLogError( _( "%s can not have more than %i children of type %s" ),
+					parent->GetClassName().c_str(), max, sourceType->GetName().c_str() );
+				return false;
+			}
+		}
+
+		// The names are unique within the form, the set is built once for all the copies
+		PObjectBase top = source->FindParentForm();
+
+		if ( !top )
+			top = m_project; // the object is a form
+
+		std::set< wxString > name_set;
+		BuildNameSet( PObjectBase(), top, name_set );
+		std::map< wxString, int > suffixes;
+
+		std::vector< PObjectBase > copies;
+		copies.reserve( count );
+
+		for ( unsigned int i = 0; i < count; i++ )
+		{
+			PObjectBase copy = m_objDb->CopyObject( source );
+			AllocateSubtreeNames( copy, name_set, suffixes );
+			copies.push_back( copy );
+		}
+
+		PCommand command( new DuplicateObjectCmd( this, copies, parent, parent->GetChildPosition( source ) + 1 ) );
+
+		Execute( command );
+
+		NotifyProjectRefresh();
+
+		PObjectBase selected = copies.back();
+		while ( selected && selected->GetObjectInfo()->GetObjectType()->IsItem() )
+		{
+			assert( selected->GetChildCount() > 0 );
+			selected = selected->GetChild( 0 );
+		}
+
+		SelectObject( selected, true, true );
+
+		CheckProjectTree( m_project );
+	}
+	catch ( wxFBException& ex )
+	{
+		wxLogError( ex.what() );
+		return false;
+	}
+
+	return true;
+}
+
 bool ApplicationData::PasteObject( PObjectBase parent, PObjectBase objToPaste )
 {
 	try
@@ -1222,17 +1479,44 @@ void ApplicationData::SaveProject( const wxString& filename )
 		return;
 	}
 
+	// Keep the original of a converted project
+	if ( !m_convertedProjectFile.empty() && filename == m_convertedProjectFile && ::wxFileExists( filename ) )
+	{
+		::wxCopyFile( filename, filename + wxT( ".bak" ) );
+	}
+
+	WriteProject( filename );
+
+	// Only once written, so the backup is made again if the write fails
+	m_convertedProjectFile.clear();
+	m_projectFile = filename;
+	SetProjectPath( ::wxPathOnly( filename ) );
+	m_modFlag = false;
+	m_cmdProc.SetSavePoint();
+	NotifyProjectSaved();
+}
+
+void ApplicationData::WriteProject( const wxString& filename )
+{
+	if ( BinaryProject::HasBinaryExtension( filename ) )
+	{
+		BinaryProject::Write( m_project, filename, m_fbpVerMajor, m_fbpVerMinor );
+		return;
+	}
+
 	try
 	{
 		ticpp::Document doc;
 		m_project->Serialize( &doc );
-		doc.SaveFile( std::string( filename.mb_str( wxConvFile ) ) );
 
-		m_projectFile = filename;
-		SetProjectPath( ::wxPathOnly( filename ) );
-		m_modFlag = false;
-		m_cmdProc.SetSavePoint();
-		NotifyProjectSaved();
+		if ( m_project->GetPropertyAsInteger( wxT( "split_forms" ) ) != 0 )
+		{
+			ProjectStorage::Save( m_project, &doc, filename );
+		}
+		else
+		{
+			doc.SaveFile( std::string( filename.mb_str( wxConvFile ) ) );
+		}
 	}
 	catch ( ticpp::Exception& ex )
 	{
@@ -1269,41 +1553,49 @@ bool ApplicationData::LoadProject( const wxString &file, bool justGenerate )
 	try
 	{
 		ticpp::Document doc;
-		XMLUtils::LoadXMLFile( doc, false, file );
-
-		ticpp::Element* root = doc.FirstChildElement();
-
-		m_objDb->ResetObjectCounters();
-
-		int fbpVerMajor = 0;
-		int fbpVerMinor = 0;
-
-		if ( root->Value() != std::string( "object" ) )
+		if ( BinaryProject::IsBinaryFile( file ) )
 		{
 			try
 			{
-				ticpp::Element* fileVersion = root->FirstChildElement( "FileVersion" );
-				fileVersion->GetAttributeOrDefault( "major", &fbpVerMajor, 0 );
-				fileVersion->GetAttributeOrDefault( "minor", &fbpVerMinor, 0 );
+				int fileMajor = 0;
+				int fileMinor = 0;
+				BinaryProject::ReadVersion( file, &fileMajor, &fileMinor );
+
+				if ( fileMajor == m_fbpVerMajor && fileMinor == m_fbpVerMinor )
+				{
+					m_objDb->ResetObjectCounters();
+					m_objDb->ResetArena();
+
+					PObjectBase proj = BinaryProject::Read( m_objDb, file, m_fbpVerMajor, m_fbpVerMinor );
+					SetLoadedProject( proj, file );
+					return true;
+				}
+
+				// The other versions are checked and converted as the XML projects
+				BinaryProject::ReadXml( file, doc.GetTiXmlPointer() );
 			}
-			catch( ticpp::Exception& )
+			catch ( wxFBException& ex )
 			{
+				wxLogError( ex.what() );
+				return false;
 			}
 		}
+		else
+		{
+			XMLUtils::LoadXMLFile( doc, false, file );
+		}
+
+		ticpp::Element* root = doc.FirstChildElement();
+
+		m_objDb->ResetObjectCounters();
+		m_objDb->ResetArena();
 
+		int fbpVerMajor = 0;
+		int fbpVerMinor = 0;
 		bool older = false;
 		bool newer = false;
 
-		if ( m_fbpVerMajor == fbpVerMajor )
-		{
-			older = ( fbpVerMinor < m_fbpVerMinor );
-			newer = ( fbpVerMinor > m_fbpVerMinor );
-		}
-		else
-		{
-			older = ( fbpVerMajor < m_fbpVerMajor );
-			newer = ( fbpVerMajor > m_fbpVerMajor );
-		}
+		CompareFileVersion( root, &fbpVerMajor, &fbpVerMinor, &older, &newer );
 
 		if ( newer )
 		{
@@ -1319,24 +1611,24 @@ bool ApplicationData::LoadProject( const wxString &file, bool justGenerate )
 
 		if ( older )
 		{
-			if( justGenerate ){
-				wxLogError( wxT( "This project file is out of date.  Update your .fbp before using --generate" ) );
+			if ( ProjectStorage::IsSplit( root ) )
+			{
+				wxLogError( wxT( "This project file is out of date, and its forms are stored in separate files.\n" )
+				            wxT( "It can only be converted as a single project file." ) );
 				return false;
 			}
-			if ( wxYES == wxMessageBox( wxT( "This project file is not of the current version.\n" )
+
+			// The document is converted as loaded, the file is only written when the project is saved
+			if ( justGenerate || wxYES == wxMessageBox( wxT( "This project file is not of the current version.\n" )
 			                            wxT( "Would you to attempt automatic conversion?\n\n" )
-			                            wxT( "NOTE: This will modify your project file on disk!" ), _( "Old Version" ), wxYES_NO ) )
+			                            wxT( "NOTE: The converted project replaces your project file on disk when saved, a backup is kept as .bak." ), _( "Old Version" ), wxYES_NO ) )
 			{
-				// we make a backup of the project
-				::wxCopyFile( file, file + wxT( ".bak" ) );
-
-				if ( !ConvertProject( file, fbpVerMajor, fbpVerMinor ) )
+				if ( !ConvertProjectDocument( doc, file, fbpVerMajor, fbpVerMinor, !justGenerate ) )
 				{
 					wxLogError( wxT( "Unable to convert project" ) );
 					return false;
 				}
 
-				XMLUtils::LoadXMLFile( doc, false, file );
 				root = doc.FirstChildElement();
 			}
 			else
@@ -1351,6 +1643,12 @@ bool ApplicationData::LoadProject( const wxString &file, bool justGenerate )
 		try
 		{
 			proj = m_objDb->CreateObject( object );
+
+			// With split_forms, the forms are in their own files
+			if ( proj )
+			{
+				ProjectStorage::LoadForms( m_objDb, object, proj, ::wxPathOnly( file ) );
+			}
 		}
 		catch ( wxFBException& ex )
 		{
@@ -1358,17 +1656,13 @@ bool ApplicationData::LoadProject( const wxString &file, bool justGenerate )
 			return false;
 		}
 
-		if ( proj && proj->GetObjectTypeName() == wxT( "project" ) )
+		SetLoadedProject( proj, file );
+
+		if ( older && m_project == proj )
 		{
-			PObjectBase old_proj = m_project;
-			m_project = proj;
-			m_selObj = m_project;
-			m_modFlag = false;
-			m_cmdProc.Reset();
-			m_projectFile = file;
-			SetProjectPath( ::wxPathOnly( file ) );
-			NotifyProjectLoaded();
-			NotifyProjectRefresh();
+			// Converted, but not saved yet
+			m_modFlag = true;
+			m_convertedProjectFile = file;
 		}
 	}
 	catch( ticpp::Exception& ex )
@@ -1380,18 +1674,175 @@ bool ApplicationData::LoadProject( const wxString &file, bool justGenerate )
 	return true;
 }
 
-bool ApplicationData::ConvertProject( const wxString& path, int fileMajor, int fileMinor )
+void ApplicationData::CompareFileVersion( ticpp::Element* root, int* fileMajor, int* fileMinor, bool* older, bool* newer )
+{
+	*fileMajor = 0;
+	*fileMinor = 0;
+
+	if ( root->Value() != std::string( "object" ) )
+	{
+		try
+		{
+			ticpp::Element* fileVersion = root->FirstChildElement( "FileVersion" );
+			fileVersion->GetAttributeOrDefault( "major", fileMajor, 0 );
+			fileVersion->GetAttributeOrDefault( "minor", fileMinor, 0 );
+		}
+		catch( ticpp::Exception& )
+		{
+		}
+	}
+
+	if ( m_fbpVerMajor == *fileMajor )
+	{
+		*older = ( *fileMinor < m_fbpVerMinor );
+		*newer = ( *fileMinor > m_fbpVerMinor );
+	}
+	else
+	{
+		*older = ( *fileMajor < m_fbpVerMajor );
+		*newer = ( *fileMajor > m_fbpVerMajor );
+	}
+}
+
+void ApplicationData::SetLoadedProject( PObjectBase proj, const wxString& file )
 {
+	if ( proj && proj->GetObjectTypeName() == wxT( "project" ) )
+	{
+		PObjectBase old_proj = m_project;
+		m_project = proj;
+		m_selObj = m_project;
+		m_modFlag = false;
+		m_cmdProc.Reset();
+		m_projectFile = file;
+		m_convertedProjectFile.clear();
+		SetProjectPath( ::wxPathOnly( file ) );
+		NotifyProjectLoaded();
+		NotifyProjectRefresh();
+	}
+}
+
+bool ApplicationData::UpgradeProject( const wxString& path )
+{
+	ticpp::Document doc;
 	try
 	{
-		ticpp::Document doc;
 		XMLUtils::LoadXMLFile( doc, false, path );
+	}
+	catch ( wxFBException& ex )
+	{
+		wxLogError( wxT( "%s: %s" ), path.c_str(), ex.what() );
+		return false;
+	}
+	catch ( ticpp::Exception& ex )
+	{
+		wxLogError( wxT( "%s: %s" ), path.c_str(), _WXSTR( ex.m_details ).c_str() );
+		return false;
+	}
+
+	return UpgradeDocument( doc, path );
+}
+
+bool ApplicationData::UpgradeDocument( ticpp::Document& doc, const wxString& path )
+{
+	// No user interaction and nothing shared but the conversion warnings, so this can run in parallel
+	try
+	{
+		ticpp::Element* root = doc.FirstChildElement();
+
+		int fbpVerMajor = 0;
+		int fbpVerMinor = 0;
+		bool older = false;
+		bool newer = false;
+
+		CompareFileVersion( root, &fbpVerMajor, &fbpVerMinor, &older, &newer );
+
+		if ( newer )
+		{
+			wxLogError( _( "%s is newer than this version of wxFormBuilder" ), path.c_str() );
+			return false;
+		}
+
+		if ( !older )
+		{
+			return true;
+		}
+
+		if ( ProjectStorage::IsSplit( root ) )
+		{
+			wxLogError( _( "%s has its forms stored in separate files, it can only be converted as a single project file" ), path.c_str() );
+			return false;
+		}
+
+		if ( !ConvertProjectDocument( doc, path, fbpVerMajor, fbpVerMinor, false ) )
+		{
+			wxLogError( _( "Unable to convert %s" ), path.c_str() );
+			return false;
+		}
+
+		if ( !::wxCopyFile( path, path + wxT( ".bak" ) ) )
+		{
+			return false;
+		}
+
+		doc.SaveFile();
+	}
+	catch ( ticpp::Exception& ex )
+	{
+		wxLogError( wxT( "%s: %s" ), path.c_str(), _WXSTR( ex.m_details ).c_str() );
+		return false;
+	}
+
+	return true;
+}
+
+bool ApplicationData::UpgradeProjects( const wxArrayString& paths )
+{
+	// Loading can ask to fix the encoding of a file and sets the global parser setting, so it is done here in turn
+	std::vector< std::unique_ptr< ticpp::Document > > documents( paths.GetCount() );
+	bool loaded = true;
+	for ( size_t i = 0; i < paths.GetCount(); ++i )
+	{
+		documents[i].reset( new ticpp::Document );
+		try
+		{
+			XMLUtils::LoadXMLFile( *documents[i], false, paths[i] );
+		}
+		catch ( wxFBException& ex )
+		{
+			wxLogError( wxT( "%s: %s" ), paths[i].c_str(), ex.what() );
+			documents[i].reset();
+			loaded = false;
+		}
+		catch ( ticpp::Exception& ex )
+		{
+			wxLogError( wxT( "%s: %s" ), paths[i].c_str(), _WXSTR( ex.m_details ).c_str() );
+			documents[i].reset();
+			loaded = false;
+		}
+	}
+
+	std::atomic< bool > upgraded( loaded );
+	ParallelFor( paths.GetCount(), [ this, &paths, &documents, &upgraded ]( size_t i )
+	{
+		if ( documents[i] && !UpgradeDocument( *documents[i], paths[i] ) )
+		{
+			upgraded = false;
+		}
+		documents[i].reset();
+	} );
 
+	return upgraded;
+}
+
+bool ApplicationData::ConvertProjectDocument( ticpp::Document& doc, const wxString& path, int fileMajor, int fileMinor, bool interactive )
+{
+	try
+	{
 		ticpp::Element* root = doc.FirstChildElement();
 
 		if ( root->Value() == std::string( "object" ) )
 		{
-			ConvertProjectProperties( root, path, fileMajor, fileMinor );
+			ConvertProjectProperties( root, path, fileMajor, fileMinor, interactive );
 			ConvertObject( root, fileMajor, fileMinor );
 
 			// Create a clone of now-converted object tree, so it can be linked
@@ -1422,14 +1873,12 @@ bool ApplicationData::ConvertProject( const wxString& path, int fileMajor, int f
 		{
 			// Handle project separately because it only occurs once
 			ticpp::Element* project = root->FirstChildElement( "object" );
-			ConvertProjectProperties( project, path, fileMajor, fileMinor );
+			ConvertProjectProperties( project, path, fileMajor, fileMinor, interactive );
 			ConvertObject( project, fileMajor, fileMinor );
 			ticpp::Element* fileVersion = root->FirstChildElement( "FileVersion" );
 			fileVersion->SetAttribute( "major", m_fbpVerMajor );
 			fileVersion->SetAttribute( "minor", m_fbpVerMinor );
 		}
-
-		doc.SaveFile();
 	}
 	catch ( ticpp::Exception& ex )
 	{
@@ -1440,7 +1889,7 @@ bool ApplicationData::ConvertProject( const wxString& path, int fileMajor, int f
 	return true;
 }
 
-void ApplicationData::ConvertProjectProperties( ticpp::Element* project, const wxString& path, int fileMajor, int fileMinor )
+void ApplicationData::ConvertProjectProperties( ticpp::Element* project, const wxString& path, int fileMajor, int fileMinor, bool interactive )
 
 {
 	// Ensure that this is the "project" element
@@ -1470,7 +1919,11 @@ void ApplicationData::ConvertProjectProperties( ticpp::Element* project, const w
 			project->RemoveChild( *newProps.begin() );
 		}
 
-		if ( !user_headers.empty() )
+		if ( !user_headers.empty() && !interactive )
+		{
+			wxLogWarning( _( "The \"user_headers\" property of %s has been removed, its value was:\n%s" ), path.c_str(), _WXSTR( user_headers ).c_str() );
+		}
+		else if ( !user_headers.empty() )
 		{
 			wxString 	msg  = _( "The \"user_headers\" property has been removed.\n" );
 			msg += _( "Its purpose was to provide a place to include precompiled headers or\n" );
@@ -1920,6 +2373,10 @@ void ApplicationData::ConvertObject( ticpp::Element* parent, int fileMajor, int
 			parent->SetAttribute( "class", objClass );
 			classUpdated = true;
 		}
+		// Projects can be converted in parallel
+		static std::mutex warningsMutex;
+		std::lock_guard< std::mutex > lock( warningsMutex );
+
 		if( m_warnOnAdditionsUpdate && classUpdated )
 		{
 			m_warnOnAdditionsUpdate = false;
@@ -2352,11 +2809,13 @@ void ApplicationData::TransferOptionList( ticpp::Element* prop, std::set< wxStri
 void ApplicationData::NewProject()
 
 {
+	m_objDb->ResetArena();
 	m_project = m_objDb->CreateObject( "Project" );
 	m_selObj = m_project;
 	m_modFlag = false;
 	m_cmdProc.Reset();
 	m_projectFile = wxT( "" );
+	m_convertedProjectFile.clear();
 	SetProjectPath( wxT( "" ) );
 	m_ipc->Reset();
 	NotifyProjectRefresh();
@@ -2369,62 +2828,89 @@ void ApplicationData::GenerateCode( bool panelOnly, bool noDelayed )
 
 void ApplicationData::GenerateInheritedClass( PObjectBase form, wxString className, wxString path, wxString file )
 {
+	std::vector< GenClassDetails > classes( 1, GenClassDetails( form, className, file, true ) );
+	GenerateInheritedClasses( classes, path );
+}
+
+bool ApplicationData::GenerateInheritedClasses( const std::vector< GenClassDetails >& classes, const wxString& path, bool keepExisting )
+{
+	struct InheritedClass
+	{
+		PObjectBase form;
+		PObjectBase userClasses;
+		wxString className;
+		wxString fullPath;
+		wxString genFileFullPath;
+	};
+
 	try
 	{
 		PObjectBase project = GetProjectData();
 		if ( !project )
 		{
 			wxLogWarning( _("No Project?!") );
-			return;
+			return false;
 		}
 
 		if ( !::wxDirExists( path ) )
 		{
 			wxLogWarning( _("Invalid Path: %s"), path.c_str() );
-			return;
+			return false;
 		}
 
-		PObjectBase obj = m_objDb->CreateObject( "UserClasses", PObjectBase() );
+		const wxString& genFileValue = project->GetPropertyAsString( _("file") );
 
-		PProperty baseNameProp = obj->GetProperty( wxT( "basename" ) );
-		PProperty nameProp = obj->GetProperty( wxT( "name" ) );
-		PProperty fileProp = obj->GetProperty( wxT( "file" ) );
-		PProperty genfileProp = obj->GetProperty( wxT( "gen_file" ) );
-		PProperty typeProp = obj->GetProperty( wxT( "type" ) );
-
-		if ( !( baseNameProp && nameProp && fileProp && typeProp && genfileProp ) )
+		bool generated = true;
+		std::vector< InheritedClass > inherited;
+		for ( std::vector< GenClassDetails >::const_iterator details = classes.begin(); details != classes.end(); ++details )
 		{
-			wxLogWarning( wxT("Missing Property") );
-			return;
-		}
+			PObjectBase obj = m_objDb->CreateObject( "UserClasses", PObjectBase() );
 
-        wxFileName inherFile( file );
-        if ( !inherFile.MakeAbsolute( path ) )
-        {
-            wxLogWarning( _("Unable to make \"%s\" absolute to \"%s\""), file.c_str(), path.c_str() );
-            return;
-        }
+			PProperty baseNameProp = obj->GetProperty( wxT( "basename" ) );
+			PProperty nameProp = obj->GetProperty( wxT( "name" ) );
+			PProperty fileProp = obj->GetProperty( wxT( "file" ) );
+			PProperty genfileProp = obj->GetProperty( wxT( "gen_file" ) );
+			PProperty typeProp = obj->GetProperty( wxT( "type" ) );
 
-        const wxString& genFileValue = project->GetPropertyAsString( _("file") );
-        wxFileName genFile( genFileValue );
-        if ( !genFile.MakeAbsolute( path ) )
-        {
-            wxLogWarning( _("Unable to make \"%s\" absolute to \"%s\""), genFileValue.c_str(), path.c_str() );
-            return;
-        }
+			if ( !( baseNameProp && nameProp && fileProp && typeProp && genfileProp ) )
+			{
+				wxLogWarning( wxT("Missing Property") );
+				return false;
+			}
 
-        const wxString& genFileFullPath = genFile.GetFullPath();
-        if ( !genFile.MakeRelativeTo( inherFile.GetPath( wxPATH_GET_VOLUME ) ) )
-        {
-            wxLogWarning( _("Unable to make \"%s\" relative to \"%s\""), genFileFullPath.c_str(), inherFile.GetPath( wxPATH_GET_VOLUME ).c_str() );
-            return;
-        }
+			wxFileName inherFile( details->m_fileName );
+			if ( !inherFile.MakeAbsolute( path ) )
+			{
+				wxLogWarning( _("Unable to make \"%s\" absolute to \"%s\""), details->m_fileName.c_str(), path.c_str() );
+				generated = false;
+				continue;
+			}
+
+			wxFileName genFile( genFileValue );
+			if ( !genFile.MakeAbsolute( path ) )
+			{
+				wxLogWarning( _("Unable to make \"%s\" absolute to \"%s\""), genFileValue.c_str(), path.c_str() );
+				generated = false;
+				continue;
+			}
+
+			const wxString& genFileFullPath = genFile.GetFullPath();
+			if ( !genFile.MakeRelativeTo( inherFile.GetPath( wxPATH_GET_VOLUME ) ) )
+			{
+				wxLogWarning( _("Unable to make \"%s\" relative to \"%s\""), genFileFullPath.c_str(), inherFile.GetPath( wxPATH_GET_VOLUME ).c_str() );
+				generated = false;
+				continue;
+			}
+
+			baseNameProp->SetValue( details->m_form->GetPropertyAsString( _("name") ) );
+			nameProp->SetValue( details->m_className );
+			fileProp->SetValue( inherFile.GetName() );
+			genfileProp->SetValue( genFile.GetFullPath() );
+			typeProp->SetValue( details->m_form->GetClassName() );
 
-		baseNameProp->SetValue( form->GetPropertyAsString( _("name") ) );
-		nameProp->SetValue( className );
-		fileProp->SetValue( inherFile.GetName() );
-		genfileProp->SetValue( genFile.GetFullPath() );
-		typeProp->SetValue( form->GetClassName() );
+			InheritedClass inheritedClass = { details->m_form, obj, details->m_className, inherFile.GetFullPath(), genFileFullPath };
+			inherited.push_back( inheritedClass );
+		}
 
 		// Determine if Microsoft BOM should be used
 		bool useMicrosoftBOM = false;
@@ -2445,59 +2931,116 @@ void ApplicationData::GenerateInheritedClass( PObjectBase form, wxString classNa
 		}
 
 		PProperty pCodeGen = project->GetProperty( wxT( "code_generation" ) );
-		if ( pCodeGen && TypeConv::FlagSet( wxT("C++"), pCodeGen->GetValue() ) )
-		{
-			CppCodeGenerator codegen;
-			const wxString& fullPath = inherFile.GetFullPath();
-			codegen.ParseFiles(fullPath + wxT(".h"), fullPath + wxT(".cpp"));
+		const bool cpp = ( pCodeGen && TypeConv::FlagSet( wxT("C++"), pCodeGen->GetValue() ) );
 
-			PCodeWriter h_cw( new FileCodeWriter( fullPath + wxT(".h"), useMicrosoftBOM, useUtf8 ) );
-			PCodeWriter cpp_cw( new FileCodeWriter( fullPath + wxT(".cpp"), useMicrosoftBOM, useUtf8 ) );
+		// Only the C++ generator recovers the user code, the files of the other languages can be kept instead
+		wxString extension;
+		if ( pCodeGen && !cpp )
+		{
+			if ( TypeConv::FlagSet( wxT("Python"), pCodeGen->GetValue() ) )
+			{
+				extension = wxT(".py");
+			}
+			else if ( TypeConv::FlagSet( wxT("PHP"), pCodeGen->GetValue() ) )
+			{
+				extension = wxT(".php");
+			}
+			else if ( TypeConv::FlagSet( wxT("Lua"), pCodeGen->GetValue() ) )
+			{
+				extension = wxT(".lua");
+			}
+		}
 
-			codegen.SetHeaderWriter( h_cw );
-			codegen.SetSourceWriter( cpp_cw );
+		// The user code of the existing files is recovered in parallel, the generation runs in order in this thread
+		std::vector< CCodeParser > parsers;
+		if ( cpp )
+		{
+			parsers.reserve( inherited.size() );
+			for ( std::vector< InheritedClass >::iterator it = inherited.begin(); it != inherited.end(); ++it )
+			{
+				parsers.emplace_back( it->fullPath + wxT(".h"), it->fullPath + wxT(".cpp") );
+			}
 
-			codegen.GenerateInheritedClass( obj, form );
+			ParallelFor( parsers.size(), [ &parsers, &inherited ]( size_t i )
+			{
+				parsers[i].ParseCFiles( inherited[i].className );
+			} );
 		}
-		else if( pCodeGen && TypeConv::FlagSet( wxT("Python"), pCodeGen->GetValue() ) )
+
+		for ( size_t i = 0; i < inherited.size(); ++i )
 		{
-			PythonCodeGenerator codegen;
+			PObjectBase obj = inherited[i].userClasses;
+			PObjectBase form = inherited[i].form;
+			const wxString& fullPath = inherited[i].fullPath;
 
-			const wxString& fullPath = inherFile.GetFullPath();
-			PCodeWriter python_cw( new FileCodeWriter( fullPath + wxT(".py"), useMicrosoftBOM, useUtf8 ) );
+			if ( cpp )
+			{
+				CppCodeGenerator codegen;
+				codegen.SetParsedFiles( std::move( parsers[i] ) );
 
-			codegen.SetSourceWriter( python_cw );
+				PCodeWriter h_cw( new FileCodeWriter( fullPath + wxT(".h"), useMicrosoftBOM, useUtf8 ) );
+				PCodeWriter cpp_cw( new FileCodeWriter( fullPath + wxT(".cpp"), useMicrosoftBOM, useUtf8 ) );
 
-			codegen.GenerateInheritedClass( obj, form );
-		}
-		else if( pCodeGen && TypeConv::FlagSet( wxT("PHP"), pCodeGen->GetValue() ) )
-		{
-			PHPCodeGenerator codegen;
+				codegen.SetHeaderWriter( h_cw );
+				codegen.SetSourceWriter( cpp_cw );
+
+				codegen.GenerateInheritedClass( obj, form );
+			}
+			else if ( keepExisting && !extension.empty() && ::wxFileExists( fullPath + extension ) )
+			{
+				wxLogMessage( _("The inherited class %s already exists in %s, it is kept."), inherited[i].className.c_str(), ( fullPath + extension ).c_str() );
+			}
+			else if( pCodeGen && TypeConv::FlagSet( wxT("Python"), pCodeGen->GetValue() ) )
+			{
+				PythonCodeGenerator codegen;
 
-			const wxString& fullPath = inherFile.GetFullPath();
-			PCodeWriter php_cw( new FileCodeWriter( fullPath + wxT(".php"), useMicrosoftBOM, useUtf8 ) );
+				PCodeWriter python_cw( new FileCodeWriter( fullPath + wxT(".py"), useMicrosoftBOM, useUtf8 ) );
 
-			codegen.SetSourceWriter( php_cw );
+				codegen.SetSourceWriter( python_cw );
 
-			codegen.GenerateInheritedClass( obj, form );
-		}
-		else if( pCodeGen && TypeConv::FlagSet( wxT("Lua"), pCodeGen->GetValue() ) )
-		{
-			LuaCodeGenerator codegen;
+				codegen.GenerateInheritedClass( obj, form );
+			}
+			else if( pCodeGen && TypeConv::FlagSet( wxT("PHP"), pCodeGen->GetValue() ) )
+			{
+				PHPCodeGenerator codegen;
 
-			const wxString& fullPath = inherFile.GetFullPath();
-			PCodeWriter lua_cw( new FileCodeWriter( fullPath + wxT(".lua"), useMicrosoftBOM, useUtf8 ) );
+				PCodeWriter php_cw( new FileCodeWriter( fullPath + wxT(".php"), useMicrosoftBOM, useUtf8 ) );
 
-			codegen.SetSourceWriter( lua_cw );
+				codegen.SetSourceWriter( php_cw );
 
-			codegen.GenerateInheritedClass( obj, form, genFileFullPath );
+				codegen.GenerateInheritedClass( obj, form );
+			}
+			else if( pCodeGen && TypeConv::FlagSet( wxT("Lua"), pCodeGen->GetValue() ) )
+			{
+				LuaCodeGenerator codegen;
+
+				PCodeWriter lua_cw( new FileCodeWriter( fullPath + wxT(".lua"), useMicrosoftBOM, useUtf8 ) );
+
+				codegen.SetSourceWriter( lua_cw );
+
+				codegen.GenerateInheritedClass( obj, form, inherited[i].genFileFullPath );
+			}
+		}
+
+		if ( !FileCodeWriter::WaitForPendingWrites() )
+		{
+			generated = false;
 		}
 
-		wxLogStatus( wxT( "Class generated at \'%s\'." ), path.c_str() );
+		if ( inherited.size() == 1 )
+		{
+			wxLogStatus( wxT( "Class generated at \'%s\'." ), path.c_str() );
+		}
+		else
+		{
+			wxLogStatus( wxT( "%u classes generated at \'%s\'." ), (unsigned)inherited.size(), path.c_str() );
+		}
+		return generated;
 	}
 	catch( wxFBException& ex )
 	{
 		wxLogError( ex.what() );
+		return false;
 	}
 }
 
@@ -2998,6 +3541,9 @@ void ApplicationData::NotifyEvent( wxFBEvent& event, bool forcedelayed )
 
 void ApplicationData::NotifyProjectLoaded()
 {
+	m_codeAnalysis->Invalidate();
+	m_searchIndex->Invalidate();
+
 	wxFBEvent event( wxEVT_FB_PROJECT_LOADED );
 	NotifyEvent( event );
 }
@@ -3024,30 +3570,44 @@ void ApplicationData::NotifyObjectSelected( PObjectBase obj, bool force )
 
 void ApplicationData::NotifyObjectCreated( PObjectBase obj )
 {
+	m_codeAnalysis->Invalidate();
+	m_searchIndex->AddObject( obj );
+
 	wxFBObjectEvent event( wxEVT_FB_OBJECT_CREATED, obj );
 	NotifyEvent( event, false );
 }
 
 void ApplicationData::NotifyObjectRemoved( PObjectBase obj )
 {
+	m_codeAnalysis->Invalidate();
+	m_searchIndex->RemoveObject( obj );
+
 	wxFBObjectEvent event( wxEVT_FB_OBJECT_REMOVED, obj );
 	NotifyEvent( event, false );
 }
 
 void ApplicationData::NotifyPropertyModified( PProperty prop )
 {
+	m_codeAnalysis->Invalidate();
+	m_searchIndex->UpdateProperty( prop );
+
 	wxFBPropertyEvent event( wxEVT_FB_PROPERTY_MODIFIED, prop );
 	NotifyEvent( event );
 }
 
 void ApplicationData::NotifyEventHandlerModified( PEvent evtHandler )
 {
+	m_codeAnalysis->Invalidate();
+	m_searchIndex->UpdateEvent( evtHandler );
+
 	wxFBEventHandlerEvent event( wxEVT_FB_EVENT_HANDLER_MODIFIED, evtHandler );
 	NotifyEvent( event );
 }
 
 void ApplicationData::NotifyCodeGeneration( bool panelOnly, bool forcedelayed )
 {
+	m_codeAnalysis->Invalidate();
+
 	wxFBEvent event( wxEVT_FB_CODE_GENERATION );
 
 	// Using the previously unused Id field in the event to carry a boolean
@@ -3058,6 +3618,9 @@ void ApplicationData::NotifyCodeGeneration( bool panelOnly, bool forcedelayed )
 
 void ApplicationData::NotifyProjectRefresh()
 {
+	m_codeAnalysis->Invalidate();
+	m_searchIndex->Invalidate();
+
 	wxFBEvent event( wxEVT_FB_PROJECT_REFRESH );
 	NotifyEvent( event );
 }
@@ -3067,6 +3630,11 @@ bool ApplicationData::VerifySingleInstance( const wxString& file, bool switchTo
 	return m_ipc->VerifySingleInstance( file, switchTo );
 }
 
+bool ApplicationData::CreateGenerationServer( const wxString& service, GenerationHandler handler )
+{
+	return m_ipc->CreateGenerationServer( service, handler );
+}
+
 wxString ApplicationData::GetPathProperty( const wxString& pathName )
 {
 	PObjectBase project = GetProjectData();
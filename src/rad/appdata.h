@@ -27,6 +27,7 @@
 #define __APP_DATA__
 
 #include "../model/database.h"
+#include "../utils/wxfbipc.h"
 #include "cmdproc.h"
 
 namespace ticpp
@@ -35,6 +36,8 @@ namespace ticpp
 class Node;
 
 class Element;
+
+class Document;
 }
 
 class Property;
@@ -43,7 +46,7 @@ class wxFBEvent;
 
 class wxFBManager;
 
-class wxFBIPC;
+class GenClassDetails;
 
 #define AppData()         	(ApplicationData::Get())
 #define AppDataCreate(path) (ApplicationData::Get(path))
@@ -80,6 +83,8 @@ class ApplicationData
 
 		wxString m_projectFile;
 
+		wxString m_convertedProjectFile; // converted on load, backed up when first saved over
+
 		wxString m_projectPath;
 
 		PwxFBManager m_manager;
@@ -87,6 +92,12 @@ class ApplicationData
 		// Prevent more than one instance of a project
 		std::shared_ptr< wxFBIPC > m_ipc;
 
+		// Analysis of the forms shared by the code generators, cleared on every model change
+		PCodeAnalysis m_codeAnalysis;
+
+		// Words of the project for the project search, updated from the notified changes
+		PSearchIndex m_searchIndex;
+
 
 		typedef std::vector< wxEvtHandler* > HandlerVector;
 
@@ -137,6 +148,12 @@ class ApplicationData
 		 */
 		void BuildNameSet( PObjectBase obj, PObjectBase top, std::set<wxString> &name_set );
 
+		/**
+		 * Makes the names of a subtree not inserted yet unique in the set, and adds them to it.
+		 * The last suffix used for each name is kept, so many copies are named in one pass.
+		 */
+		void AllocateSubtreeNames( PObjectBase obj, std::set< wxString >& name_set, std::map< wxString, int >& suffixes );
+
 		/**
 		 * Calcula la posición donde deberá ser insertado el objeto.
 		 *
@@ -182,8 +199,22 @@ class ApplicationData
 		@param path The path to the project file.
 		@param fileMajor The major revision of the file.
 		@param fileMinor The minor revision of the file.
+		@param interactive Whether the user can be asked about the conversion, otherwise the issues are only logged.
+		*/
+		void ConvertProjectProperties( ticpp::Element* project, const wxString& path, int fileMajor, int fileMinor, bool interactive );
+
+		/**
+		Reads the file version of a project document and compares it with the current one.
+		*/
+		// Converts a loaded project document and writes it back over its file, can run in parallel
+		bool UpgradeDocument( ticpp::Document& doc, const wxString& path );
+
+		void CompareFileVersion( ticpp::Element* root, int* fileMajor, int* fileMinor, bool* older, bool* newer );
+
+		/**
+		Makes a newly loaded project the current one.
 		*/
-		void ConvertProjectProperties( ticpp::Element* project, const wxString& path, int fileMajor, int fileMinor );
+		void SetLoadedProject( PObjectBase proj, const wxString& file );
 
 		/**
 		Iterates through 'property' element children of @a parent.
@@ -258,16 +289,38 @@ class ApplicationData
 
 		void SaveProject( const wxString &filename );
 
+		/**
+		Writes the project to the file, in the binary format if its extension is .fbpb, without
+		changing the current project file. Throws a wxFBException on failure.
+		*/
+		void WriteProject( const wxString& filename );
+
 		void NewProject();
 
 		/**
-		Convert a project from an older version.
+		Convert a project file from an older version on disk, keeping the original as .bak.
+		Files of the current version are left untouched.
+		@param path The path to the project file
+		@return true if successful, false otherwise
+		*/
+		bool UpgradeProject( const wxString& path );
+
+		/**
+		Upgrade several project files, the files are loaded in turn and converted in parallel.
+		@return true if all of them were successful
+		*/
+		bool UpgradeProjects( const wxArrayString& paths );
+
+		/**
+		Convert a loaded project document from an older version, in memory.
+		@param doc The document of the project, converted in place
 		@param path The path to the project file
 		@param fileMajor The major revision of the file
 		@param fileMinor The minor revision of the file
+		@param interactive Whether the user can be asked about the conversion
 		@return true if successful, false otherwise
 		*/
-		bool ConvertProject( const wxString& path, int fileMajor, int fileMinor );
+		bool ConvertProjectDocument( ticpp::Document& doc, const wxString& path, int fileMajor, int fileMinor, bool interactive );
 
 		/**
 		Recursive function used to convert the object tree in the project file to the latest version.
@@ -295,6 +348,11 @@ class ApplicationData
 
 		bool PasteObject( PObjectBase parent, PObjectBase objToPaste = PObjectBase() );
 
+		/**
+		 * Inserts count copies of the object after it, as a single undoable command.
+		 */
+		bool DuplicateObject( PObjectBase obj, unsigned int count );
+
 		void CopyObjectToClipboard( PObjectBase obj );
 
 		bool PasteObjectFromClipboard( PObjectBase parent );
@@ -311,6 +369,14 @@ class ApplicationData
 
 		void GenerateInheritedClass( PObjectBase form, wxString className, wxString path, wxString file );
 
+		/**
+		* Generates the inherited classes of several forms at once, in the files relative to the path.
+		* The existing C++ files are parsed in parallel and keep their user code. The other generators can not
+		* recover it, with keepExisting their existing files are left alone instead of being overwritten.
+		* Returns false if any class could not be generated.
+		*/
+		bool GenerateInheritedClasses( const std::vector< GenClassDetails >& classes, const wxString& path, bool keepExisting = false );
+
 		void MovePosition( PObjectBase, bool right, unsigned int num = 1 );
 
 		void MoveHierarchy( PObjectBase obj, bool up );
@@ -342,6 +408,8 @@ class ApplicationData
 
 		bool CanRedo() { return m_cmdProc.CanRedo(); }
 
+		const CommandProcessor& GetCommandProcessor() const { return m_cmdProc; }
+
 		bool GetLayoutSettings( PObjectBase obj, int *flag, int *option, int *border, int* orient );
 		bool CanPasteObject();
 		bool CanPasteObjectFromClipboard();
@@ -357,6 +425,12 @@ class ApplicationData
 		PObjectDatabase GetObjectDatabase()
 		{ return m_objDb; }
 
+		PCodeAnalysis GetCodeAnalysis()
+		{ return m_codeAnalysis; }
+
+		PSearchIndex GetSearchIndex()
+		{ return m_searchIndex; }
+
 
 		// Servicios específicos, no definidos en DataObservable
 		void        SetClipboardObject( PObjectBase obj ) { m_clipboard = obj; }
@@ -391,6 +465,9 @@ class ApplicationData
 
 		// Allow a single instance check from outsid the AppData class
 		bool VerifySingleInstance( const wxString& file, bool switchTo = true );
+
+		// Answer the code generation requests of other instances on the endpoint
+		bool CreateGenerationServer( const wxString& service, GenerationHandler handler );
 };
 
 #endif //__APP_DATA__
@@ -34,21 +34,20 @@ m_savePoint( 0 )
 void CommandProcessor::Execute(PCommand command)
 {
   command->Execute();
-  m_undoStack.push(command);
+  m_undoStack.push_back(command);
 
-  while (!m_redoStack.empty())
-    m_redoStack.pop();
+  m_redoStack.clear();
 }
 
 void CommandProcessor::Undo()
 {
   if (!m_undoStack.empty())
   {
-    PCommand command = m_undoStack.top();
-    m_undoStack.pop();
+    PCommand command = m_undoStack.back();
+    m_undoStack.pop_back();
 
     command->Restore();
-    m_redoStack.push(command);
+    m_redoStack.push_back(command);
   }
 }
 
@@ -56,21 +55,18 @@ void CommandProcessor::Redo()
 {
   if (!m_redoStack.empty())
   {
-    PCommand command = m_redoStack.top();
-    m_redoStack.pop();
+    PCommand command = m_redoStack.back();
+    m_redoStack.pop_back();
 
     command->Execute();
-    m_undoStack.push(command);
+    m_undoStack.push_back(command);
   }
 }
 
 void CommandProcessor::Reset()
 {
-  while (!m_redoStack.empty())
-    m_redoStack.pop();
-
-  while (!m_undoStack.empty())
-    m_undoStack.pop();
+  m_redoStack.clear();
+  m_undoStack.clear();
 
   m_savePoint = 0;
 }
@@ -94,6 +90,20 @@ bool CommandProcessor::IsAtSavePoint()
 	return m_undoStack.size() == m_savePoint;
 }
 
+size_t CommandProcessor::GetMemorySize() const
+{
+	size_t size = 0;
+	for ( CommandStack::const_iterator command = m_undoStack.begin(); command != m_undoStack.end(); ++command )
+	{
+		size += ( *command )->GetMemorySize();
+	}
+	for ( CommandStack::const_iterator command = m_redoStack.begin(); command != m_redoStack.end(); ++command )
+	{
+		size += ( *command )->GetMemorySize();
+	}
+	return size;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 Command::Command()
 {
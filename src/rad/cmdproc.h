@@ -26,8 +26,8 @@
 #ifndef __COMMAND_PROC__
 #define __COMMAND_PROC__
 
-#include <stack>
 #include <memory>
+#include <vector>
 
 class Command;
 typedef std::shared_ptr<Command> PCommand;
@@ -35,7 +35,7 @@ typedef std::shared_ptr<Command> PCommand;
 class CommandProcessor
 {
  private:
-  typedef std::stack<PCommand> CommandStack;
+  typedef std::vector<PCommand> CommandStack;
 
   CommandStack m_undoStack;
   CommandStack m_redoStack;
@@ -54,6 +54,14 @@ class CommandProcessor
 
    bool CanUndo();
    bool CanRedo();
+
+   size_t GetUndoCount() const { return m_undoStack.size(); }
+   size_t GetRedoCount() const { return m_redoStack.size(); }
+
+   /**
+    * Bytes kept alive by the commands of the history, see Command::GetMemorySize().
+    */
+   size_t GetMemorySize() const;
 };
 
 
@@ -79,6 +87,12 @@ class Command
 
   void Execute();
   void Restore();
+
+  /**
+   * Estimated bytes kept alive by the command: the values it restores, and the objects it holds
+   * while they are out of the project.
+   */
+  virtual size_t GetMemorySize() const { return 0; }
 };
 
 #endif //__COMMAND_PROC__
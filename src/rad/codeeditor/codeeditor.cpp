@@ -25,11 +25,13 @@
 
 #include "codeeditor.h"
 
+#include <wx/aui/auibook.h>
 #include <wx/fdrepdlg.h>
 #include <wx/msgdlg.h>
 #include <wx/sizer.h>
 
 #include <wx/stc/stc.h>
+#include <wx/toplevel.h>
 
 BEGIN_EVENT_TABLE ( CodeEditor,  wxPanel )
     EVT_STC_MARGINCLICK( wxID_ANY, CodeEditor::OnMarginClick )
@@ -140,3 +142,15 @@ void CodeEditor::OnFind( wxFindDialogEvent& event )
 		m_code->EnsureCaretVisible();
 	}
 }
+
+bool CodeEditor::IsPanelVisible( wxWindow* panel )
+{
+	wxTopLevelWindow* frame = wxDynamicCast( wxGetTopLevelParent( panel ), wxTopLevelWindow );
+	if ( frame && ( !frame->IsShown() || frame->IsIconized() ) )
+	{
+		return false;
+	}
+
+	wxAuiNotebook* notebook = wxDynamicCast( panel->GetParent(), wxAuiNotebook );
+	return ( notebook ? notebook->GetCurrentPage() == panel : panel->IsShown() );
+}
@@ -46,6 +46,12 @@ public:
     wxStyledTextCtrl* GetTextCtrl();
 
 	void OnFind( wxFindDialogEvent& event );
+
+	/**
+	* True if the language panel is the selected page of its notebook, in a frame which is shown and not minimized.
+	* The pages of a notebook which are not selected can still report that they are shown.
+	*/
+	static bool IsPanelVisible( wxWindow* panel );
 };
 
 #endif //__CODE_EDITOR__
@@ -41,6 +41,7 @@
 
 #include "../../codegen/codewriter.h"
 #include "../../codegen/cppcg.h"
+#include "../../codegen/generationcache.h"
 
 #include <wx/fdrepdlg.h>
 #include <wx/stc/stc.h>
@@ -60,7 +61,8 @@ END_EVENT_TABLE()
 
 CppPanel::CppPanel( wxWindow *parent, int id )
 :
-wxPanel( parent, id )
+wxPanel( parent, id ),
+m_stale( false )
 {
 	AppData()->AddHandler( this->GetEventHandler() );
 	wxBoxSizer *top_sizer = new wxBoxSizer( wxVERTICAL );
@@ -210,12 +212,27 @@ void CppPanel::OnEventHandlerModified( wxFBEventHandlerEvent& event )
 	OnCodeGeneration( event );
 }
 
+void CppPanel::GenerateIfStale()
+{
+	// A single generation catches up with all the changes made while the panel was not visible
+	if ( m_stale )
+	{
+		wxFBEvent event( wxEVT_FB_CODE_GENERATION );
+		event.SetId( 1 );
+		OnCodeGeneration( event );
+	}
+}
+
 void CppPanel::OnCodeGeneration( wxFBEvent& event )
 {
     PObjectBase objectToGenerate;
 
-	// Generate code in the panel if the panel is active
-	bool doPanel = IsShown();
+	// Generate code in the panel if it is the visible page, otherwise once it is selected
+	bool doPanel = CodeEditor::IsPanelVisible( this );
+	if ( !doPanel )
+	{
+		m_stale = true;
+	}
 
 	// Using the previously unused Id field in the event to carry a boolean
 	bool panelOnly = ( event.GetId() != 0 );
@@ -338,31 +355,15 @@ void CppPanel::OnCodeGeneration( wxFBEvent& event )
 
 		Freeze();
 
-        wxStyledTextCtrl* cppEditor = m_cppPanel->GetTextCtrl();
-        wxStyledTextCtrl* hEditor   = m_hPanel->GetTextCtrl();
-		cppEditor->SetReadOnly( false );
-		int cppLine = cppEditor->GetFirstVisibleLine() + cppEditor->LinesOnScreen() - 1;
-		int cppXOffset = cppEditor->GetXOffset();
-
-		hEditor->SetReadOnly( false );
-		int hLine = hEditor->GetFirstVisibleLine() + hEditor->LinesOnScreen() - 1;
-		int hXOffset = hEditor->GetXOffset();
-
 		codegen.GenerateCode( project );
 
-		cppEditor->SetReadOnly( true );
-		cppEditor->GotoLine( cppLine );
-		cppEditor->SetXOffset( cppXOffset );
-		cppEditor->SetAnchor( 0 );
-		cppEditor->SetCurrentPos( 0 );
-
-		hEditor->SetReadOnly( true );
-		hEditor->GotoLine( hLine );
-		hEditor->SetXOffset( hXOffset );
-		hEditor->SetAnchor( 0 );
-		hEditor->SetCurrentPos( 0 );
+		// Only the changed lines are replaced, so the views keep their position
+		m_cppCW->Flush();
+		m_hCW->Flush();
 
 		Thaw();
+
+		m_stale = false;
 	}
 
 	// Generate code in the file
@@ -370,47 +371,67 @@ void CppPanel::OnCodeGeneration( wxFBEvent& event )
 	{
 		try
 		{
-			CppCodeGenerator codegen;
-			codegen.UseRelativePath( useRelativePath, path );
-
-			if ( pFirstID )
+			// Skip the generation when nothing it depends on changed
+			GenerationCache cache( path, file );
+			wxArrayString outputs;
+			outputs.Add( path + file + wxT( ".h" ) );
+			outputs.Add( path + file + wxT( ".cpp" ) );
+			const wxString cacheKey = GenerationCache::ComputeKey( project, wxT("C++") );
+			if ( cache.IsUpToDate( wxT("C++"), cacheKey, outputs ) )
 			{
-				codegen.SetFirstID( firstID );
+				wxLogStatus( wxT( "Code on \'%s\' is up to date." ), path.c_str() );
+				return;
 			}
 
-			// Determin if Microsoft BOM should be used
-			bool useMicrosoftBOM = false;
+			{
+				CppCodeGenerator codegen;
+				codegen.UseRelativePath( useRelativePath, path );
 
-			PProperty pUseMicrosoftBOM = project->GetProperty( wxT( "use_microsoft_bom" ) );
+				if ( pFirstID )
+				{
+					codegen.SetFirstID( firstID );
+				}
 
-			if ( pUseMicrosoftBOM )
-			{
-				useMicrosoftBOM = ( pUseMicrosoftBOM->GetValueAsInteger() != 0 );
-			}
+				// Determin if Microsoft BOM should be used
+				bool useMicrosoftBOM = false;
 
-			// Determine if Utf8 or Ansi is to be created
-			bool useUtf8 = false;
-			PProperty pUseUtf8 = project->GetProperty( _("encoding") );
+				PProperty pUseMicrosoftBOM = project->GetProperty( wxT( "use_microsoft_bom" ) );
 
-			if ( pUseUtf8 )
-			{
-				useUtf8 = ( pUseUtf8->GetValueAsString() != wxT("ANSI") );
-			}
+				if ( pUseMicrosoftBOM )
+				{
+					useMicrosoftBOM = ( pUseMicrosoftBOM->GetValueAsInteger() != 0 );
+				}
+
+				// Determine if Utf8 or Ansi is to be created
+				bool useUtf8 = false;
+				PProperty pUseUtf8 = project->GetProperty( _("encoding") );
+
+				if ( pUseUtf8 )
+				{
+					useUtf8 = ( pUseUtf8->GetValueAsString() != wxT("ANSI") );
+				}
 
-			PCodeWriter h_cw( new FileCodeWriter( path + file + wxT( ".h" ), useMicrosoftBOM, useUtf8 ) );
+				PCodeWriter h_cw( new FileCodeWriter( path + file + wxT( ".h" ), useMicrosoftBOM, useUtf8 ) );
 
-			PCodeWriter cpp_cw( new FileCodeWriter( path + file + wxT( ".cpp" ), useMicrosoftBOM, useUtf8 ) );
+				PCodeWriter cpp_cw( new FileCodeWriter( path + file + wxT( ".cpp" ), useMicrosoftBOM, useUtf8 ) );
 
-			codegen.SetHeaderWriter( h_cw );
-			codegen.SetSourceWriter( cpp_cw );
-			codegen.GenerateCode( project );
-			wxLogStatus( wxT( "Code generated on \'%s\'." ), path.c_str() );
+				codegen.SetHeaderWriter( h_cw );
+				codegen.SetSourceWriter( cpp_cw );
+				codegen.GenerateCode( project );
+				wxLogStatus( wxT( "Code generated on \'%s\'." ), path.c_str() );
+
+				// check if we have to convert to ANSI encoding
+				if (project->GetPropertyAsString(wxT("encoding")) == wxT("ANSI"))
+				{
+					UTF8ToAnsi(path + file + wxT( ".h" ));
+					UTF8ToAnsi(path + file + wxT( ".cpp" ));
+				}
+			}
 
-			// check if we have to convert to ANSI encoding
-			if (project->GetPropertyAsString(wxT("encoding")) == wxT("ANSI"))
+			// The files are written when the writers are destroyed
+			if ( FileCodeWriter::WaitForPendingWrites() )
 			{
-				UTF8ToAnsi(path + file + wxT( ".h" ));
-				UTF8ToAnsi(path + file + wxT( ".cpp" ));
+				cache.Store( wxT("C++"), cacheKey, outputs );
 			}
 		}
 		catch ( wxFBException& ex )
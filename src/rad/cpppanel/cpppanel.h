@@ -52,6 +52,9 @@ private:
 	PTCCodeWriter m_cppCW;
 	wxAuiNotebook* m_notebook;
 
+	// The project changed while the panel was not visible
+	bool m_stale;
+
     void InitStyledTextCtrl( wxStyledTextCtrl* stc );
 
 public:
@@ -64,6 +67,9 @@ public:
 	void OnObjectChange( wxFBObjectEvent& event );
 	void OnEventHandlerModified( wxFBEventHandlerEvent& event );
 
+	// Generates the code of the panel if it is stale, once it is visible
+	void GenerateIfStale();
+
 	void OnFind( wxFindDialogEvent& event );
 
 	DECLARE_EVENT_TABLE()
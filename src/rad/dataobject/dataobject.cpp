@@ -23,32 +23,68 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "dataobject.h"
 
+#include "../../model/binaryproject.h"
 #include "../../model/objectbase.h"
 #include "../../utils/typeconv.h"
+#include "../../utils/wxfbexception.h"
 #include "../appdata.h"
 
 #include <ticpp.h>
 
 wxFBDataObject::wxFBDataObject(PObjectBase obj) {
 	if (obj) {
-		// create xml representation of ObjectBase
-		ticpp::Element element;
-		obj->SerializeObject( &element );
+		// the version is encoded too, just in case it is pasted into a different version of wxFB
+		m_data = BinaryProject::Encode( obj, AppData()->m_fbpVerMajor, AppData()->m_fbpVerMinor );
+	}
+}
+
+const std::string& wxFBDataObject::GetText() const
+{
+	// XML set by an older version
+	if ( !BinaryProject::IsEncoded( m_data ) )
+	{
+		return m_data;
+	}
+
+	if ( !m_text.empty() )
+	{
+		return m_text;
+	}
+
+	try
+	{
+		int major, minor;
+		BinaryProject::GetVersion( m_data, _("clipboard"), &major, &minor );
+
+		TiXmlDocument doc;
+		TiXmlElement* element = new TiXmlElement( "object" );
+		doc.LinkEndChild( element );
+		BinaryProject::DecodeToXml( m_data, _("clipboard"), element );
 
 		// add version info to xml data, just in case it is pasted into a different version of wxFB
-		element.SetAttribute( "fbp_version_major", AppData()->m_fbpVerMajor );
-		element.SetAttribute( "fbp_version_minor", AppData()->m_fbpVerMinor );
+		element->SetAttribute( "fbp_version_major", major );
+		element->SetAttribute( "fbp_version_minor", minor );
 
-		ticpp::Document doc;
-		doc.LinkEndChild( &element );
 		TiXmlPrinter printer;
-        printer.SetIndent( "\t" );
+		printer.SetIndent( "\t" );
 
 		printer.SetLineBreak("\n");
 
-        doc.Accept( &printer );
-		m_data = printer.Str();
+		doc.Accept( &printer );
+		m_text = printer.Str();
+	}
+	catch ( wxFBException& ex )
+	{
+		wxLogError( ex.what() );
 	}
+
+	return m_text;
+}
+
+const std::string& wxFBDataObject::GetData( const wxDataFormat& format ) const
+{
+	// The XML is only rendered if an older version or another application asks for it
+	return ( format == wxFBBinaryDataObjectFormat && BinaryProject::IsEncoded( m_data ) ? m_data : GetText() );
 }
 
 void wxFBDataObject::GetAllFormats( wxDataFormat* formats, Direction dir ) const
@@ -56,32 +92,35 @@ void wxFBDataObject::GetAllFormats( wxDataFormat* formats, Direction dir ) const
 	switch ( dir )
 	{
 		case Get:
-			formats[0] = wxFBDataObjectFormat;
-			formats[1] = wxDF_TEXT;
+			formats[0] = wxFBBinaryDataObjectFormat;
+			formats[1] = wxFBDataObjectFormat;
+			formats[2] = wxDF_TEXT;
 			break;
 		case Set:
-			formats[0] = wxFBDataObjectFormat;
+			formats[0] = wxFBBinaryDataObjectFormat;
+			formats[1] = wxFBDataObjectFormat;
 			break;
 		default:
 			break;
 	}
 }
 
-bool wxFBDataObject::GetDataHere( const wxDataFormat&, void* buf ) const
+bool wxFBDataObject::GetDataHere( const wxDataFormat& format, void* buf ) const
 {
 	if ( NULL == buf )
 	{
 		return false;
 	}
 
-	memcpy( (char*)buf, m_data.c_str(), m_data.length() );
+	const std::string& data = GetData( format );
+	memcpy( (char*)buf, data.c_str(), data.length() );
 
 	return true;
 }
 
-size_t wxFBDataObject::GetDataSize( const wxDataFormat& /*format*/ ) const
+size_t wxFBDataObject::GetDataSize( const wxDataFormat& format ) const
 {
-	return m_data.length();
+	return GetData( format ).length();
 }
 
 size_t wxFBDataObject::GetFormatCount( Direction dir ) const
@@ -89,9 +128,9 @@ size_t wxFBDataObject::GetFormatCount( Direction dir ) const
 	switch ( dir )
 	{
 		case Get:
-			return 2;
+			return 3;
 		case Set:
-			return 1;
+			return 2;
 		default:
 			return 0;
 	}
@@ -99,17 +138,19 @@ size_t wxFBDataObject::GetFormatCount( Direction dir ) const
 
 wxDataFormat wxFBDataObject::GetPreferredFormat( Direction /*dir*/ ) const
 {
-	return wxFBDataObjectFormat;
+	return wxFBBinaryDataObjectFormat;
 }
 
 bool wxFBDataObject::SetData( const wxDataFormat& format, size_t len, const void *buf )
 {
-	if ( format != wxFBDataObjectFormat )
+	if ( format != wxFBBinaryDataObjectFormat && format != wxFBDataObjectFormat )
 	{
 		return false;
 	}
 
+	// GetObj tells the binary data from the XML of the older versions
 	m_data.assign( reinterpret_cast< const char* >( buf ), len );
+	m_text.clear();
 	return true;
 }
 
@@ -120,17 +161,34 @@ PObjectBase wxFBDataObject::GetObj()
 		return PObjectBase();
 	}
 
-	// Read Object from xml
 	try
 	{
 		ticpp::Document doc;
-		doc.Parse( m_data, true, TIXML_ENCODING_UTF8 );
-		ticpp::Element* element = doc.FirstChildElement();
-
-
+		ticpp::Element* element = NULL;
 		int major, minor;
-		element->GetAttribute( "fbp_version_major", &major );
-		element->GetAttribute( "fbp_version_minor", &minor );
+		if ( BinaryProject::IsEncoded( m_data ) )
+		{
+			// The objects of the current version are created directly, the others are converted from XML
+			BinaryProject::GetVersion( m_data, _("clipboard"), &major, &minor );
+			if ( major == AppData()->m_fbpVerMajor && minor == AppData()->m_fbpVerMinor )
+			{
+				return BinaryProject::Decode( AppData()->GetObjectDatabase(), m_data, _("clipboard") );
+			}
+
+			TiXmlElement* object = new TiXmlElement( "object" );
+			doc.GetTiXmlPointer()->LinkEndChild( object );
+			BinaryProject::DecodeToXml( m_data, _("clipboard"), object );
+			element = doc.FirstChildElement();
+		}
+		else
+		{
+			// Read Object from xml
+			doc.Parse( m_data, true, TIXML_ENCODING_UTF8 );
+			element = doc.FirstChildElement();
+
+			element->GetAttribute( "fbp_version_major", &major );
+			element->GetAttribute( "fbp_version_minor", &minor );
+		}
 
 		if ( major > AppData()->m_fbpVerMajor || ( AppData()->m_fbpVerMajor == major && minor > AppData()->m_fbpVerMinor ) )
 		{
@@ -150,4 +208,9 @@ PObjectBase wxFBDataObject::GetObj()
 		wxLogError( _WXSTR( ex.m_details ) );
 		return PObjectBase();
 	}
+	catch( wxFBException& ex )
+	{
+		wxLogError( ex.what() );
+		return PObjectBase();
+	}
 }
@@ -27,7 +27,10 @@
 
 #include <wx/dnd.h>
 
+/** the XML of the object, the format of the older versions */
 #define wxFBDataObjectFormat wxDataFormat(wxT("wxFormBuilderDataFormat"))
+/** the object encoded by BinaryProject */
+#define wxFBBinaryDataObjectFormat wxDataFormat(wxT("wxFormBuilderBinaryDataFormat"))
 
 class wxFBDataObject : public wxDataObject {
 public:
@@ -41,5 +44,13 @@ public:
 	PObjectBase GetObj();
 
 private:
+	/** returns the XML of the object for wxFBDataObjectFormat and wxDF_TEXT, rendered on first request */
+	const std::string& GetText() const;
+
+	/** returns the data offered in the format */
+	const std::string& GetData(const wxDataFormat& format) const;
+
+	/** the object encoded by BinaryProject, or XML if it was set by an older version */
 	std::string m_data;
+	mutable std::string m_text;
 };
@@ -27,9 +27,15 @@
 #include "window_buttons.h"
 
 #include <wx/dcbuffer.h>
+#include <wx/time.h>
 
 DEFINE_EVENT_TYPE( wxEVT_INNER_FRAME_RESIZED )
 
+static const int ID_TIMER_RESIZE = wxWindow::NewControlId();
+
+// While the frame is resized with the mouse it is laid out at most once in this time (ms)
+static const int RESIZE_INTERVAL = 33;
+
 class wxInnerFrame::TitleBar : public wxPanel
 {
 private:
@@ -272,6 +278,7 @@ BEGIN_EVENT_TABLE( wxInnerFrame, wxPanel )
 	EVT_MOTION( wxInnerFrame::OnMouseMotion )
 	EVT_LEFT_DOWN( wxInnerFrame::OnLeftDown )
 	EVT_LEFT_UP( wxInnerFrame::OnLeftUp )
+	EVT_TIMER( ID_TIMER_RESIZE, wxInnerFrame::OnResizeTimer )
 END_EVENT_TABLE()
 
 wxInnerFrame::wxInnerFrame( wxWindow *parent, wxWindowID id,
@@ -285,6 +292,8 @@ wxInnerFrame::wxInnerFrame( wxWindow *parent, wxWindowID id,
 	m_sizing = NONE;
 	m_curX = m_curY = -1;
 	m_resizeBorder = 10;
+	m_lastResize = 0;
+	m_resizeTimer.SetOwner( this, ID_TIMER_RESIZE );
 
 	m_titleBar = new TitleBar( this, wxID_ANY, wxDefaultPosition, wxDefaultSize, style );
 	m_frameContent = new wxPanel( this, wxID_ANY, wxDefaultPosition, wxDefaultSize );
@@ -333,19 +342,6 @@ void wxInnerFrame::OnMouseMotion( wxMouseEvent& e )
 {
 	if ( m_sizing != NONE )
 	{
-		wxScreenDC dc;
-		wxPen pen(*wxBLACK, 1, wxPENSTYLE_DOT);
-
-		dc.SetPen( pen );
-		dc.SetBrush( *wxTRANSPARENT_BRUSH );
-		dc.SetLogicalFunction( wxINVERT );
-
-		//wxPoint pos = ClientToScreen(wxPoint(0, 0));
-		wxPoint pos = GetParent()->ClientToScreen( GetPosition() );
-
-		if ( m_curX >= 0 && m_curY >= 0 )
-			dc.DrawRectangle( pos.x, pos.y, m_curX, m_curY );
-
 		if ( m_sizing == RIGHT || m_sizing == RIGHTBOTTOM )
 			m_curX = e.GetX() + m_difX;
 		else
@@ -369,11 +365,15 @@ void wxInnerFrame::OnMouseMotion( wxMouseEvent& e )
 		if ( m_curX > maxSize.x && maxSize.x != wxDefaultCoord ) m_curX = maxSize.x;
 		if ( m_curY > maxSize.y && maxSize.y != wxDefaultCoord ) m_curY = maxSize.y;
 
-		dc.DrawRectangle( pos.x, pos.y, m_curX, m_curY );
-
-		dc.SetLogicalFunction( wxCOPY );
-		dc.SetPen( wxNullPen );
-		dc.SetBrush( wxNullBrush );
+		// The widgets follow the mouse, the sizes in between are skipped when the layout is slower
+		if ( wxGetLocalTimeMillis() - m_lastResize >= RESIZE_INTERVAL )
+		{
+			ApplySize();
+		}
+		else if ( !m_resizeTimer.IsRunning() )
+		{
+			m_resizeTimer.Start( RESIZE_INTERVAL, wxTIMER_ONE_SHOT );
+		}
 	}
 
 	else
@@ -438,43 +438,47 @@ void wxInnerFrame::OnLeftUp( wxMouseEvent& )
 		m_sizing = NONE;
 		ReleaseMouse();
 
-		wxScreenDC dc;
-		wxPen pen(*wxBLACK, 1, wxPENSTYLE_DOT);
-
-		dc.SetPen( pen );
-		dc.SetBrush( *wxTRANSPARENT_BRUSH );
-		dc.SetLogicalFunction( wxINVERT );
-
-		//wxPoint pos = ClientToScreen(wxPoint(0, 0));
-		wxPoint pos = GetParent()->ClientToScreen( GetPosition() );
-
-		dc.DrawRectangle( pos.x, pos.y, m_curX, m_curY );
-
-		dc.SetLogicalFunction( wxCOPY );
-		dc.SetPen( wxNullPen );
-		dc.SetBrush( wxNullBrush );
-
-		wxScrolledWindow * VEditor = (wxScrolledWindow*)GetParent();
-		int scrolledposX = 0;
-		int scrolledposY = 0;
-		VEditor->GetViewStart( &scrolledposX, &scrolledposY );
-		SetSize( m_curX, m_curY );
-		Freeze();
-		VEditor->FitInside();
-		VEditor->SetVirtualSize(GetSize().x + 20, GetSize().y + 20);
+		ApplySize();
 
+		// The model is only changed once, with the final size
 		wxCommandEvent event( wxEVT_INNER_FRAME_RESIZED, GetId() );
 		event.SetEventObject( this );
 		GetEventHandler()->AddPendingEvent( event );
 
-		VEditor->Scroll( scrolledposX, scrolledposY );
-		Thaw();
-		Update();
-
 		m_curX = m_curY = -1;
 	}
 }
 
+void wxInnerFrame::OnResizeTimer( wxTimerEvent& )
+{
+	if ( m_sizing != NONE )
+	{
+		ApplySize();
+	}
+}
+
+void wxInnerFrame::ApplySize()
+{
+	m_resizeTimer.Stop();
+	m_lastResize = wxGetLocalTimeMillis();
+
+	if ( GetSize() == wxSize( m_curX, m_curY ) )
+	{
+		return;
+	}
+
+	wxScrolledWindow * VEditor = (wxScrolledWindow*)GetParent();
+	int scrolledposX = 0;
+	int scrolledposY = 0;
+	VEditor->GetViewStart( &scrolledposX, &scrolledposY );
+	Freeze();
+	SetSize( m_curX, m_curY );
+	VEditor->FitInside();
+	VEditor->SetVirtualSize(GetSize().x + 20, GetSize().y + 20);
+	VEditor->Scroll( scrolledposX, scrolledposY );
+	Thaw();
+	Update();
+}
 
 void wxInnerFrame::ShowTitleBar( bool show )
 {
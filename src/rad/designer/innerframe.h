@@ -45,6 +45,10 @@ private:
 
     int m_curX, m_curY, m_difX, m_difY;
     int m_resizeBorder;
+
+    // Throttles the layout while the frame is resized with the mouse
+    wxTimer m_resizeTimer;
+    wxLongLong m_lastResize;
     wxSize m_minSize;
     wxSize m_baseMinSize;
 
@@ -68,6 +72,8 @@ public:
   void OnMouseMotion(wxMouseEvent& e);
   void OnLeftDown(wxMouseEvent& e);
   void OnLeftUp(wxMouseEvent& e);
+  void OnResizeTimer(wxTimerEvent& e);
+  void ApplySize();
 
   //wxAuiManager& GetAuiManager() {return m_mgr;}
 
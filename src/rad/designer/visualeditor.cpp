@@ -33,13 +33,102 @@
 #include "../wxfbmanager.h"
 #include "menubar.h"
 
+#include <wx/aui/floatpane.h>
 #include <wx/collpane.h>
 
+#include <functional>
+#include <vector>
+
 #ifdef __WX24__
 #define wxFULL_REPAINT_ON_RESIZE 0
 #endif
 
-static const int ID_TIMER_SCAN = wxWindow::NewControlId();
+static const int ID_TIMER_AUI_SYNC = wxWindow::NewControlId();
+
+// Forms kept built besides the shown one
+static const size_t MAX_BUILT_FORMS = 3;
+
+namespace
+{
+	/**
+	 * Reports the changes of the panes made by the user in the designer.
+	 *
+	 * The docked panes are moved and resized with the mouse on the managed window, whose events go through the
+	 * manager. The floating frames are not seen by the manager, so their moves and resizes are watched directly.
+	 */
+	class DesignerAuiManager : public wxAuiManager
+	{
+	private:
+		std::function< void() > m_changed;
+
+		void OnChanged( wxEvent& event )
+		{
+			event.Skip();
+			m_changed();
+		}
+
+	public:
+		DesignerAuiManager( wxWindow* managed, unsigned int flags, std::function< void() > changed )
+		:
+		wxAuiManager( managed, flags ),
+		m_changed( changed )
+		{
+			Bind( wxEVT_LEFT_UP, &DesignerAuiManager::OnChanged, this );
+			Bind( wxEVT_AUI_PANE_CLOSE, &DesignerAuiManager::OnChanged, this );
+		}
+
+		wxAuiFloatingFrame* CreateFloatingFrame( wxWindow* parent, const wxAuiPaneInfo& p ) override
+		{
+			wxAuiFloatingFrame* frame = wxAuiManager::CreateFloatingFrame( parent, p );
+			frame->Bind( wxEVT_MOVE, &DesignerAuiManager::OnChanged, this );
+			frame->Bind( wxEVT_SIZE, &DesignerAuiManager::OnChanged, this );
+			return frame;
+		}
+	};
+
+	bool IsBookPage( PObjectBase obj )
+	{
+		const wxString type = obj->GetObjectTypeName();
+		return ( type == wxT("notebookpage") || type == wxT("flatnotebookpage") || type == wxT("listbookpage") ||
+			type == wxT("choicebookpage") || type == wxT("simplebookpage") || type == wxT("auinotebookpage") );
+	}
+
+	/**
+	 * True if the object is the window of a book page which is not the selected one, and all it holds are sizers.
+	 *
+	 * The book selects the last page marked as selected, or the first one (see BookUtils::OnCreated()).
+	 */
+	bool IsHiddenPageWindow( PObjectBase obj )
+	{
+		PObjectBase page = obj->GetParent();
+		PObjectBase book = ( page ? page->GetParent() : PObjectBase() );
+		if ( !book || !IsBookPage( page ) || 0 == obj->GetChildCount() )
+		{
+			return false;
+		}
+
+		for ( unsigned int i = 0; i < obj->GetChildCount(); ++i )
+		{
+			IComponent* comp = obj->GetChild( i )->GetObjectInfo()->GetComponent();
+			if ( !comp || comp->GetComponentType() != COMPONENT_TYPE_SIZER )
+			{
+				return false;
+			}
+		}
+
+		PObjectBase selected = book->GetChild( 0 );
+		for ( unsigned int i = 0; i < book->GetChildCount(); ++i )
+		{
+			PObjectBase child = book->GetChild( i );
+			if ( IsBookPage( child ) && child->GetPropertyAsString( wxT("select") ) != wxT("0") )
+			{
+				selected = child;
+			}
+		}
+
+		return ( page != selected );
+	}
+}
 
 BEGIN_EVENT_TABLE(VisualEditor,wxScrolledWindow)
 	//EVT_SASH_DRAGGED(wxID_ANY, VisualEditor::OnResizeBackPanel)
@@ -53,9 +142,9 @@ BEGIN_EVENT_TABLE(VisualEditor,wxScrolledWindow)
 	EVT_FB_OBJECT_REMOVED( VisualEditor::OnObjectRemoved )
 	EVT_FB_PROPERTY_MODIFIED( VisualEditor::OnPropertyModified )
 	EVT_FB_PROJECT_REFRESH( VisualEditor::OnProjectRefresh )
-	EVT_FB_CODE_GENERATION( VisualEditor::OnProjectRefresh )
+	EVT_FB_CODE_GENERATION( VisualEditor::OnCodeGeneration )
 
-	EVT_TIMER( ID_TIMER_SCAN, VisualEditor::OnAuiScaner )
+	EVT_TIMER( ID_TIMER_AUI_SYNC, VisualEditor::OnAuiSync )
 
 END_EVENT_TABLE()
 
@@ -83,9 +172,8 @@ m_stopModifiedEvent( false )
 	m_auimgr = NULL;
 	m_auipanel = NULL;
 
-	// scan aui panes in run-time
-	m_AuiScaner.SetOwner( this, ID_TIMER_SCAN );
-	m_AuiScaner.Start( 200 );
+	// the aui panes are synchronized once the user is done moving them
+	m_auiSyncTimer.SetOwner( this, ID_TIMER_AUI_SYNC );
 
     m_wizard = NULL;
 }
@@ -114,7 +202,8 @@ void VisualEditor::DeleteAbstractObjects()
 
 VisualEditor::~VisualEditor()
 {
-	m_AuiScaner.Stop();
+	m_auiSyncTimer.Stop();
+	DropBuiltForms( PObjectBase() );
 
 	AppData()->RemoveHandler( this->GetEventHandler() );
 	DeleteAbstractObjects();
@@ -158,6 +247,9 @@ void VisualEditor::OnResizeBackPanel (wxCommandEvent &) //(wxSashEvent &event)
 		if (prop)
 		{
 			wxString value(TypeConv::PointToString(wxPoint(m_back->GetSize().x, m_back->GetSize().y)));
+
+			// The form already has this size, it is not built again
+			FlagFlipper stopModifiedEvent( this, &VisualEditor::PreventOnModified );
 			AppData()->ModifyProperty(prop, value);
 		}
 	}
@@ -216,17 +308,48 @@ wxObject* VisualEditor::GetWxObject( PObjectBase baseobject )
 	}
 }
 
-void VisualEditor::ScanPanes( wxWindow* parent)
+wxObject* VisualEditor::FindWxObject( ObjectBase* baseobject ) const
+{
+	ObjectBaseMap::const_iterator obj = m_baseobjects.find( baseobject );
+	return ( obj != m_baseobjects.end() ? obj->second : NULL );
+}
+
+size_t VisualEditor::GetBuiltFormWxObjectCount() const
+{
+	size_t count = 0;
+	for ( std::list< BuiltForm >::const_iterator built = m_builtForms.begin(); built != m_builtForms.end(); ++built )
+	{
+		count += built->wxobjects.size();
+	}
+	return count;
+}
+
+size_t VisualEditor::GetMemorySize() const
+{
+	// Each widget is counted as a wxWindow, with its entry in both maps; a node holds its value and two links
+	const size_t nodeOverhead = 2 * sizeof( void* );
+	const size_t widgetSize = sizeof( wxWindow ) + sizeof( wxObjectMap::value_type ) + sizeof( ObjectBaseMap::value_type ) + 2 * nodeOverhead;
+	const size_t pageSize = sizeof( UnbuiltPageMap::value_type ) + 2 * nodeOverhead;
+
+	size_t size = m_wxobjects.size() * widgetSize + m_unbuiltPages.size() * pageSize;
+	for ( std::list< BuiltForm >::const_iterator built = m_builtForms.begin(); built != m_builtForms.end(); ++built )
+	{
+		size += sizeof( BuiltForm ) + nodeOverhead + built->wxobjects.size() * widgetSize + built->unbuiltPages.size() * pageSize;
+	}
+	return size;
+}
+
+void VisualEditor::SyncPanes()
 {
 	bool updateNeeded;
+	PObjectBase changed;
 
 	wxLogNull stopTheLogging;
-	const wxWindowList& children = parent->GetChildren();
-	for ( wxWindowList::const_reverse_iterator child = children.rbegin(); child != children.rend(); ++child )
+	wxAuiPaneInfoArray& panes = m_auimgr->GetAllPanes();
+	for ( size_t i = 0; i < panes.GetCount(); ++i )
 	{
-		ScanPanes(*child);
-
-		PObjectBase obj = GetObjectBase( *child );
+		const wxAuiPaneInfo& inf = panes.Item( i );
+		PObjectBase obj = GetObjectBase( inf.window );
 
 		if ( obj )
 		{
@@ -246,7 +369,6 @@ void VisualEditor::ScanPanes( wxWindow* parent)
 				cname == wxT("toolbar") ||
 				cname == wxT("container") )
 			{
-				wxAuiPaneInfo inf = m_auimgr->GetPane(*child);
 				if(inf.IsOk())
 				{
 					// scan position and docking mode
@@ -367,16 +489,23 @@ void VisualEditor::ScanPanes( wxWindow* parent)
 						updateNeeded = true;
 					}
 
-					if( updateNeeded ) AppData()->SelectObject( obj, true, true );
+					if( updateNeeded ) changed = obj;
 				}
 			}
 		}
 	}
 
+	// Selecting refreshes the inspector, the panes must not be in use then
+	if ( changed )
+	{
+		AppData()->SelectObject( changed, true, true );
+	}
 }
 
 void VisualEditor::ClearAui()
 {
+	m_auiSyncTimer.Stop();
+
 	if ( m_auimgr )
 	{
 		m_auimgr->UnInit();
@@ -423,7 +552,7 @@ void VisualEditor::ClearComponents( wxWindow* parent )
 /**
 * Crea la vista preliminar borrando la previa.
 */
-void VisualEditor::Create()
+void VisualEditor::Create( bool keepBuilt )
 {
 #if !defined(__WXGTK__ )
 	if ( IsShown() )
@@ -432,24 +561,28 @@ void VisualEditor::Create()
                     // Causes problems on wx 2.9 in wxGTK (e.g. wxNoteBook objects)
 	}
 #endif
-	// Delete objects which had no parent
-	DeleteAbstractObjects();
-
-	// Clear selections, delete objects
+	// Clear selections
 	m_back->SetSelectedItem(NULL);
 	m_back->SetSelectedSizer(NULL);
 	m_back->SetSelectedObject(PObjectBase());
 
-	ClearAui();
-    ClearWizard();
-	ClearComponents( m_back->GetFrameContentPanel() );
+	if ( !keepBuilt || !ParkForm() )
+	{
+		// Delete objects which had no parent
+		DeleteAbstractObjects();
 
-	m_back->GetFrameContentPanel()->DestroyChildren();
-	m_back->GetFrameContentPanel()->SetSizer( NULL ); // *!*
+		ClearAui();
+		ClearWizard();
+		ClearComponents( m_back->GetFrameContentPanel() );
 
-	// Clear all associations between ObjectBase and wxObjects
-	m_wxobjects.clear();
-	m_baseobjects.clear();
+		m_back->GetFrameContentPanel()->DestroyChildren();
+		m_back->GetFrameContentPanel()->SetSizer( NULL ); // *!*
+
+		// Clear all associations between ObjectBase and wxObjects
+		m_wxobjects.clear();
+		m_baseobjects.clear();
+		m_unbuiltPages.clear();
+	}
 
 	if( IsShown() )
 	{
@@ -532,133 +665,10 @@ void VisualEditor::Create()
 			else
 			  m_back->ShowTitleBar(false);
 
-			// --- AUI
-			if(  m_form->GetObjectTypeName() == wxT("form") )
+			// --- [4] Show the components of the form, a form shown before is only moved back
+			if ( !RestoreForm() )
 			{
-				if(  m_form->GetPropertyAsInteger( wxT("aui_managed") ) == 1)
-				{
-					m_auipanel = new wxPanel( m_back->GetFrameContentPanel() );
-					m_auimgr = new wxAuiManager( m_auipanel, m_form->GetPropertyAsInteger( wxT("aui_manager_style") ) );
-				}
-			}
-
-            // --- Wizard
-            if ( m_form->GetClassName() == wxT("Wizard") )
-            {
-                m_wizard = new Wizard( m_back->GetFrameContentPanel() );
-
-                bool showbutton = false;
-                PProperty pextra_style = m_form->GetProperty( wxT("extra_style") );
-                if ( pextra_style )
-                {
-                    showbutton = pextra_style->GetValue().Contains( wxT("wxWIZARD_EX_HELPBUTTON") );
-                }
-
-                m_wizard->ShowHelpButton( showbutton );
-
-                if ( !m_form->GetProperty( wxT("bitmap") )->IsNull() )
-                {
-                    wxBitmap bmp = m_form->GetPropertyAsBitmap( wxT("bitmap") );
-                    if ( bmp.IsOk() )
-                    {
-                        m_wizard->SetBitmap( bmp );
-                    }
-                }
-            }
-
-			// --- [4] Create the components of the form -------------------------
-
-			// Used to save frame objects for later display
-			PObjectBase menubar;
-			wxWindow* statusbar = NULL;
-			wxWindow* toolbar = NULL;
-
-			for ( unsigned int i = 0; i < m_form->GetChildCount(); i++ )
-			{
-				PObjectBase child = m_form->GetChild( i );
-
-				if( !menubar && (m_form->GetObjectTypeName() == wxT("menubar_form")) )
-				{
-					// main form acts as a menubar
-					menubar = m_form;
-				}
-				else if (child->GetObjectTypeName() == wxT("menubar") )
-				{
-					// Create the menubar later
-					menubar = child;
-				} else if (toolbar == nullptr &&
-				           m_form->GetObjectTypeName() == wxT("toolbar_form")) {
-					Generate( m_form, m_back->GetFrameContentPanel(), m_back->GetFrameContentPanel() );
-
-					ObjectBaseMap::iterator it = m_baseobjects.find( m_form.get() );
-					toolbar = wxDynamicCast( it->second, wxToolBar );
-
-					break;
-				}
-				else
-				{
-					// Recursively generate the ObjectTree
-					try
-					{
-						// we have to put the content frame panel as parentObject in order
-						// to SetSizeHints be called.
-						if( m_auipanel )
-						{
-							Generate( child, m_auipanel, m_auipanel );
-						}
-                        else if( m_wizard )
-                        {
-                            Generate( child, m_wizard, m_wizard );
-                        }
-						else
-							Generate( child, m_back->GetFrameContentPanel(), m_back->GetFrameContentPanel() );
-
-					}
-					catch ( wxFBException& ex )
-					{
-						wxLogError ( ex.what() );
-					}
-				}
-
-				// Attach the toolbar (if any) to the frame
-				if (child->GetClassName() == wxT("wxToolBar") )
-				{
-					ObjectBaseMap::iterator it = m_baseobjects.find( child.get() );
-					toolbar = wxDynamicCast( it->second, wxToolBar );
-				}
-				else if (child->GetClassName() == wxT("wxAuiToolBar") )
-				{
-					ObjectBaseMap::iterator it = m_baseobjects.find( child.get() );
-					toolbar = wxDynamicCast( it->second, wxAuiToolBar );
-				}
-
-				// Attach the status bar (if any) to the frame
-				if ( child->GetObjectInfo()->IsSubclassOf( wxT("wxStatusBar") ) )
-				{
-					ObjectBaseMap::iterator it = m_baseobjects.find( child.get() );
-					statusbar = wxDynamicCast( it->second, wxStatusBar );
-				}
-
-				// Add toolbar(s) to AuiManager and update content
-				if( m_auimgr && toolbar )
-				{
-					SetupAui( GetObjectBase( toolbar ), toolbar );
-					toolbar = NULL;
-				}
-			}
-
-			if ( menubar || statusbar || toolbar || m_auipanel || m_wizard )
-			{
-				if( m_auimgr )
-				{
-					m_back->SetFrameWidgets( menubar, NULL, statusbar, m_auipanel );
-				}
-                else if( m_wizard )
-                {
-                    m_back->SetFrameWidgets( menubar, NULL, NULL, m_wizard );
-                }
-				else
-					m_back->SetFrameWidgets( menubar, toolbar, statusbar, m_auipanel );
+				BuildForm();
 			}
 
 			m_back->Layout();
@@ -705,6 +715,349 @@ void VisualEditor::Create()
 }
 
 
+/**
+* Creates the components of the selected form in the designer window.
+*/
+void VisualEditor::BuildForm()
+{
+	// --- AUI
+	if(  m_form->GetObjectTypeName() == wxT("form") )
+	{
+		if(  m_form->GetPropertyAsInteger( wxT("aui_managed") ) == 1)
+		{
+			m_auipanel = new wxPanel( m_back->GetFrameContentPanel() );
+			m_auimgr = new DesignerAuiManager( m_auipanel, m_form->GetPropertyAsInteger( wxT("aui_manager_style") ),
+				[this]() { m_auiSyncTimer.Start( 250, wxTIMER_ONE_SHOT ); } );
+		}
+	}
+
+    // --- Wizard
+    if ( m_form->GetClassName() == wxT("Wizard") )
+    {
+        m_wizard = new Wizard( m_back->GetFrameContentPanel() );
+
+        bool showbutton = false;
+        PProperty pextra_style = m_form->GetProperty( wxT("extra_style") );
+        if ( pextra_style )
+        {
+            showbutton = pextra_style->GetValue().Contains( wxT("wxWIZARD_EX_HELPBUTTON") );
+        }
+
+        m_wizard->ShowHelpButton( showbutton );
+
+        if ( !m_form->GetProperty( wxT("bitmap") )->IsNull() )
+        {
+            wxBitmap bmp = m_form->GetPropertyAsBitmap( wxT("bitmap") );
+            if ( bmp.IsOk() )
+            {
+                m_wizard->SetBitmap( bmp );
+            }
+        }
+    }
+
+	// --- [4] Create the components of the form -------------------------
+
+	// Used to save frame objects for later display
+	PObjectBase menubar;
+	wxWindow* statusbar = NULL;
+	wxWindow* toolbar = NULL;
+
+	for ( unsigned int i = 0; i < m_form->GetChildCount(); i++ )
+	{
+		PObjectBase child = m_form->GetChild( i );
+
+		if( !menubar && (m_form->GetObjectTypeName() == wxT("menubar_form")) )
+		{
+			// main form acts as a menubar
+			menubar = m_form;
+		}
+		else if (child->GetObjectTypeName() == wxT("menubar") )
+		{
+			// Create the menubar later
+			menubar = child;
+		} else if (toolbar == nullptr &&
+		           m_form->GetObjectTypeName() == wxT("toolbar_form")) {
+			Generate( m_form, m_back->GetFrameContentPanel(), m_back->GetFrameContentPanel() );
+
+			ObjectBaseMap::iterator it = m_baseobjects.find( m_form.get() );
+			toolbar = wxDynamicCast( it->second, wxToolBar );
+
+			break;
+		}
+		else
+		{
+			// Recursively generate the ObjectTree
+			try
+			{
+				// we have to put the content frame panel as parentObject in order
+				// to SetSizeHints be called.
+				if( m_auipanel )
+				{
+					Generate( child, m_auipanel, m_auipanel );
+				}
+                else if( m_wizard )
+                {
+                    Generate( child, m_wizard, m_wizard );
+                }
+				else
+					Generate( child, m_back->GetFrameContentPanel(), m_back->GetFrameContentPanel() );
+
+			}
+			catch ( wxFBException& ex )
+			{
+				wxLogError ( ex.what() );
+			}
+		}
+
+		// Attach the toolbar (if any) to the frame
+		if (child->GetClassName() == wxT("wxToolBar") )
+		{
+			ObjectBaseMap::iterator it = m_baseobjects.find( child.get() );
+			toolbar = wxDynamicCast( it->second, wxToolBar );
+		}
+		else if (child->GetClassName() == wxT("wxAuiToolBar") )
+		{
+			ObjectBaseMap::iterator it = m_baseobjects.find( child.get() );
+			toolbar = wxDynamicCast( it->second, wxAuiToolBar );
+		}
+
+		// Attach the status bar (if any) to the frame
+		if ( child->GetObjectInfo()->IsSubclassOf( wxT("wxStatusBar") ) )
+		{
+			ObjectBaseMap::iterator it = m_baseobjects.find( child.get() );
+			statusbar = wxDynamicCast( it->second, wxStatusBar );
+		}
+
+		// Add toolbar(s) to AuiManager and update content
+		if( m_auimgr && toolbar )
+		{
+			SetupAui( GetObjectBase( toolbar ), toolbar );
+			toolbar = NULL;
+		}
+	}
+
+	if ( menubar || statusbar || toolbar || m_auipanel || m_wizard )
+	{
+		if( m_auimgr )
+		{
+			m_back->SetFrameWidgets( menubar, NULL, statusbar, m_auipanel );
+		}
+        else if( m_wizard )
+        {
+            m_back->SetFrameWidgets( menubar, NULL, NULL, m_wizard );
+        }
+		else
+			m_back->SetFrameWidgets( menubar, toolbar, statusbar, m_auipanel );
+	}
+}
+
+/**
+* Moves the components of the shown form to a hidden panel, to show them again without building them if the
+* form is selected again. Only the last MAX_BUILT_FORMS forms are kept, the native windows are not for free.
+*
+* The forms managed by aui are not kept, their floating panes are frames of their own.
+*
+* @return false if the form was not parked, it has then to be cleared.
+*/
+bool VisualEditor::ParkForm()
+{
+	wxWindow* content = m_back->GetFrameContentPanel();
+	if ( !m_form || m_auimgr || content->GetChildren().IsEmpty() )
+	{
+		return false;
+	}
+
+	BuiltForm built;
+	built.form = m_form;
+	built.parking = new wxPanel( this );
+	built.parking->Hide();
+	built.sizer = content->GetSizer();
+	content->SetSizer( NULL, false );
+
+	// Reparenting changes the list of children
+	const wxWindowList& children = content->GetChildren();
+	std::vector< wxWindow* > windows;
+	for ( wxWindowList::const_iterator child = children.begin(); child != children.end(); ++child )
+	{
+		windows.push_back( *child );
+	}
+	for ( std::vector< wxWindow* >::iterator window = windows.begin(); window != windows.end(); ++window )
+	{
+		( *window )->Reparent( built.parking );
+	}
+
+	built.wxobjects.swap( m_wxobjects );
+	built.baseobjects.swap( m_baseobjects );
+	built.unbuiltPages.swap( m_unbuiltPages );
+	built.wizard = m_wizard;
+	m_wizard = NULL;
+
+	m_builtForms.push_front( built );
+	while ( m_builtForms.size() > MAX_BUILT_FORMS )
+	{
+		DestroyBuiltForm( m_builtForms.back() );
+		m_builtForms.pop_back();
+	}
+
+	return true;
+}
+
+/**
+* Shows the components of the selected form again, if they were parked.
+*
+* @return false if the form has to be built.
+*/
+bool VisualEditor::RestoreForm()
+{
+	std::list< BuiltForm >::iterator built = m_builtForms.begin();
+	while ( built != m_builtForms.end() && built->form.lock() != m_form )
+	{
+		++built;
+	}
+
+	if ( built == m_builtForms.end() )
+	{
+		return false;
+	}
+
+	wxWindow* content = m_back->GetFrameContentPanel();
+	const wxWindowList& children = built->parking->GetChildren();
+	std::vector< wxWindow* > windows;
+	for ( wxWindowList::const_iterator child = children.begin(); child != children.end(); ++child )
+	{
+		windows.push_back( *child );
+	}
+	for ( std::vector< wxWindow* >::iterator window = windows.begin(); window != windows.end(); ++window )
+	{
+		( *window )->Reparent( content );
+	}
+	content->SetSizer( built->sizer, false );
+
+	m_wxobjects.swap( built->wxobjects );
+	m_baseobjects.swap( built->baseobjects );
+	m_unbuiltPages.swap( built->unbuiltPages );
+	m_wizard = built->wizard;
+
+	built->parking->Destroy();
+	m_builtForms.erase( built );
+
+	return true;
+}
+
+/**
+* Destroys the components of a parked form, as Create() does for the shown form.
+*/
+void VisualEditor::DestroyBuiltForm( BuiltForm& built )
+{
+	// The clean up works on the current associations
+	m_wxobjects.swap( built.wxobjects );
+	m_baseobjects.swap( built.baseobjects );
+	std::swap( m_wizard, built.wizard );
+
+	DeleteAbstractObjects();
+	ClearWizard();
+	ClearComponents( built.parking );
+
+	m_wxobjects.swap( built.wxobjects );
+	m_baseobjects.swap( built.baseobjects );
+	std::swap( m_wizard, built.wizard );
+
+	built.parking->SetSizer( built.sizer );
+	built.parking->Destroy();
+}
+
+/**
+* Destroys the parked forms which could show an object as it was, all of them if the object is NULL.
+*/
+void VisualEditor::DropBuiltForms( PObjectBase obj )
+{
+	PObjectBase form = obj;
+	while ( form && form->GetParent() && form->GetParent()->GetObjectTypeName() != wxT("project") )
+	{
+		form = form->GetParent();
+	}
+
+	std::list< BuiltForm >::iterator built = m_builtForms.begin();
+	while ( built != m_builtForms.end() )
+	{
+		PObjectBase builtForm = built->form.lock();
+		if ( !obj || !builtForm || builtForm == form || built->baseobjects.count( obj.get() ) > 0 )
+		{
+			DestroyBuiltForm( *built );
+			built = m_builtForms.erase( built );
+		}
+		else
+		{
+			++built;
+		}
+	}
+}
+
+/**
+* Creates the children of the book pages holding the object, which were left empty because they were hidden.
+*/
+void VisualEditor::BuildPages( PObjectBase obj )
+{
+	if ( m_unbuiltPages.empty() )
+	{
+		return;
+	}
+
+	// A selected page shows its window
+	if ( IsBookPage( obj ) && obj->GetChildCount() > 0 )
+	{
+		obj = obj->GetChild( 0 );
+	}
+
+	// The outer pages first, the inner ones are not created before
+	std::vector< PObjectBase > ancestors;
+	for ( PObjectBase ancestor = obj; ancestor; ancestor = ancestor->GetParent() )
+	{
+		ancestors.push_back( ancestor );
+	}
+
+	for ( std::vector< PObjectBase >::reverse_iterator ancestor = ancestors.rbegin(); ancestor != ancestors.rend(); ++ancestor )
+	{
+		ObjectBaseMap::iterator it = m_baseobjects.find( ancestor->get() );
+		if ( it == m_baseobjects.end() )
+		{
+			continue;
+		}
+
+		// The children of a collapsible pane are created in its pane
+		wxWindow* window = wxDynamicCast( it->second, wxWindow );
+		wxCollapsiblePane* collpane = wxDynamicCast( it->second, wxCollapsiblePane );
+		if ( collpane )
+		{
+			window = collpane->GetPane();
+		}
+
+		UnbuiltPageMap::iterator page = m_unbuiltPages.find( window );
+		if ( page == m_unbuiltPages.end() )
+		{
+			continue;
+		}
+
+		PObjectBase pageObj = page->second;
+		m_unbuiltPages.erase( page );
+
+		try
+		{
+			for ( unsigned int i = 0; i < pageObj->GetChildCount(); i++ )
+			{
+				Generate( pageObj->GetChild( i ), window, window );
+			}
+		}
+		catch ( wxFBException& ex )
+		{
+			wxLogError ( ex.what() );
+		}
+
+		window->Layout();
+		window->Refresh();
+	}
+}
+
 /**
 * Generates wxObjects from ObjectBase
 *
@@ -791,10 +1144,17 @@ void VisualEditor::Generate( PObjectBase obj, wxWindow* wxparent, wxObject* pare
 	// New wxparent for the window's children
 	wxWindow* new_wxparent = ( createdWindow ? createdWindow : wxparent );
 
-	// Recursively generate the children
-	for ( unsigned int i = 0; i < obj->GetChildCount(); i++ )
+	// Recursively generate the children, those of the hidden book pages once they are shown
+	if ( createdWindow && IsHiddenPageWindow( obj ) )
 	{
-		Generate( obj->GetChild( i ), new_wxparent, createdObject );
+		m_unbuiltPages.insert( UnbuiltPageMap::value_type( new_wxparent, obj ) );
+	}
+	else
+	{
+		for ( unsigned int i = 0; i < obj->GetChildCount(); i++ )
+		{
+			Generate( obj->GetChild( i ), new_wxparent, createdObject );
+		}
 	}
 
 	comp->OnCreated( createdObject, wxparent );
@@ -1072,6 +1432,7 @@ void VisualEditor::PreventOnModified( bool prevent )
 
 void VisualEditor::OnProjectLoaded ( wxFBEvent &)
 {
+  DropBuiltForms( PObjectBase() );
   Create();
 }
 
@@ -1085,7 +1446,7 @@ void VisualEditor::OnObjectSelected( wxFBObjectEvent &event )
 	// It is only necessary to Create() if the selected object is on a different form
 	if ( AppData()->GetSelectedForm() != m_form )
 	{
-		Create();
+		Create( true );
 	}
 
 	// Get the ObjectBase from the event
@@ -1097,6 +1458,9 @@ void VisualEditor::OnObjectSelected( wxFBObjectEvent &event )
 		return;
 	}
 
+	// The object could be on a page not shown before
+	BuildPages( obj );
+
 	// highlight parent toolbar instead of its children
 	PObjectBase toolbar = obj->FindNearAncestor( wxT("toolbar") );
 	if( !toolbar ) toolbar = obj->FindNearAncestor( wxT("toolbar_form") );
@@ -1259,18 +1623,26 @@ void VisualEditor::OnObjectSelected( wxFBObjectEvent &event )
 	m_back->Refresh();
 }
 
-void VisualEditor::OnObjectCreated( wxFBObjectEvent &)
+void VisualEditor::OnObjectCreated( wxFBObjectEvent& event )
 {
+	DropBuiltForms( event.GetFBObject() );
 	Create();
 }
 
-void VisualEditor::OnObjectRemoved( wxFBObjectEvent & )
+void VisualEditor::OnObjectRemoved( wxFBObjectEvent& event )
 {
+	DropBuiltForms( event.GetFBObject() );
 	Create();
 }
 
-void VisualEditor::OnPropertyModified( wxFBPropertyEvent &)
+void VisualEditor::OnPropertyModified( wxFBPropertyEvent& event )
 {
+	PProperty prop = event.GetFBProperty();
+	if ( prop )
+	{
+		DropBuiltForms( prop->GetObject() );
+	}
+
 	if ( !m_stopModifiedEvent )
 	{
 		PObjectBase aux = m_back->GetSelectedObject();
@@ -1286,13 +1658,21 @@ void VisualEditor::OnPropertyModified( wxFBPropertyEvent &)
 
 void VisualEditor::OnProjectRefresh( wxFBEvent &)
 {
+	DropBuiltForms( PObjectBase() );
 	Create();
 }
 
-void VisualEditor::OnAuiScaner(wxTimerEvent&) {
+void VisualEditor::OnCodeGeneration( wxFBEvent &)
+{
+	// The forms are not changed by the code generation
+	Create();
+}
+
+void VisualEditor::OnAuiSync( wxTimerEvent& )
+{
 	if( m_auimgr )
 	{
-		ScanPanes( m_back->GetFrameContentPanel() );
+		SyncPanes();
 	}
 }
 
@@ -30,6 +30,9 @@
 #include "visualobj.h"
 
 #include <forms/wizard.h>
+
+#include <list>
+#include <unordered_map>
 /**
  * Extends the wxInnerFrame to show the object highlight
  */
@@ -90,12 +93,17 @@ class wxFBObjectEvent;
 class VisualEditor : public wxScrolledWindow
 {
  private:
-  typedef std::map< wxObject*, PObjectBase > wxObjectMap;
+  // Hashed, the plugins look objects up several times for each object created or selected
+  typedef std::unordered_map< wxObject*, PObjectBase > wxObjectMap;
   wxObjectMap m_wxobjects;
 
-  typedef std::map< ObjectBase*, wxObject* > ObjectBaseMap;
+  typedef std::unordered_map< ObjectBase*, wxObject* > ObjectBaseMap;
   ObjectBaseMap m_baseobjects;
 
+  // Windows of the hidden book pages whose children are not created yet
+  typedef std::map< wxWindow*, PObjectBase > UnbuiltPageMap;
+  UnbuiltPageMap m_unbuiltPages;
+
   DesignerWindow *m_back;
   wxPanel *m_auipanel;
 
@@ -107,23 +115,43 @@ class VisualEditor : public wxScrolledWindow
   // Prevent OnModified in components
   bool m_stopModifiedEvent;
 
-  // aui scan timer
-  wxTimer m_AuiScaner;
+  // Restarted by each change of the aui panes, the model is updated when it expires
+  wxTimer m_auiSyncTimer;
+
+  // Components of a form shown before, kept on a hidden panel
+  struct BuiltForm
+  {
+    WPObjectBase form;
+    wxPanel* parking;
+    wxSizer* sizer;
+    wxObjectMap wxobjects;
+    ObjectBaseMap baseobjects;
+    UnbuiltPageMap unbuiltPages;
+    Wizard* wizard;
+  };
+  std::list< BuiltForm > m_builtForms; // most recently shown first
+
+  void BuildForm();
+  bool ParkForm();
+  bool RestoreForm();
+  void DestroyBuiltForm( BuiltForm& built );
+  void DropBuiltForms( PObjectBase obj );
 
   DECLARE_EVENT_TABLE()
 
  protected:
   void Generate( PObjectBase obj, wxWindow* parent, wxObject* parentObject );
+  void BuildPages( PObjectBase obj );
   void SetupWindow( PObjectBase obj, wxWindow* window );
   void SetupSizer( PObjectBase obj, wxSizer* sizer );
-  void Create();
+  void Create( bool keepBuilt = false );
   void DeleteAbstractObjects();
 
   void ClearAui();
   void SetupAui( PObjectBase obj, wxWindow* window );
-  void ScanPanes( wxWindow* parent );
+  void SyncPanes();
 
-  void OnAuiScaner(wxTimerEvent& event);
+  void OnAuiSync( wxTimerEvent& event );
 
     void ClearWizard();
     void SetupWizard( PObjectBase obj, wxWindow* window, bool pageAdding = false );
@@ -142,6 +170,17 @@ class VisualEditor : public wxScrolledWindow
   PObjectBase GetObjectBase( wxObject* wxobject );
   wxObject* GetWxObject( PObjectBase baseobject );
 
+  // As GetWxObject(), without logging the objects not created
+  wxObject* FindWxObject( ObjectBase* baseobject ) const;
+
+  // For the memory report: the widgets of the form shown, and those kept built for the forms recently shown
+  size_t GetWxObjectCount() const { return m_wxobjects.size(); }
+  size_t GetBuiltFormCount() const { return m_builtForms.size(); }
+  size_t GetBuiltFormWxObjectCount() const;
+  size_t GetUnbuiltPageCount() const { return m_unbuiltPages.size(); }
+  // Estimated bytes of the widgets and of the maps linking them to the objects, without the native resources
+  size_t GetMemorySize() const;
+
   //AUI
   wxAuiManager *m_auimgr;
 
@@ -159,6 +198,7 @@ class VisualEditor : public wxScrolledWindow
   void OnObjectRemoved ( wxFBObjectEvent &event );
   void OnPropertyModified ( wxFBPropertyEvent &event );
   void OnProjectRefresh ( wxFBEvent &event);
+  void OnCodeGeneration ( wxFBEvent &event);
 };
 
 #endif //__VISUAL_EDITOR__
@@ -30,18 +30,13 @@ GenInheritedClassDlg::GenInheritedClassDlg( wxWindow* parent, PObjectBase projec
 :
 GenInheritedClassDlgBase( parent )
 {
-	const wxString& projectName = project->GetPropertyAsString( _("name") );
-
 	// Setup the initial values for the maps of class names and file names.
-	for ( unsigned int i = 0; i < project->GetChildCount(); ++i )
-	{
-		PObjectBase child = project->GetChild( i );
-		const wxString& formName = child->GetPropertyAsString( _("name") );
-		const wxString& name = projectName + formName;
-		m_classDetails.push_back( GenClassDetails( child, name, name ) );
+	GetDefaultClasses( project, &m_classDetails );
 
-		// Add the forms to the listctrl.
-		m_formsCheckList->AppendString( formName );
+	// Add the forms to the listctrl.
+	for ( size_t i = 0; i < m_classDetails.size(); ++i )
+	{
+		m_formsCheckList->AppendString( m_classDetails[i].m_form->GetPropertyAsString( _("name") ) );
 	}
 
 	// Disable the controls till the check listbox is selected.
@@ -49,6 +44,18 @@ GenInheritedClassDlgBase( parent )
 	m_fileNameTextCtrl->Disable();
 }
 
+void GenInheritedClassDlg::GetDefaultClasses( PObjectBase project, std::vector< GenClassDetails >* classes )
+{
+	const wxString& projectName = project->GetPropertyAsString( _("name") );
+
+	for ( unsigned int i = 0; i < project->GetChildCount(); ++i )
+	{
+		PObjectBase child = project->GetChild( i );
+		const wxString& name = projectName + child->GetPropertyAsString( _("name") );
+		classes->push_back( GenClassDetails( child, name, name ) );
+	}
+}
+
 void GenInheritedClassDlg::GetFormsSelected( std::vector< GenClassDetails >* forms )
 {
 	// Clear the selected forms array.
@@ -73,6 +73,9 @@ public:
 	GenInheritedClassDlg( wxWindow* parent, PObjectBase project );
 	void GetFormsSelected( std::vector< GenClassDetails >* forms );
 
+	/** Gets a class for every form of the project, named after the project and the form, as proposed by the dialog. */
+	static void GetDefaultClasses( PObjectBase project, std::vector< GenClassDetails >* classes );
+
 private:
 	std::vector< GenClassDetails > m_classDetails;
 
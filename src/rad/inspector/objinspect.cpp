@@ -1215,6 +1215,48 @@ void ObjectInspector::OnPropertyGridItemSelected( wxPropertyGridEvent& event )
 	}
 }
 
+void ObjectInspector::SelectProperty( PProperty prop )
+{
+	for ( ObjInspectorPropertyMap::iterator it = m_propMap.begin(); it != m_propMap.end(); ++it )
+	{
+		if ( it->second == prop )
+		{
+			ShowItem( m_pg, it->first, wxT("Properties") );
+			return;
+		}
+	}
+}
+
+void ObjectInspector::SelectEvent( PEvent event )
+{
+	for ( ObjInspectorEventMap::iterator it = m_eventMap.begin(); it != m_eventMap.end(); ++it )
+	{
+		if ( it->second == event )
+		{
+			ShowItem( m_eg, it->first, wxT("Events") );
+			return;
+		}
+	}
+}
+
+void ObjectInspector::ShowItem( wxPropertyGridManager* pg, wxPGProperty* item, const wxString& pageName )
+{
+	m_nb->SetSelection( ( pg == m_pg ? 0 : 1 ) );
+
+	// With the multipage style the item can be in another page
+	int pageIndex = pg->GetPageByState( item->GetParentState() );
+	if ( wxNOT_FOUND != pageIndex && pageIndex != pg->GetSelectedPage() )
+	{
+		pg->SelectPage( pageIndex );
+	}
+
+	pg->EnsureVisible( item );
+	pg->SelectProperty( item, true );
+
+	m_strSelPropItem = pg->GetPropertyName( item );
+	m_pageName = pageName;
+}
+
 void ObjectInspector::RestoreLastSelectedPropItem()
 {
 	if( m_pageName == wxT("Properties") )
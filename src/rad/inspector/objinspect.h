@@ -147,6 +147,7 @@ private:
 	void OnBitmapPropertyChanged( wxCommandEvent& event );
 
 	void RestoreLastSelectedPropItem();
+	void ShowItem( wxPropertyGridManager* pg, wxPGProperty* item, const wxString& pageName );
 
 	void ModifyProperty( PProperty prop, const wxString& str );
 
@@ -161,6 +162,12 @@ public:
     void OnPropertyModified( wxFBPropertyEvent& event );
     void OnEventHandlerModified( wxFBEventHandlerEvent& event );
 
+    /**
+     * Selects the item of a property or event of the current selection, switching to its page.
+     */
+    void SelectProperty( PProperty prop );
+    void SelectEvent( PEvent event );
+
     void AutoGenerateId( PObjectBase objectChanged, PProperty propChanged, wxString reason );
     wxPropertyGridManager* CreatePropertyGridManager( wxWindow *parent, wxWindowID id );
     void SavePosition();
@@ -38,6 +38,7 @@
 #include "../../model/objectbase.h"
 
 #include "../../codegen/codewriter.h"
+#include "../../codegen/generationcache.h"
 #include "../../codegen/luacg.h"
 
 #include <wx/fdrepdlg.h>
@@ -59,7 +60,8 @@ END_EVENT_TABLE()
 
 LuaPanel::LuaPanel( wxWindow *parent, int id )
 :
-wxPanel( parent, id )
+wxPanel( parent, id ),
+m_stale( false )
 {
 	AppData()->AddHandler( this->GetEventHandler() );
 	wxBoxSizer *top_sizer = new wxBoxSizer( wxVERTICAL );
@@ -155,12 +157,27 @@ void LuaPanel::OnEventHandlerModified( wxFBEventHandlerEvent& event )
 	OnCodeGeneration( event );
 }
 
+void LuaPanel::GenerateIfStale()
+{
+	// A single generation catches up with all the changes made while the panel was not visible
+	if ( m_stale )
+	{
+		wxFBEvent event( wxEVT_FB_CODE_GENERATION );
+		event.SetId( 1 );
+		OnCodeGeneration( event );
+	}
+}
+
 void LuaPanel::OnCodeGeneration( wxFBEvent& event )
 {
     PObjectBase objectToGenerate;
 
-	// Generate code in the panel if the panel is active
-	bool doPanel = IsShown();
+	// Generate code in the panel if it is the visible page, otherwise once it is selected
+	bool doPanel = CodeEditor::IsPanelVisible( this );
+	if ( !doPanel )
+	{
+		m_stale = true;
+	}
 
 	// Using the previously unused Id field in the event to carry a boolean
 	bool panelOnly = ( event.GetId() != 0 );
@@ -282,20 +299,14 @@ void LuaPanel::OnCodeGeneration( wxFBEvent& event )
 
 		Freeze();
 
-        wxStyledTextCtrl* luaEditor = m_luaPanel->GetTextCtrl();
-		luaEditor->SetReadOnly( false );
-		int luaLine = luaEditor->GetFirstVisibleLine() + luaEditor->LinesOnScreen() - 1;
-		int luaXOffset = luaEditor->GetXOffset();
-
 		codegen.GenerateCode( project );
 
-		luaEditor->SetReadOnly( true );
-		luaEditor->GotoLine( luaLine );
-		luaEditor->SetXOffset( luaXOffset );
-		luaEditor->SetAnchor( 0 );
-		luaEditor->SetCurrentPos( 0 );
+		// Only the changed lines are replaced, so the view keeps its position
+		m_luaCW->Flush();
 
 		Thaw();
+
+		m_stale = false;
 	}
 
 	// Generate code in the file
@@ -303,43 +314,62 @@ void LuaPanel::OnCodeGeneration( wxFBEvent& event )
 	{
 		try
 		{
-			LuaCodeGenerator codegen;
-			codegen.UseRelativePath( useRelativePath, path );
-
-			if ( pFirstID )
+			// Skip the generation when nothing it depends on changed
+			GenerationCache cache( path, file );
+			wxArrayString outputs;
+			outputs.Add( path + file + wxT( ".lua" ) );
+			const wxString cacheKey = GenerationCache::ComputeKey( project, wxT("Lua") );
+			if ( cache.IsUpToDate( wxT("Lua"), cacheKey, outputs ) )
 			{
-				codegen.SetFirstID( firstID );
+				wxLogStatus( wxT( "Code on \'%s\' is up to date." ), path.c_str() );
+				return;
 			}
 
-			// Determin if Microsoft BOM should be used
-			bool useMicrosoftBOM = false;
+			{
+				LuaCodeGenerator codegen;
+				codegen.UseRelativePath( useRelativePath, path );
 
-			PProperty pUseMicrosoftBOM = project->GetProperty( wxT( "use_microsoft_bom" ) );
+				if ( pFirstID )
+				{
+					codegen.SetFirstID( firstID );
+				}
 
-			if ( pUseMicrosoftBOM )
-			{
-				useMicrosoftBOM = ( pUseMicrosoftBOM->GetValueAsInteger() != 0 );
-			}
+				// Determin if Microsoft BOM should be used
+				bool useMicrosoftBOM = false;
 
-			// Determine if Utf8 or Ansi is to be created
-			bool useUtf8 = false;
-			PProperty pUseUtf8 = project->GetProperty( _("encoding") );
+				PProperty pUseMicrosoftBOM = project->GetProperty( wxT( "use_microsoft_bom" ) );
 
-			if ( pUseUtf8 )
-			{
-				useUtf8 = ( pUseUtf8->GetValueAsString() != wxT("ANSI") );
-			}
+				if ( pUseMicrosoftBOM )
+				{
+					useMicrosoftBOM = ( pUseMicrosoftBOM->GetValueAsInteger() != 0 );
+				}
 
-			PCodeWriter lua_cw( new FileCodeWriter( path + file + wxT( ".lua" ), useMicrosoftBOM, useUtf8 ) );
+				// Determine if Utf8 or Ansi is to be created
+				bool useUtf8 = false;
+				PProperty pUseUtf8 = project->GetProperty( _("encoding") );
 
-			codegen.SetSourceWriter( lua_cw );
-			codegen.GenerateCode( project );
-			wxLogStatus( wxT( "Code generated on \'%s\'." ), path.c_str() );
+				if ( pUseUtf8 )
+				{
+					useUtf8 = ( pUseUtf8->GetValueAsString() != wxT("ANSI") );
+				}
+
+				PCodeWriter lua_cw( new FileCodeWriter( path + file + wxT( ".lua" ), useMicrosoftBOM, useUtf8 ) );
+
+				codegen.SetSourceWriter( lua_cw );
+				codegen.GenerateCode( project );
+				wxLogStatus( wxT( "Code generated on \'%s\'." ), path.c_str() );
+
+				// check if we have to convert to ANSI encoding
+				if (project->GetPropertyAsString(wxT("encoding")) == wxT("ANSI"))
+				{
+					UTF8ToAnsi(path + file + wxT( ".lua" ));
+				}
+			}
 
-			// check if we have to convert to ANSI encoding
-			if (project->GetPropertyAsString(wxT("encoding")) == wxT("ANSI"))
+			// The files are written when the writers are destroyed
+			if ( FileCodeWriter::WaitForPendingWrites() )
 			{
-				UTF8ToAnsi(path + file + wxT( ".lua" ));
+				cache.Store( wxT("Lua"), cacheKey, outputs );
 			}
 		}
 		catch ( wxFBException& ex )
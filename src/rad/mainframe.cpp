@@ -25,6 +25,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "mainframe.h"
 
+#include "../codegen/templateprofile.h"
 #include "../model/xrcfilter.h"
 #include "../utils/stringutils.h"
 #include "../utils/wxfbexception.h"
@@ -37,9 +38,11 @@
 #include "geninheritclass/geninhertclass.h"
 #include "inspector/objinspect.h"
 #include "luapanel/luapanel.h"
+#include "memoryreport.h"
 #include "objecttree/objecttree.h"
 #include "palette.h"
 #include "phppanel/phppanel.h"
+#include "projectsearch/projectsearch.h"
 #include "pythonpanel/pythonpanel.h"
 #include "title.h"
 #include "wx/config.h"
@@ -47,6 +50,8 @@
 #include "wxfbmanager.h"
 #include "xrcpanel/xrcpanel.h"
 
+#include <wx/numdlg.h>
+
 enum
 {
 	ID_SAVE_PRJ = wxID_HIGHEST + 1,
@@ -88,15 +93,19 @@ enum
 
 	ID_PREVIEW_XRC,
 	ID_GEN_INHERIT_CLS,
+	ID_PROFILE_TEMPLATES,
+	ID_MEMORY_REPORT,
 
 	// The preference dialog must use wxID_PREFERENCES for wxMAC
 	//ID_SETTINGS_GLOBAL, // For the future preference dialogs
 	ID_SETTINGS_PROJ, // For the future preference dialogs
 
 	ID_FIND,
+	ID_FIND_IN_PROJECT,
 
 	ID_CLIPBOARD_COPY,
 	ID_CLIPBOARD_PASTE,
+	ID_DUPLICATE,
 
 	//added by tyysoft to define the swap button ID.
 	ID_WINDOW_SWAP,
@@ -139,8 +148,11 @@ EVT_MENU( ID_ALIGN_CENTER_V, MainFrame::OnChangeAlignment )
 EVT_MENU_RANGE( ID_BORDER_LEFT, ID_BORDER_BOTTOM, MainFrame::OnChangeBorder )
 EVT_MENU( ID_PREVIEW_XRC, MainFrame::OnXrcPreview )
 EVT_MENU( ID_GEN_INHERIT_CLS, MainFrame::OnGenInhertedClass )
+EVT_MENU( ID_PROFILE_TEMPLATES, MainFrame::OnProfileTemplates )
+EVT_MENU( ID_MEMORY_REPORT, MainFrame::OnMemoryReport )
 EVT_MENU( ID_CLIPBOARD_COPY, MainFrame::OnClipboardCopy )
 EVT_MENU( ID_CLIPBOARD_PASTE, MainFrame::OnClipboardPaste )
+EVT_MENU( ID_DUPLICATE, MainFrame::OnDuplicate )
 EVT_MENU( ID_WINDOW_SWAP, MainFrame::OnWindowSwap )
 
 EVT_UPDATE_UI( ID_CLIPBOARD_PASTE, MainFrame::OnClipboardPasteUpdateUI )
@@ -158,6 +170,7 @@ EVT_FB_PROPERTY_MODIFIED( MainFrame::OnPropertyModified )
 EVT_FB_EVENT_HANDLER_MODIFIED( MainFrame::OnEventHandlerModified )
 
 EVT_MENU( ID_FIND, MainFrame::OnFindDialog )
+EVT_MENU( ID_FIND_IN_PROJECT, MainFrame::OnFindInProject )
 EVT_FIND( wxID_ANY, MainFrame::OnFind )
 EVT_FIND_NEXT( wxID_ANY, MainFrame::OnFind )
 EVT_FIND_CLOSE( wxID_ANY, MainFrame::OnFindClose )
@@ -209,7 +222,8 @@ m_page_selection( 0 ),
 m_rightSplitter_sash_pos( 300 ),
 m_autoSash( false ), // autosash function is temporarily disabled due to possible bug(?) in wxMSW event system (workaround is needed)
 m_findData( wxFR_DOWN ),
-m_findDialog( NULL )
+m_findDialog( NULL ),
+m_projectSearch( NULL )
 {
 
 	// initialize the splitters, wxAUI doesn't use them
@@ -354,6 +368,7 @@ m_findDialog( NULL )
 	Connect( wxEVT_IDLE, wxIdleEventHandler( MainFrame::OnIdle ) );
 
 	m_notebook->Connect( wxEVT_COMMAND_AUINOTEBOOK_PAGE_CHANGED, wxAuiNotebookEventHandler( MainFrame::OnAuiNotebookPageChanged ), NULL, this );
+	Connect( wxEVT_ACTIVATE, wxActivateEventHandler( MainFrame::OnActivate ) );
 
 }
 
@@ -361,6 +376,7 @@ m_findDialog( NULL )
 MainFrame::~MainFrame()
 {
 	m_notebook->Disconnect( wxEVT_COMMAND_AUINOTEBOOK_PAGE_CHANGED, wxAuiNotebookEventHandler( MainFrame::OnAuiNotebookPageChanged ), NULL, this );
+	Disconnect( wxEVT_ACTIVATE, wxActivateEventHandler( MainFrame::OnActivate ) );
 
 #ifdef __WXMAC__
     // work around problem on wxMac
@@ -515,7 +531,7 @@ void MainFrame::OnSaveProject( wxCommandEvent &event )
 void MainFrame::OnSaveAsProject( wxCommandEvent & )
 {
 	wxFileDialog *dialog = new wxFileDialog( this, wxT( "Save Project" ), m_currentDir,
-	                       wxT( "" ), wxT( "wxFormBuilder Project File (*.fbp)|*.fbp|All files (*.*)|*.*" ), wxFD_SAVE );
+	                       wxT( "" ), wxT( "wxFormBuilder Project File (*.fbp)|*.fbp|wxFormBuilder Binary Project File (*.fbpb)|*.fbpb|All files (*.*)|*.*" ), wxFD_SAVE );
 
 	if ( dialog->ShowModal() == wxID_OK )
 	{
@@ -527,7 +543,7 @@ void MainFrame::OnSaveAsProject( wxCommandEvent & )
 
 		if ( !file.HasExt() )
 		{
-			file.SetExt( wxT( "fbp" ) );
+			file.SetExt( dialog->GetFilterIndex() == 1 ? wxT( "fbpb" ) : wxT( "fbp" ) );
 			filename = file.GetFullPath();
 		}
 
@@ -562,7 +578,7 @@ void MainFrame::OnOpenProject( wxCommandEvent &)
 		return;
 
 	wxFileDialog *dialog = new wxFileDialog( this, wxT( "Open Project" ), m_currentDir,
-	                       wxT( "" ), wxT( "wxFormBuilder Project File (*.fbp)|*.fbp|All files (*.*)|*.*" ), wxFD_OPEN );
+	                       wxT( "" ), wxT( "wxFormBuilder Project File (*.fbp;*.fbpb)|*.fbp;*.fbpb|All files (*.*)|*.*" ), wxFD_OPEN );
 
 	if ( dialog->ShowModal() == wxID_OK )
 	{
@@ -616,13 +632,10 @@ void MainFrame::OnImportXrc( wxCommandEvent &)
 
 		try
 		{
-			ticpp::Document doc;
-			XMLUtils::LoadXMLFile( doc, false, dialog->GetPath() );
-
 			XrcLoader xrc;
 			xrc.SetObjectDatabase( AppData()->GetObjectDatabase() );
 
-			PObjectBase project = xrc.GetProject( &doc );
+			PObjectBase project = xrc.GetProject( dialog->GetPath() );
 
 			if ( project )
 			{
@@ -991,6 +1004,8 @@ void MainFrame::UpdateFrame()
 	menuEdit->Enable( ID_DELETE, copy );
 	toolbar->EnableTool( ID_DELETE, copy );
 
+	menuEdit->Enable( ID_DUPLICATE, copy );
+
 	menuEdit->Enable( ID_MOVE_UP, copy );
 	menuEdit->Enable( ID_MOVE_DOWN, copy );
 	menuEdit->Enable( ID_MOVE_LEFT, copy );
@@ -1121,6 +1136,22 @@ void MainFrame::OnPaste ( wxCommandEvent &)
 	}
 }
 
+void MainFrame::OnDuplicate( wxCommandEvent& )
+{
+	PObjectBase obj = AppData()->GetSelectedObject();
+	if ( !obj )
+	{
+		return;
+	}
+
+	long count = wxGetNumberFromUser( _("Number of copies to insert after the selected object:"), _("Copies:"), _("Duplicate"), 1, 1, 1000, this );
+	if ( count > 0 )
+	{
+		AppData()->DuplicateObject( obj, (unsigned int)count );
+		UpdateFrame();
+	}
+}
+
 void MainFrame::OnClipboardCopy(wxCommandEvent& )
 {
 	AppData()->CopyObjectToClipboard( AppData()->GetSelectedObject() );
@@ -1279,15 +1310,37 @@ void MainFrame::OnGenInhertedClass( wxCommandEvent& WXUNUSED( e ) )
 	std::vector< GenClassDetails > selectedForms;
 	dlg.GetFormsSelected( &selectedForms );
 
-	for ( size_t i = 0; i < selectedForms.size(); ++i )
+	// Create the classes and files.
+	AppData()->GenerateInheritedClasses( selectedForms, filePath );
+
+	wxMessageBox( wxString::Format( wxT( "Class(es) generated to \'%s\'." ), filePath.c_str() ), wxT("wxFormBuilder") );
+}
+
+void MainFrame::OnProfileTemplates( wxCommandEvent& e )
+{
+	// The counters start over each time the profiling is enabled
+	TemplateProfile::Enable( e.IsChecked() );
+	if ( e.IsChecked() )
 	{
-		const GenClassDetails& details = selectedForms[i];
+		return;
+	}
 
-		// Create the class and files.
-		AppData()->GenerateInheritedClass( details.m_form, details.m_className, filePath, details.m_fileName );
+	wxFileDialog dialog( this, wxT( "Save Template Profile" ), m_currentDir, wxT( "templates.csv" ),
+	                     wxT( "CSV files (*.csv)|*.csv|JSON files (*.json)|*.json" ), wxFD_SAVE | wxFD_OVERWRITE_PROMPT );
+	if ( dialog.ShowModal() == wxID_OK )
+	{
+		TemplateProfile::WriteReport( dialog.GetPath() );
 	}
+}
 
-	wxMessageBox( wxString::Format( wxT( "Class(es) generated to \'%s\'." ), filePath.c_str() ), wxT("wxFormBuilder") );
+void MainFrame::OnMemoryReport( wxCommandEvent& )
+{
+	wxFileDialog dialog( this, wxT( "Save Memory Report" ), m_currentDir, wxT( "memory.json" ),
+	                     wxT( "JSON files (*.json)|*.json" ), wxFD_SAVE | wxFD_OVERWRITE_PROMPT );
+	if ( dialog.ShowModal() == wxID_OK )
+	{
+		MemoryReport::Write( MemoryReport::Build( m_visualEdit ), dialog.GetPath() );
+	}
 }
 
 bool MainFrame::SaveWarning()
@@ -1437,7 +1490,42 @@ void MainFrame::OnAuiNotebookPageChanged( wxAuiNotebookEvent& event )
 		}
 	}
 
-	AppData()->GenerateCode( true );
+	GenerateStaleCodePanel();
+}
+
+void MainFrame::OnActivate( wxActivateEvent& event )
+{
+	if ( event.GetActive() )
+	{
+		GenerateStaleCodePanel();
+	}
+	event.Skip();
+}
+
+void MainFrame::GenerateStaleCodePanel()
+{
+	// The panels which are not visible only remember that the project changed
+	wxWindow* page = m_notebook->GetCurrentPage();
+	if ( page == m_cpp )
+	{
+		m_cpp->GenerateIfStale();
+	}
+	else if ( page == m_python )
+	{
+		m_python->GenerateIfStale();
+	}
+	else if ( page == m_php )
+	{
+		m_php->GenerateIfStale();
+	}
+	else if ( page == m_lua )
+	{
+		m_lua->GenerateIfStale();
+	}
+	else if ( page == m_xrc )
+	{
+		m_xrc->GenerateIfStale();
+	}
 }
 
 void MainFrame::OnFindDialog( wxCommandEvent& )
@@ -1450,6 +1538,16 @@ void MainFrame::OnFindDialog( wxCommandEvent& )
 	m_findDialog->Show( true );
 }
 
+void MainFrame::OnFindInProject( wxCommandEvent& )
+{
+	if ( NULL == m_projectSearch )
+	{
+		m_projectSearch = new ProjectSearchDialog( this, m_objInsp );
+		m_projectSearch->Centre( wxCENTRE_ON_SCREEN | wxBOTH );
+	}
+	m_projectSearch->Popup();
+}
+
 void MainFrame::OnFindClose( wxFindDialogEvent& )
 {
 	m_findDialog->Destroy();
@@ -1499,6 +1597,7 @@ wxMenuBar * MainFrame::CreateFBMenuBar()
 	menuEdit->Append( ID_CUT, wxT( "Cut \tCtrl+X" ), wxT( "Cut selected object" ) );
 	menuEdit->Append( ID_PASTE, wxT( "&Paste \tCtrl+V" ), wxT( "Paste on selected object" ) );
 	menuEdit->Append( ID_DELETE, wxT( "&Delete \tCtrl+D" ), wxT( "Delete selected object" ) );
+	menuEdit->Append( ID_DUPLICATE, wxT( "D&uplicate...\tCtrl+Shift+D" ), wxT( "Insert copies of the selected object after it" ) );
 	menuEdit->AppendSeparator();
 	menuEdit->Append( ID_CLIPBOARD_COPY, wxT("Copy Object To Clipboard\tCtrl+Shift+C"), wxT("Copy Object to Clipboard") );
 	menuEdit->Append( ID_CLIPBOARD_PASTE, wxT("Paste Object From Clipboard\tCtrl+Shift+V"), wxT("Paste Object from Clipboard") );
@@ -1511,6 +1610,7 @@ wxMenuBar * MainFrame::CreateFBMenuBar()
 	menuEdit->Append( ID_MOVE_RIGHT, wxT( "Move Right\tAlt+Right" ), wxT( "Move Right selected object" ) );
 	menuEdit->AppendSeparator();
 	menuEdit->Append( ID_FIND, wxT( "&Find\tCtrl+F" ), wxT( "Find text in the active code viewer" ) );
+	menuEdit->Append( ID_FIND_IN_PROJECT, wxT( "Find in &Project...\tCtrl+Shift+F" ), wxT( "Find objects, property values and event handlers in the project" ) );
 	menuEdit->AppendSeparator();
 	menuEdit->Append( ID_ALIGN_LEFT,     wxT( "&Align &Left\tAlt+Shift+Left" ),           wxT( "Align item to the left" ) );
 	menuEdit->Append( ID_ALIGN_CENTER_H, wxT( "&Align Center &Horizontal\tAlt+Shift+H" ), wxT( "Align item to the center horizontally" ) );
@@ -1526,6 +1626,9 @@ wxMenuBar * MainFrame::CreateFBMenuBar()
 
 	wxMenu *menuTools = new wxMenu;
 	menuTools->Append( ID_GEN_INHERIT_CLS, wxT( "&Generate Inherited Class\tF6" ), wxT( "Creates the needed files and class for proper inheritance of your designed GUI" ) );
+	menuTools->AppendSeparator();
+	menuTools->AppendCheckItem( ID_PROFILE_TEMPLATES, wxT( "&Profile Code Templates" ), wxT( "Count the time spent in each code template, the report is saved when unchecked" ) );
+	menuTools->Append( ID_MEMORY_REPORT, wxT( "Save &Memory Report..." ), wxT( "Save the estimated memory of the project, the undo history, the designer and the caches" ) );
 
 	wxMenu *menuHelp = new wxMenu;
 	menuHelp->Append( wxID_ABOUT, wxT( "&About...\tF1" ), wxT( "Show about dialog" ) );
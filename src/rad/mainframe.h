@@ -45,6 +45,7 @@ class ObjectTree;
 class ObjectInspector;
 class wxFbPalette;
 class VisualEditor;
+class ProjectSearchDialog;
 
 const char* const VERSION = "3.9.0";
 
@@ -99,12 +100,17 @@ class MainFrame : public wxFrame
   void OnOpenRecent(wxCommandEvent &event);
   void UpdateLayoutTools();
 
+  // Lets the selected language panel catch up with the changes made while it was not visible
+  void GenerateStaleCodePanel();
+
   // Used to correctly restore splitter position
   void OnIdle( wxIdleEvent& );
 
   wxFindReplaceData m_findData;
   wxFindReplaceDialog* m_findDialog;
 
+  ProjectSearchDialog* m_projectSearch;
+
   // Used to force propgrid to save on lost focus
   wxEvtHandler* m_focusKillEvtHandler;
 
@@ -129,6 +135,7 @@ class MainFrame : public wxFrame
   void OnPaste (wxCommandEvent &event);
   void OnCut (wxCommandEvent &event);
   void OnDelete (wxCommandEvent &event);
+  void OnDuplicate( wxCommandEvent& event );
   void OnClipboardCopy(wxCommandEvent& e);
   void OnClipboardPaste(wxCommandEvent& e);
   void OnClipboardPasteUpdateUI( wxUpdateUIEvent& e );
@@ -142,9 +149,12 @@ class MainFrame : public wxFrame
   void OnChangeBorder(wxCommandEvent& e);
   void OnXrcPreview(wxCommandEvent& e);
   void OnGenInhertedClass(wxCommandEvent& e);
+  void OnProfileTemplates(wxCommandEvent& e);
+  void OnMemoryReport(wxCommandEvent& e);
   void OnWindowSwap(wxCommandEvent& e);
 
   void OnAuiNotebookPageChanged( wxAuiNotebookEvent& event );
+  void OnActivate( wxActivateEvent& event );
 
   void OnProjectLoaded( wxFBEvent& event );
   void OnProjectSaved( wxFBEvent& event );
@@ -172,6 +182,7 @@ class MainFrame : public wxFrame
   void CreateClassicGui();
 
   void OnFindDialog( wxCommandEvent& event );
+  void OnFindInProject( wxCommandEvent& event );
   void OnFind( wxFindDialogEvent& event );
   void OnFindClose( wxFindDialogEvent& event );
 
@@ -0,0 +1,249 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "memoryreport.h"
+
+#include "../model/database.h"
+#include "../model/objectarena.h"
+#include "../model/objectbase.h"
+#include "../model/searchindex.h"
+#include "../utils/internedstring.h"
+#include "../utils/stringutils.h"
+#include "appdata.h"
+#include "designer/visualeditor.h"
+
+#include <wx/ffile.h>
+#include <wx/log.h>
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace
+{
+	// Links of a map node, or control block of a shared_ptr
+	const size_t NODE_OVERHEAD = 4 * sizeof( void* );
+
+	struct ClassUsage
+	{
+		size_t objects = 0;
+		size_t properties = 0;
+		size_t events = 0;
+		size_t bytes = 0;
+	};
+
+	struct ValueUsage
+	{
+		size_t count = 0;
+		std::set< const std::string* > distinct;
+		size_t bytes = 0;
+	};
+
+	size_t GetObjectSize( PObjectBase obj )
+	{
+		return sizeof( ObjectBase ) + NODE_OVERHEAD + sizeof( PObjectBase ) +
+			obj->GetPropertyMap().size() * ( sizeof( Property ) + sizeof( PropertyMap::value_type ) + 2 * NODE_OVERHEAD ) +
+			obj->GetEventMap().size() * ( sizeof( Event ) + sizeof( EventMap::value_type ) + 2 * NODE_OVERHEAD );
+	}
+
+	void AddValue( const InternedString& value, ValueUsage* usage, std::set< const std::string* >* distinct, size_t* bytes )
+	{
+		if ( value.empty() )
+		{
+			return;
+		}
+
+		++usage->count;
+
+		const size_t size = value.GetStorageSize() + NODE_OVERHEAD;
+		if ( usage->distinct.insert( &value.GetUTF8() ).second )
+		{
+			usage->bytes += size;
+		}
+		if ( distinct->insert( &value.GetUTF8() ).second )
+		{
+			*bytes += size;
+		}
+	}
+
+	class Collector
+	{
+	public:
+		std::map< wxString, ClassUsage > classes;
+		std::map< wxString, ValueUsage > values;
+		std::set< const std::string* > distinct;
+		size_t objects = 0;
+		size_t objectBytes = 0;
+		size_t valueBytes = 0;
+
+		void Collect( PObjectBase obj, PObjectDatabase database )
+		{
+			ClassUsage& usage = classes[ obj->GetClassName() ];
+			const size_t size = GetObjectSize( obj );
+			++usage.objects;
+			usage.properties += obj->GetPropertyMap().size();
+			usage.events += obj->GetEventMap().size();
+			usage.bytes += size;
+			++objects;
+			objectBytes += size;
+
+			const PropertyMap& properties = obj->GetPropertyMap();
+			for ( PropertyMap::const_iterator prop = properties.begin(); prop != properties.end(); ++prop )
+			{
+				AddValue( prop->second->GetInternedValue(), &values[ database->GetPropertyTypeName( prop->second->GetType() ) ],
+					&distinct, &valueBytes );
+			}
+
+			const EventMap& events = obj->GetEventMap();
+			for ( EventMap::const_iterator event = events.begin(); event != events.end(); ++event )
+			{
+				AddValue( event->second->GetInternedValue(), &values[ wxT("event") ], &distinct, &valueBytes );
+			}
+
+			for ( unsigned int i = 0; i < obj->GetChildCount(); ++i )
+			{
+				Collect( obj->GetChild( i ), database );
+			}
+		}
+	};
+
+	wxString Number( size_t value )
+	{
+		return wxString::Format( wxT("%llu"), (unsigned long long)value );
+	}
+
+	template < class Usage >
+	std::vector< std::pair< wxString, Usage > > SortByBytes( const std::map< wxString, Usage >& usages )
+	{
+		std::vector< std::pair< wxString, Usage > > sorted( usages.begin(), usages.end() );
+		std::stable_sort( sorted.begin(), sorted.end(), []( const std::pair< wxString, Usage >& a, const std::pair< wxString, Usage >& b )
+		{
+			return a.second.bytes > b.second.bytes;
+		} );
+		return sorted;
+	}
+}
+
+size_t MemoryReport::GetTreeSize( PObjectBase obj )
+{
+	size_t size = GetObjectSize( obj );
+	for ( unsigned int i = 0; i < obj->GetChildCount(); ++i )
+	{
+		size += GetTreeSize( obj->GetChild( i ) );
+	}
+	return size;
+}
+
+wxString MemoryReport::Build( VisualEditor* designer )
+{
+	PObjectDatabase database = AppData()->GetObjectDatabase();
+
+	Collector collector;
+	PObjectBase project = AppData()->GetProjectData();
+	if ( project )
+	{
+		collector.Collect( project, database );
+	}
+
+	wxString report;
+	report << wxT("{\n  \"objects\": {\n")
+		<< wxT("    \"count\": ") << Number( collector.objects ) << wxT(",\n")
+		<< wxT("    \"bytes\": ") << Number( collector.objectBytes ) << wxT(",\n")
+		<< wxT("    \"classes\": [\n");
+
+	const std::vector< std::pair< wxString, ClassUsage > > classes = SortByBytes( collector.classes );
+	for ( size_t i = 0; i < classes.size(); ++i )
+	{
+		const ClassUsage& usage = classes[i].second;
+		report << wxT("      { \"class\": ") << StringUtils::JsonString( classes[i].first )
+			<< wxT(", \"count\": ") << Number( usage.objects )
+			<< wxT(", \"properties\": ") << Number( usage.properties )
+			<< wxT(", \"events\": ") << Number( usage.events )
+			<< wxT(", \"bytes\": ") << Number( usage.bytes )
+			<< ( i + 1 < classes.size() ? wxT(" },\n") : wxT(" }\n") );
+	}
+
+	report << wxT("    ]\n  },\n  \"values\": {\n")
+		<< wxT("    \"distinct\": ") << Number( collector.distinct.size() ) << wxT(",\n")
+		<< wxT("    \"bytes\": ") << Number( collector.valueBytes ) << wxT(",\n")
+		<< wxT("    \"types\": [\n");
+
+	const std::vector< std::pair< wxString, ValueUsage > > values = SortByBytes( collector.values );
+	for ( size_t i = 0; i < values.size(); ++i )
+	{
+		const ValueUsage& usage = values[i].second;
+		report << wxT("      { \"type\": ") << StringUtils::JsonString( values[i].first )
+			<< wxT(", \"count\": ") << Number( usage.count )
+			<< wxT(", \"distinct\": ") << Number( usage.distinct.size() )
+			<< wxT(", \"bytes\": ") << Number( usage.bytes )
+			<< ( i + 1 < values.size() ? wxT(" },\n") : wxT(" }\n") );
+	}
+
+	const CommandProcessor& history = AppData()->GetCommandProcessor();
+	report << wxT("    ]\n  },\n  \"history\": {\n")
+		<< wxT("    \"undo\": ") << Number( history.GetUndoCount() ) << wxT(",\n")
+		<< wxT("    \"redo\": ") << Number( history.GetRedoCount() ) << wxT(",\n")
+		<< wxT("    \"bytes\": ") << Number( history.GetMemorySize() ) << wxT("\n")
+		<< wxT("  },\n");
+
+	if ( designer )
+	{
+		report << wxT("  \"designer\": {\n")
+			<< wxT("    \"widgets\": ") << Number( designer->GetWxObjectCount() ) << wxT(",\n")
+			<< wxT("    \"builtForms\": ") << Number( designer->GetBuiltFormCount() ) << wxT(",\n")
+			<< wxT("    \"builtFormWidgets\": ") << Number( designer->GetBuiltFormWxObjectCount() ) << wxT(",\n")
+			<< wxT("    \"unbuiltPages\": ") << Number( designer->GetUnbuiltPageCount() ) << wxT(",\n")
+			<< wxT("    \"bytes\": ") << Number( designer->GetMemorySize() ) << wxT("\n")
+			<< wxT("  },\n");
+	}
+
+	PObjectArena arena = database->GetArena();
+	PSearchIndex searchIndex = AppData()->GetSearchIndex();
+	report << wxT("  \"caches\": {\n")
+		<< wxT("    \"internedStrings\": ") << Number( InternedString::GetPoolSize() ) << wxT(",\n")
+		<< wxT("    \"arenaReserved\": ") << Number( arena ? arena->GetReservedSize() : 0 ) << wxT(",\n")
+		<< wxT("    \"arenaUsed\": ") << Number( arena ? arena->GetUsedSize() : 0 ) << wxT(",\n")
+		<< wxT("    \"searchIndexObjects\": ") << Number( searchIndex ? searchIndex->GetObjectCount() : 0 ) << wxT(",\n")
+		<< wxT("    \"searchIndexWords\": ") << Number( searchIndex ? searchIndex->GetWordCount() : 0 ) << wxT("\n")
+		<< wxT("  }\n}\n");
+
+	return report;
+}
+
+bool MemoryReport::Write( const wxString& report, const wxString& path )
+{
+	if ( path.empty() )
+	{
+		std::cout << report.utf8_str() << std::flush;
+		return true;
+	}
+
+	wxFFile file( path, wxT("wb") );
+	if ( !file.IsOpened() || !file.Write( report, wxConvUTF8 ) )
+	{
+		wxLogError( _("Unable to write the memory report: %s"), path.c_str() );
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+@file
+Report of the memory held by the project model, the undo history, the designer and the caches.
+*/
+
+#ifndef __MEMORY_REPORT__
+#define __MEMORY_REPORT__
+
+#include "../utils/wxfbdefs.h"
+
+#include <wx/string.h>
+
+class VisualEditor;
+
+/**
+* The sizes are estimates from the sizes of the types, not measures of the allocator: they are meant to compare the
+* parts and to follow a change, not to add up to the size of the process.
+*
+* The values of the properties and events are shared, each distinct value is counted once, apart from the objects.
+*/
+namespace MemoryReport
+{
+	/**
+	* Estimated bytes of an object with its properties and events, and of its children, without the values.
+	*/
+	size_t GetTreeSize( PObjectBase obj );
+
+	/**
+	* Builds the report of the open project as JSON: the objects by class, the values by property type, the undo
+	* history, the widgets of the designer if there is one, and the caches.
+	*/
+	wxString Build( VisualEditor* designer );
+
+	/**
+	* Writes the report to the file, or to the standard output if the path is empty. Logs an error and returns false
+	* if the file cannot be written.
+	*/
+	bool Write( const wxString& report, const wxString& path );
+}
+
+#endif //__MEMORY_REPORT__
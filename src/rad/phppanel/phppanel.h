@@ -59,6 +59,9 @@ private:
 	CodeEditor* m_phpPanel;
 	PTCCodeWriter m_phpCW;
 
+	// The project changed while the panel was not visible
+	bool m_stale;
+
     void InitStyledTextCtrl( wxStyledTextCtrl* stc );
 
 public:
@@ -71,6 +74,9 @@ public:
 	void OnObjectChange( wxFBObjectEvent& event );
 	void OnEventHandlerModified( wxFBEventHandlerEvent& event );
 
+	// Generates the code of the panel if it is stale, once it is visible
+	void GenerateIfStale();
+
 	void OnFind( wxFindDialogEvent& event );
 
 	DECLARE_EVENT_TABLE()
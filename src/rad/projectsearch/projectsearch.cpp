@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "projectsearch.h"
+
+#include "../../model/objectbase.h"
+#include "../appdata.h"
+#include "../inspector/objinspect.h"
+#include "../wxfbevent.h"
+
+#include <wx/listctrl.h>
+#include <wx/sizer.h>
+#include <wx/srchctrl.h>
+#include <wx/stattext.h>
+
+namespace
+{
+	// More results are not worth listing, the query has to be refined
+	const size_t MAX_MATCHES = 1000;
+
+	// Items (sizeritem, notebookpage, ...) are not in the tree, their properties are shown with the object they hold
+	PObjectBase GetSelectable( PObjectBase obj )
+	{
+		while ( obj && obj->GetObjectInfo()->GetObjectType()->IsItem() )
+		{
+			obj = ( obj->GetChildCount() > 0 ? obj->GetChild( 0 ) : PObjectBase() );
+		}
+		return obj;
+	}
+}
+
+BEGIN_EVENT_TABLE( ProjectSearchDialog, wxDialog )
+	EVT_TEXT( wxID_FIND, ProjectSearchDialog::OnQueryChanged )
+	EVT_LIST_ITEM_SELECTED( wxID_ANY, ProjectSearchDialog::OnResultSelected )
+END_EVENT_TABLE()
+
+ProjectSearchDialog::ProjectSearchDialog( wxWindow* parent, ObjectInspector* inspector )
+:
+wxDialog( parent, wxID_ANY, wxT("Find in Project"), wxDefaultPosition, wxSize( 600, 400 ), wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER ),
+m_inspector( inspector ),
+m_updating( false )
+{
+	AppData()->AddHandler( this->GetEventHandler() );
+
+	m_query = new wxSearchCtrl( this, wxID_FIND );
+	m_query->ShowCancelButton( true );
+
+	m_results = new wxListCtrl( this, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxLC_REPORT | wxLC_SINGLE_SEL );
+	m_results->InsertColumn( 0, wxT("Object"), wxLIST_FORMAT_LEFT, 140 );
+	m_results->InsertColumn( 1, wxT("Class"), wxLIST_FORMAT_LEFT, 110 );
+	m_results->InsertColumn( 2, wxT("Property / Event"), wxLIST_FORMAT_LEFT, 130 );
+	m_results->InsertColumn( 3, wxT("Value"), wxLIST_FORMAT_LEFT, 200 );
+
+	m_status = new wxStaticText( this, wxID_ANY, wxEmptyString );
+
+	wxBoxSizer* sizer = new wxBoxSizer( wxVERTICAL );
+	sizer->Add( m_query, 0, wxALL | wxEXPAND, 5 );
+	sizer->Add( m_results, 1, wxLEFT | wxRIGHT | wxEXPAND, 5 );
+	sizer->Add( m_status, 0, wxALL | wxEXPAND, 5 );
+	SetSizer( sizer );
+	Layout();
+
+	// Any change of the project can change the results
+	Connect( wxID_ANY, wxEVT_FB_PROJECT_LOADED, wxFBEventHandler( ProjectSearchDialog::OnProjectChanged ) );
+	Connect( wxID_ANY, wxEVT_FB_PROJECT_REFRESH, wxFBEventHandler( ProjectSearchDialog::OnProjectChanged ) );
+	Connect( wxID_ANY, wxEVT_FB_OBJECT_CREATED, wxFBEventHandler( ProjectSearchDialog::OnProjectChanged ) );
+	Connect( wxID_ANY, wxEVT_FB_OBJECT_REMOVED, wxFBEventHandler( ProjectSearchDialog::OnProjectChanged ) );
+	Connect( wxID_ANY, wxEVT_FB_PROPERTY_MODIFIED, wxFBEventHandler( ProjectSearchDialog::OnProjectChanged ) );
+	Connect( wxID_ANY, wxEVT_FB_EVENT_HANDLER_MODIFIED, wxFBEventHandler( ProjectSearchDialog::OnProjectChanged ) );
+}
+
+ProjectSearchDialog::~ProjectSearchDialog()
+{
+	AppData()->RemoveHandler( this->GetEventHandler() );
+}
+
+void ProjectSearchDialog::Popup()
+{
+	// The results are not refreshed while hidden
+	if ( !IsShown() && !m_query->GetValue().empty() )
+	{
+		Search();
+	}
+
+	Show( true );
+	Raise();
+	m_query->SetFocus();
+	m_query->SelectAll();
+}
+
+void ProjectSearchDialog::Search()
+{
+	// Keep the selected result when the results are refreshed after a change
+	SearchIndex::Match selected;
+	long selectedItem = m_results->GetNextItem( -1, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED );
+	if ( selectedItem >= 0 && (size_t)selectedItem < m_matches.size() )
+	{
+		selected = m_matches[ selectedItem ];
+	}
+
+	m_matches = AppData()->GetSearchIndex()->Search( AppData()->GetProjectData(), m_query->GetValue(), MAX_MATCHES );
+
+	m_updating = true;
+	m_results->Freeze();
+	m_results->DeleteAllItems();
+
+	for ( size_t i = 0; i < m_matches.size(); ++i )
+	{
+		const SearchIndex::Match& match = m_matches[i];
+
+		PObjectBase shown = GetSelectable( match.object );
+		long item = m_results->InsertItem( (long)i, ( shown ? shown : match.object )->GetPropertyAsString( wxT("name") ) );
+		m_results->SetItem( item, 1, match.object->GetClassName() );
+
+		if ( match.property )
+		{
+			m_results->SetItem( item, 2, match.property->GetName() );
+			m_results->SetItem( item, 3, match.property->GetValue() );
+		}
+		else if ( match.event )
+		{
+			m_results->SetItem( item, 2, match.event->GetName() );
+			m_results->SetItem( item, 3, match.event->GetValue() );
+		}
+
+		if ( match.object == selected.object && match.property == selected.property && match.event == selected.event )
+		{
+			m_results->SetItemState( item, wxLIST_STATE_SELECTED, wxLIST_STATE_SELECTED );
+			m_results->EnsureVisible( item );
+		}
+	}
+
+	m_results->Thaw();
+	m_updating = false;
+
+	if ( m_matches.size() >= MAX_MATCHES )
+	{
+		m_status->SetLabel( wxString::Format( wxT("First %u matches"), (unsigned int)m_matches.size() ) );
+	}
+	else
+	{
+		m_status->SetLabel( wxString::Format( wxT("%u matches"), (unsigned int)m_matches.size() ) );
+	}
+}
+
+void ProjectSearchDialog::OnQueryChanged( wxCommandEvent& )
+{
+	Search();
+}
+
+void ProjectSearchDialog::OnResultSelected( wxListEvent& event )
+{
+	if ( m_updating || event.GetIndex() < 0 || (size_t)event.GetIndex() >= m_matches.size() )
+	{
+		return;
+	}
+
+	// Selecting the object notifies the whole application, the results can not be used after that
+	const SearchIndex::Match match = m_matches[ event.GetIndex() ];
+
+	PObjectBase obj = GetSelectable( match.object );
+	if ( !obj )
+	{
+		return;
+	}
+
+	AppData()->SelectObject( obj, true );
+
+	if ( match.property )
+	{
+		m_inspector->SelectProperty( match.property );
+	}
+	else if ( match.event )
+	{
+		m_inspector->SelectEvent( match.event );
+	}
+}
+
+void ProjectSearchDialog::OnProjectChanged( wxFBEvent& event )
+{
+	event.Skip();
+
+	if ( IsShown() && !m_query->GetValue().empty() )
+	{
+		Search();
+	}
+}
@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef __PROJECT_SEARCH__
+#define __PROJECT_SEARCH__
+
+#include "../../model/searchindex.h"
+
+#include <wx/dialog.h>
+
+class ObjectInspector;
+class wxFBEvent;
+class wxListCtrl;
+class wxListEvent;
+class wxSearchCtrl;
+class wxStaticText;
+
+/**
+ * Modeless dialog searching the objects, property values and event handlers of the project.
+ * Selecting a result selects its object in the tree and its property or event in the inspector.
+ */
+class ProjectSearchDialog : public wxDialog
+{
+private:
+	ObjectInspector* m_inspector;
+
+	wxSearchCtrl* m_query;
+	wxListCtrl* m_results;
+	wxStaticText* m_status;
+
+	SearchIndex::MatchVector m_matches;
+
+	// The results are being filled, the selection is not a jump
+	bool m_updating;
+
+	void Search();
+
+	void OnQueryChanged( wxCommandEvent& event );
+	void OnResultSelected( wxListEvent& event );
+	void OnProjectChanged( wxFBEvent& event );
+
+	DECLARE_EVENT_TABLE()
+
+public:
+	ProjectSearchDialog( wxWindow* parent, ObjectInspector* inspector );
+	~ProjectSearchDialog() override;
+
+	/**
+	 * Shows the dialog, ready to type the query.
+	 */
+	void Popup();
+};
+
+#endif //__PROJECT_SEARCH__
@@ -38,6 +38,7 @@
 #include "../../model/objectbase.h"
 
 #include "../../codegen/codewriter.h"
+#include "../../codegen/generationcache.h"
 #include "../../codegen/pythoncg.h"
 
 #include <wx/fdrepdlg.h>
@@ -59,7 +60,8 @@ END_EVENT_TABLE()
 
 PythonPanel::PythonPanel( wxWindow *parent, int id )
 :
-wxPanel( parent, id )
+wxPanel( parent, id ),
+m_stale( false )
 {
 	AppData()->AddHandler( this->GetEventHandler() );
 	wxBoxSizer *top_sizer = new wxBoxSizer( wxVERTICAL );
@@ -155,12 +157,27 @@ void PythonPanel::OnEventHandlerModified( wxFBEventHandlerEvent& event )
 	OnCodeGeneration( event );
 }
 
+void PythonPanel::GenerateIfStale()
+{
+	// A single generation catches up with all the changes made while the panel was not visible
+	if ( m_stale )
+	{
+		wxFBEvent event( wxEVT_FB_CODE_GENERATION );
+		event.SetId( 1 );
+		OnCodeGeneration( event );
+	}
+}
+
 void PythonPanel::OnCodeGeneration( wxFBEvent& event )
 {
     PObjectBase objectToGenerate;
 
-	// Generate code in the panel if the panel is active
-	bool doPanel = IsShown();
+	// Generate code in the panel if it is the visible page, otherwise once it is selected
+	bool doPanel = CodeEditor::IsPanelVisible( this );
+	if ( !doPanel )
+	{
+		m_stale = true;
+	}
 
 	// Using the previously unused Id field in the event to carry a boolean
 	bool panelOnly = ( event.GetId() != 0 );
@@ -291,20 +308,14 @@ void PythonPanel::OnCodeGeneration( wxFBEvent& event )
 
 		Freeze();
 
-        wxStyledTextCtrl* pythonEditor = m_pythonPanel->GetTextCtrl();
-		pythonEditor->SetReadOnly( false );
-		int pythonLine = pythonEditor->GetFirstVisibleLine() + pythonEditor->LinesOnScreen() - 1;
-		int pythonXOffset = pythonEditor->GetXOffset();
-
 		codegen.GenerateCode( project );
 
-		pythonEditor->SetReadOnly( true );
-		pythonEditor->GotoLine( pythonLine );
-		pythonEditor->SetXOffset( pythonXOffset );
-		pythonEditor->SetAnchor( 0 );
-		pythonEditor->SetCurrentPos( 0 );
+		// Only the changed lines are replaced, so the view keeps its position
+		m_pythonCW->Flush();
 
 		Thaw();
+
+		m_stale = false;
 	}
 
 	// Generate code in the file
@@ -312,44 +323,63 @@ void PythonPanel::OnCodeGeneration( wxFBEvent& event )
 	{
 		try
 		{
-			PythonCodeGenerator codegen;
-			codegen.UseRelativePath( useRelativePath, path );
-
-			if ( pFirstID )
+			// Skip the generation when nothing it depends on changed
+			GenerationCache cache( path, file );
+			wxArrayString outputs;
+			outputs.Add( path + file + wxT( ".py" ) );
+			const wxString cacheKey = GenerationCache::ComputeKey( project, wxT("Python") );
+			if ( cache.IsUpToDate( wxT("Python"), cacheKey, outputs ) )
 			{
-				codegen.SetFirstID( firstID );
+				wxLogStatus( wxT( "Code on \'%s\' is up to date." ), path.c_str() );
+				return;
 			}
 
-			// Determin if Microsoft BOM should be used
-			bool useMicrosoftBOM = false;
+			{
+				PythonCodeGenerator codegen;
+				codegen.UseRelativePath( useRelativePath, path );
 
-			PProperty pUseMicrosoftBOM = project->GetProperty( wxT( "use_microsoft_bom" ) );
+				if ( pFirstID )
+				{
+					codegen.SetFirstID( firstID );
+				}
 
-			if ( pUseMicrosoftBOM )
-			{
-				useMicrosoftBOM = ( pUseMicrosoftBOM->GetValueAsInteger() != 0 );
-			}
+				// Determin if Microsoft BOM should be used
+				bool useMicrosoftBOM = false;
 
-			// Determine if Utf8 or Ansi is to be created
-			bool useUtf8 = false;
-			PProperty pUseUtf8 = project->GetProperty( _("encoding") );
+				PProperty pUseMicrosoftBOM = project->GetProperty( wxT( "use_microsoft_bom" ) );
 
-			if ( pUseUtf8 )
-			{
-				useUtf8 = ( pUseUtf8->GetValueAsString() != wxT("ANSI") );
-			}
+				if ( pUseMicrosoftBOM )
+				{
+					useMicrosoftBOM = ( pUseMicrosoftBOM->GetValueAsInteger() != 0 );
+				}
 
-			PCodeWriter python_cw( new FileCodeWriter( path + file + wxT( ".py" ), useMicrosoftBOM, useUtf8 ) );
-			python_cw->SetIndentWithSpaces( useSpaces );
+				// Determine if Utf8 or Ansi is to be created
+				bool useUtf8 = false;
+				PProperty pUseUtf8 = project->GetProperty( _("encoding") );
 
-			codegen.SetSourceWriter( python_cw );
-			codegen.GenerateCode( project );
-			wxLogStatus( wxT( "Code generated on \'%s\'." ), path.c_str() );
+				if ( pUseUtf8 )
+				{
+					useUtf8 = ( pUseUtf8->GetValueAsString() != wxT("ANSI") );
+				}
+
+				PCodeWriter python_cw( new FileCodeWriter( path + file + wxT( ".py" ), useMicrosoftBOM, useUtf8 ) );
+				python_cw->SetIndentWithSpaces( useSpaces );
+
+				codegen.SetSourceWriter( python_cw );
+				codegen.GenerateCode( project );
+				wxLogStatus( wxT( "Code generated on \'%s\'." ), path.c_str() );
+
+				// check if we have to convert to ANSI encoding
+				if (project->GetPropertyAsString(wxT("encoding")) == wxT("ANSI"))
+				{
+					UTF8ToAnsi(path + file + wxT( ".py" ));
+				}
+			}
 
-			// check if we have to convert to ANSI encoding
-			if (project->GetPropertyAsString(wxT("encoding")) == wxT("ANSI"))
+			// The files are written when the writers are destroyed
+			if ( FileCodeWriter::WaitForPendingWrites() )
 			{
-				UTF8ToAnsi(path + file + wxT( ".py" ));
+				cache.Store( wxT("Python"), cacheKey, outputs );
 			}
 		}
 		catch ( wxFBException& ex )
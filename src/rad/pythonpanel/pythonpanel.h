@@ -56,6 +56,9 @@ private:
 	CodeEditor* m_pythonPanel;
 	PTCCodeWriter m_pythonCW;
 
+	// The project changed while the panel was not visible
+	bool m_stale;
+
     void InitStyledTextCtrl( wxStyledTextCtrl* stc );
 
 public:
@@ -68,6 +71,9 @@ public:
 	void OnObjectChange( wxFBObjectEvent& event );
 	void OnEventHandlerModified( wxFBEventHandlerEvent& event );
 
+	// Generates the code of the panel if it is stale, once it is visible
+	void GenerateIfStale();
+
 	void OnFind( wxFindDialogEvent& event );
 
 	DECLARE_EVENT_TABLE()
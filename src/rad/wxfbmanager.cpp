@@ -43,28 +43,18 @@
 #define CHECK_OBJECT_BASE( RETURN ) \
 	CHECK_NULL( obj, _("ObjectBase"), RETURN )
 
-// Classes to unset flags in VisualEditor during the destructor - this prevents
-// forgetting to unset the flag
-class FlagFlipper
+FlagFlipper::FlagFlipper( VisualEditor* visualEdit, void (VisualEditor::*flagFunction)( bool ) )
+:
+m_visualEditor( visualEdit ),
+m_flagFunction( flagFunction )
 {
-private:
-	VisualEditor* m_visualEditor;
-	void (VisualEditor::*m_flagFunction)( bool );
-
-public:
-	FlagFlipper( VisualEditor* visualEdit, void (VisualEditor::*flagFunction)( bool ) )
-	:
-	m_visualEditor( visualEdit ),
-	m_flagFunction( flagFunction )
-	{
-		( m_visualEditor->*m_flagFunction )( true );
-	}
+	( m_visualEditor->*m_flagFunction )( true );
+}
 
-	~FlagFlipper()
-	{
-		( m_visualEditor->*m_flagFunction )( false );
-	}
-};
+FlagFlipper::~FlagFlipper()
+{
+	( m_visualEditor->*m_flagFunction )( false );
+}
 
 wxFBManager::wxFBManager()
 :
@@ -201,6 +191,40 @@ bool wxFBManager::SelectObject( wxObject* wxobject )
 	return AppData()->SelectObject( obj );
 }
 
+size_t wxFBManager::GetChildren( wxObject* wxobject, std::vector< wxObject* >* children, std::vector< IObject* >* iChildren )
+{
+	CHECK_VISUAL_EDITOR( 0 )
+
+	CHECK_WX_OBJECT( 0 )
+
+	PObjectBase obj = m_visualEdit->GetObjectBase( wxobject );
+
+	CHECK_OBJECT_BASE( 0 )
+
+	const unsigned int count = obj->GetChildCount();
+	children->clear();
+	children->reserve( count );
+	if ( iChildren )
+	{
+		iChildren->clear();
+		iChildren->reserve( count );
+	}
+
+	for ( unsigned int i = 0; i < count; ++i )
+	{
+		PObjectBase child = obj->GetChild( i );
+		wxObject* wxChild = m_visualEdit->FindWxObject( child.get() );
+		children->push_back( wxChild );
+		if ( iChildren )
+		{
+			// As GetIObject( GetChild() ), NULL for the children not created
+			iChildren->push_back( wxChild ? child.get() : NULL );
+		}
+	}
+
+	return count;
+}
+
 wxNoObject* wxFBManager::NewNoObject()
 {
     return new wxNoObject;
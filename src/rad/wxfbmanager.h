@@ -31,6 +31,19 @@
 class VisualEditor;
 class ObjectBase;
 
+// Classes to unset flags in VisualEditor during the destructor - this prevents
+// forgetting to unset the flag
+class FlagFlipper
+{
+private:
+	VisualEditor* m_visualEditor;
+	void (VisualEditor::*m_flagFunction)( bool );
+
+public:
+	FlagFlipper( VisualEditor* visualEdit, void (VisualEditor::*flagFunction)( bool ) );
+	~FlagFlipper();
+};
+
 class wxFBManager : public IManager
 {
 private:
@@ -52,6 +65,9 @@ public:
 
 	// Returns true if selection changed, false if already selected
 	bool SelectObject(wxObject* wxobject) override;
+
+	size_t GetChildren(wxObject* wxobject, std::vector<wxObject*>* children,
+	                   std::vector<IObject*>* iChildren = NULL) override;
 };
 
 #endif //WXFBMANAGER
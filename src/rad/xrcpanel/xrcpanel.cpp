@@ -28,6 +28,7 @@
 #include "xrcpanel.h"
 
 #include "../../codegen/codewriter.h"
+#include "../../codegen/generationcache.h"
 #include "../../codegen/xrccg.h"
 
 #include "../../model/objectbase.h"
@@ -54,7 +55,8 @@ BEGIN_EVENT_TABLE( XrcPanel,  wxPanel )
 END_EVENT_TABLE()
 
 XrcPanel::XrcPanel( wxWindow *parent, int id )
-		: wxPanel ( parent, id )
+		: wxPanel ( parent, id ),
+		m_stale( false )
 {
 	AppData()->AddHandler( this->GetEventHandler() );
 	wxBoxSizer *top_sizer = new wxBoxSizer( wxVERTICAL );
@@ -147,6 +149,17 @@ void XrcPanel::OnObjectChange( wxFBObjectEvent& event )
 	OnCodeGeneration( event );
 }
 
+void XrcPanel::GenerateIfStale()
+{
+	// A single generation catches up with all the changes made while the panel was not visible
+	if ( m_stale )
+	{
+		wxFBEvent event( wxEVT_FB_CODE_GENERATION );
+		event.SetId( 1 );
+		OnCodeGeneration( event );
+	}
+}
+
 void XrcPanel::OnCodeGeneration( wxFBEvent& event )
 {
     PObjectBase project;
@@ -154,8 +167,12 @@ void XrcPanel::OnCodeGeneration( wxFBEvent& event )
 	// Using the previously unused Id field in the event to carry a boolean
 	bool panelOnly = ( event.GetId() != 0 );
 
-	// Generate code in the panel if the panel is active
-	bool doPanel = IsShown();
+	// Generate code in the panel if it is the visible page, otherwise once it is selected
+	bool doPanel = CodeEditor::IsPanelVisible( this );
+	if ( !doPanel )
+	{
+		m_stale = true;
+	}
 
 	// Only generate to panel + panel is not shown = do nothing
 	if ( panelOnly && !doPanel )
@@ -179,23 +196,20 @@ void XrcPanel::OnCodeGeneration( wxFBEvent& event )
 	if(!project)return;
 
 	// Generate code in the panel if the panel is active
-	if ( IsShown() )
+	if ( doPanel )
 	{
 		Freeze();
-        wxStyledTextCtrl* editor = m_xrcPanel->GetTextCtrl();
-		editor->SetReadOnly( false );
-		int line = editor->GetFirstVisibleLine() + editor->LinesOnScreen() - 1;
-		int xOffset = editor->GetXOffset();
 
 		XrcCodeGenerator codegen;
 		codegen.SetWriter( m_cw );
 		codegen.GenerateCode( project );
-		editor->SetReadOnly( true );
-		editor->GotoLine( line );
-		editor->SetXOffset( xOffset );
-		editor->SetAnchor( 0 );
-		editor->SetCurrentPos( 0 );
+
+		// Only the changed lines are replaced, so the view keeps its position
+		m_cw->Flush();
+
 		Thaw();
+
+		m_stale = false;
 	}
 
 	if ( panelOnly )
@@ -238,11 +252,32 @@ void XrcPanel::OnCodeGeneration( wxFBEvent& event )
 			wxString filePath;
 
 			filePath << path << file << wxT( ".xrc" );
-			PCodeWriter cw( new FileCodeWriter( filePath ) );
 
-			codegen.SetWriter( cw );
-			codegen.GenerateCode( project );
-			wxLogStatus( wxT( "Code generated on \'%s\'." ), path.c_str() );
+			// Skip the generation when nothing it depends on changed
+			GenerationCache cache( path, file );
+			wxArrayString outputs;
+			outputs.Add( filePath );
+			const wxString cacheKey = GenerationCache::ComputeKey( project, wxT("XRC") );
+			if ( cache.IsUpToDate( wxT("XRC"), cacheKey, outputs ) )
+			{
+				wxLogStatus( wxT( "Code on \'%s\' is up to date." ), path.c_str() );
+				return;
+			}
+
+			{
+				PCodeWriter cw( new FileCodeWriter( filePath ) );
+
+				codegen.SetWriter( cw );
+				codegen.GenerateCode( project );
+				codegen.SetWriter( PCodeWriter() );
+				wxLogStatus( wxT( "Code generated on \'%s\'." ), path.c_str() );
+			}
+
+			// The file is written when the writer is destroyed
+			if ( FileCodeWriter::WaitForPendingWrites() )
+			{
+				cache.Store( wxT("XRC"), cacheKey, outputs );
+			}
 		}
 		catch ( wxFBException& ex )
 		{
@@ -43,6 +43,9 @@ private:
 	CodeEditor* m_xrcPanel;
 	PTCCodeWriter m_cw;
 
+	// The project changed while the panel was not visible
+	bool m_stale;
+
     void InitStyledTextCtrl( wxStyledTextCtrl* stc );
 
 public:
@@ -54,6 +57,9 @@ public:
 	void OnCodeGeneration( wxFBEvent& event );
 	void OnObjectChange( wxFBObjectEvent& event );
 
+	// Generates the code of the panel if it is stale, once it is visible
+	void GenerateIfStale();
+
 	void OnFind( wxFindDialogEvent& event );
 
 	DECLARE_EVENT_TABLE()
@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "internedstring.h"
+
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+/**
+* The pool only references the values, each one removes itself when the last owner releases it.
+*/
+class InternedStringPool
+{
+private:
+	typedef InternedString::Value Value;
+
+	// The keys point into the shared values, so each text is stored once
+	typedef std::unordered_map< std::string_view, std::weak_ptr< const Value > > ValueMap;
+	ValueMap m_values;
+	std::mutex m_mutex;
+
+	void Release( const Value* value )
+	{
+		{
+			std::lock_guard< std::mutex > lock( m_mutex );
+
+			ValueMap::iterator it = m_values.find( value->utf8 );
+			if ( it != m_values.end() && it->first.data() == value->utf8.data() )
+			{
+				m_values.erase( it );
+			}
+		}
+		delete value;
+	}
+
+public:
+	/**
+	* The shared value of the UTF-8 text, text is its wxString if the caller already has it.
+	*/
+	std::shared_ptr< const Value > Get( const std::string_view& utf8, const wxString* text )
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+
+		ValueMap::iterator it = m_values.find( utf8 );
+		if ( it != m_values.end() )
+		{
+			std::shared_ptr< const Value > shared = it->second.lock();
+			if ( shared )
+			{
+				return shared;
+			}
+
+			// Expired, but not released yet
+			m_values.erase( it );
+		}
+
+		// Converted once for each distinct value
+		Value* value = new Value;
+		value->utf8.assign( utf8.data(), utf8.length() );
+		value->text = ( text ? *text : wxString::FromUTF8( utf8.data(), utf8.length() ) );
+
+		std::shared_ptr< const Value > shared( value, [ this ]( const Value* released ) { Release( released ); } );
+		m_values.insert( ValueMap::value_type( std::string_view( shared->utf8 ), shared ) );
+		return shared;
+	}
+
+	size_t GetSize()
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		return m_values.size();
+	}
+};
+
+namespace
+{
+	InternedStringPool& GetPool()
+	{
+		// Never destroyed, the values of static objects can outlive it otherwise
+		static InternedStringPool* pool = new InternedStringPool;
+		return *pool;
+	}
+}
+
+InternedString::InternedString( const wxString& value )
+{
+	if ( !value.empty() )
+	{
+		const wxScopedCharBuffer utf8 = value.utf8_str();
+		m_data = GetPool().Get( std::string_view( utf8.data(), utf8.length() ), &value );
+	}
+}
+
+InternedString::InternedString( const wxChar* value )
+	: InternedString( wxString( value ) )
+{
+}
+
+InternedString InternedString::FromUTF8( const char* data, size_t length )
+{
+	InternedString value;
+	if ( length > 0 )
+	{
+		value.m_data = GetPool().Get( std::string_view( data, length ), NULL );
+	}
+	return value;
+}
+
+const wxString& InternedString::ToString() const
+{
+	static const wxString empty;
+	return ( m_data ? m_data->text : empty );
+}
+
+const std::string& InternedString::GetUTF8() const
+{
+	static const std::string empty;
+	return ( m_data ? m_data->utf8 : empty );
+}
+
+size_t InternedString::GetStorageSize() const
+{
+	if ( !m_data )
+	{
+		return 0;
+	}
+	return sizeof( Value ) + m_data->utf8.capacity() + m_data->text.capacity() * sizeof( wxStringCharType );
+}
+
+size_t InternedString::GetPoolSize()
+{
+	return GetPool().GetSize();
+}
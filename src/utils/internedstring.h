@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <wx/string.h>
+
+#include <memory>
+#include <string>
+
+class InternedStringPool;
+
+/**
+* Immutable string stored once and shared by all the equal values.
+*
+* Used for the values of the properties and events: most of them are repeats ("wxALL", "5", "wxID_ANY", ...)
+* and the defaults of the descriptors, so each instance only costs a pointer. The empty string holds no storage.
+* Each distinct value keeps its UTF-8 text, for the files, and its wxString, for the generators and the editors,
+* so neither is converted when it is requested.
+*/
+class InternedString
+{
+	friend class InternedStringPool;
+
+private:
+	struct Value
+	{
+		std::string utf8;
+		wxString text;
+	};
+
+	std::shared_ptr< const Value > m_data;
+
+public:
+	InternedString() {}
+	InternedString( const wxString& value );
+	InternedString( const wxChar* value );
+
+	/**
+	* Interns a UTF-8 value.
+	*/
+	static InternedString FromUTF8( const char* data, size_t length );
+
+	const wxString& ToString() const;
+	operator const wxString&() const { return ToString(); }
+
+	/**
+	* The value in UTF-8.
+	*/
+	const std::string& GetUTF8() const;
+
+	bool empty() const { return !m_data; }
+
+	/**
+	* Size of the shared value, for memory accounting.
+	*/
+	size_t GetStorageSize() const;
+
+	// Equal values share the same buffer
+	bool operator==( const InternedString& other ) const { return m_data == other.m_data; }
+	bool operator!=( const InternedString& other ) const { return m_data != other.m_data; }
+
+	/**
+	* Number of distinct values currently alive.
+	*/
+	static size_t GetPoolSize();
+};
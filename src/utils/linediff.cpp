@@ -0,0 +1,208 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "linediff.h"
+
+#include <wx/hashmap.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace
+{
+	/// Myers' diff over line identifiers, returns false if there are more than MAX_EDITS edits.
+	bool DiffLines( const std::vector< int >& a, const std::vector< int >& b, std::vector< LineDiff::Hunk >* hunks )
+	{
+		const int n = (int)a.size();
+		const int m = (int)b.size();
+		const int max = std::min( n + m, LineDiff::MAX_EDITS );
+
+		// v[k + offset] is the furthest x reached on diagonal k.
+		// trace[d] keeps the diagonals -(d-1)..(d-1) as they were before step d.
+		const int offset = max + 1;
+		std::vector< int > v( 2 * max + 3, 0 );
+		std::vector< std::vector< int > > trace;
+
+		int found = -1;
+		for ( int d = 0; d <= max && found < 0; ++d )
+		{
+			trace.push_back( d > 0 ? std::vector< int >( v.begin() + offset - d + 1, v.begin() + offset + d ) : std::vector< int >() );
+
+			for ( int k = -d; k <= d; k += 2 )
+			{
+				int x;
+				if ( k == -d || ( k != d && v[ offset + k - 1 ] < v[ offset + k + 1 ] ) )
+				{
+					x = v[ offset + k + 1 ];
+				}
+				else
+				{
+					x = v[ offset + k - 1 ] + 1;
+				}
+
+				int y = x - k;
+				while ( x < n && y < m && a[ x ] == b[ y ] )
+				{
+					++x;
+					++y;
+				}
+
+				v[ offset + k ] = x;
+				if ( x >= n && y >= m )
+				{
+					found = d;
+					break;
+				}
+			}
+		}
+
+		if ( found < 0 )
+		{
+			return false;
+		}
+
+		// Walk back collecting the matched lines
+		std::vector< std::pair< int, int > > matches;
+		int x = n;
+		int y = m;
+		for ( int d = found; d > 0; --d )
+		{
+			const std::vector< int >& prev = trace[ d ];
+			const int k = x - y;
+
+			int prevK;
+			if ( k == -d || ( k != d && prev[ k - 1 + d - 1 ] < prev[ k + 1 + d - 1 ] ) )
+			{
+				prevK = k + 1;
+			}
+			else
+			{
+				prevK = k - 1;
+			}
+
+			const int prevX = prev[ prevK + d - 1 ];
+			const int prevY = prevX - prevK;
+			while ( x > prevX && y > prevY )
+			{
+				--x;
+				--y;
+				matches.push_back( std::make_pair( x, y ) );
+			}
+
+			x = prevX;
+			y = prevY;
+		}
+		while ( x > 0 && y > 0 )
+		{
+			--x;
+			--y;
+			matches.push_back( std::make_pair( x, y ) );
+		}
+
+		// The gaps between matched lines are the hunks
+		size_t oldPos = 0;
+		size_t newPos = 0;
+		for ( std::vector< std::pair< int, int > >::reverse_iterator match = matches.rbegin(); match != matches.rend(); ++match )
+		{
+			if ( (size_t)match->first > oldPos || (size_t)match->second > newPos )
+			{
+				LineDiff::Hunk hunk = { oldPos, (size_t)match->first, newPos, (size_t)match->second };
+				hunks->push_back( hunk );
+			}
+			oldPos = match->first + 1;
+			newPos = match->second + 1;
+		}
+		if ( oldPos < a.size() || newPos < b.size() )
+		{
+			LineDiff::Hunk hunk = { oldPos, a.size(), newPos, b.size() };
+			hunks->push_back( hunk );
+		}
+
+		return true;
+	}
+}
+
+void LineDiff::SplitLines( const wxString& text, std::vector< wxString >* lines )
+{
+	size_t start = 0;
+	while ( start < text.length() )
+	{
+		size_t end = text.find( wxT('\n'), start );
+		if ( wxString::npos == end )
+		{
+			lines->push_back( text.substr( start ) );
+			break;
+		}
+
+		lines->push_back( text.substr( start, end - start + 1 ) );
+		start = end + 1;
+	}
+}
+
+void LineDiff::Compare( const std::vector< wxString >& oldLines, const std::vector< wxString >& newLines, std::vector< Hunk >* hunks )
+{
+	// Skip the common head and tail, usually most of the code
+	size_t head = 0;
+	while ( head < oldLines.size() && head < newLines.size() && oldLines[ head ] == newLines[ head ] )
+	{
+		++head;
+	}
+
+	size_t tail = 0;
+	while ( tail < oldLines.size() - head && tail < newLines.size() - head &&
+			oldLines[ oldLines.size() - tail - 1 ] == newLines[ newLines.size() - tail - 1 ] )
+	{
+		++tail;
+	}
+
+	if ( head + tail == oldLines.size() && head + tail == newLines.size() )
+	{
+		return;
+	}
+
+	// Compare the remaining lines by identifier
+	typedef std::unordered_map< wxString, int, wxStringHash, wxStringEqual > LineIdMap;
+	LineIdMap ids;
+	std::vector< int > oldIds;
+	std::vector< int > newIds;
+	for ( size_t i = head; i < oldLines.size() - tail; ++i )
+	{
+		oldIds.push_back( ids.insert( LineIdMap::value_type( oldLines[ i ], (int)ids.size() ) ).first->second );
+	}
+	for ( size_t i = head; i < newLines.size() - tail; ++i )
+	{
+		newIds.push_back( ids.insert( LineIdMap::value_type( newLines[ i ], (int)ids.size() ) ).first->second );
+	}
+
+	std::vector< Hunk > diff;
+	if ( !DiffLines( oldIds, newIds, &diff ) )
+	{
+		diff.clear();
+		Hunk hunk = { 0, oldIds.size(), 0, newIds.size() };
+		diff.push_back( hunk );
+	}
+
+	for ( std::vector< Hunk >::iterator hunk = diff.begin(); hunk != diff.end(); ++hunk )
+	{
+		Hunk shifted = { head + hunk->oldStart, head + hunk->oldEnd, head + hunk->newStart, head + hunk->newEnd };
+		hunks->push_back( shifted );
+	}
+}
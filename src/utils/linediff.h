@@ -0,0 +1,58 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <wx/string.h>
+
+#include <vector>
+
+/**
+* Line based comparison of two texts, used to only replace the lines that changed in the code panels.
+*/
+namespace LineDiff
+{
+	/**
+	* Range of lines [oldStart, oldEnd) of the old text replaced by the lines [newStart, newEnd) of the new text.
+	*/
+	struct Hunk
+	{
+		size_t oldStart;
+		size_t oldEnd;
+		size_t newStart;
+		size_t newEnd;
+	};
+
+	/**
+	* Above this number of edits the lines between the first and the last change are replaced at once.
+	*/
+	const int MAX_EDITS = 500;
+
+	/**
+	* Splits the text in lines, keeping the line terminators.
+	*/
+	void SplitLines( const wxString& text, std::vector< wxString >* lines );
+
+	/**
+	* Appends the hunks turning the old lines into the new ones, in order, none if they are equal.
+	* The common head and tail are skipped, the rest is compared with Myers' diff.
+	*/
+	void Compare( const std::vector< wxString >& oldLines, const std::vector< wxString >& newLines, std::vector< Hunk >* hunks );
+}
@@ -0,0 +1,55 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "parallel.h"
+
+#include <wx/log.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+void ParallelFor( size_t count, const std::function< void( size_t ) >& task )
+{
+	std::atomic< size_t > next( 0 );
+	auto run = [ count, &task, &next ]()
+	{
+		for ( size_t i = next++; i < count; i = next++ )
+		{
+			task( i );
+		}
+	};
+
+	const size_t threadCount = std::min< size_t >( std::max( std::thread::hardware_concurrency(), 1u ), count );
+	std::vector< std::thread > threads;
+	for ( size_t i = 1; i < threadCount; ++i )
+	{
+		threads.emplace_back( run );
+	}
+	run();
+	for ( std::vector< std::thread >::iterator thread = threads.begin(); thread != threads.end(); ++thread )
+	{
+		thread->join();
+	}
+
+	// Messages logged by the other threads
+	wxLog::FlushActive();
+}
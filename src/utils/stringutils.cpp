@@ -84,6 +84,40 @@ wxFontEncoding StringUtils::GetEncodingFromUser( const wxString& message )
 	return wxFontMapper::GetEncoding( selection );
 }
 
+wxString StringUtils::JsonString( const wxString& value )
+{
+	wxString escaped;
+	for ( wxString::const_iterator c = value.begin(); c != value.end(); ++c )
+	{
+		const wxUniChar ch = *c;
+		if ( ch == wxT('"') || ch == wxT('\\') )
+		{
+			escaped << wxT('\\') << ch;
+		}
+		else if ( ch == wxT('\n') )
+		{
+			escaped << wxT("\\n");
+		}
+		else if ( ch == wxT('\r') )
+		{
+			escaped << wxT("\\r");
+		}
+		else if ( ch == wxT('\t') )
+		{
+			escaped << wxT("\\t");
+		}
+		else if ( ch < 0x20 )
+		{
+			escaped << wxString::Format( wxT("\\u%04x"), (unsigned)ch.GetValue() );
+		}
+		else
+		{
+			escaped << ch;
+		}
+	}
+	return wxT("\"") + escaped + wxT("\"");
+}
+
 
 namespace XMLUtils
 {
@@ -39,6 +39,9 @@ namespace StringUtils
 
   wxString GetSupportedEncodings( bool columnateWithTab = true, wxArrayString* array = NULL );
   wxFontEncoding GetEncodingFromUser( const wxString& message );
+
+  // Quotes the value as a JSON string, escaping the quotes, the backslashes and the control characters
+  wxString JsonString( const wxString& value );
 }
 
 namespace XMLUtils
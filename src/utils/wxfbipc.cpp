@@ -30,9 +30,18 @@
 
 #include "debug.h"
 
+#include <wx/ffile.h>
 #include <wx/filename.h>
+#include <wx/stdpaths.h>
+#include <wx/tokenzr.h>
 #include <wx/wx.h>
 
+#include <random>
+
+#ifdef wxHAS_UNIX_DOMAIN_SOCKETS
+#include <sys/stat.h>
+#endif
+
 bool wxFBIPC::VerifySingleInstance( const wxString& file, bool switchTo )
 {
 	// Possible send a message to the running instance through this string later, for now it is left empty
@@ -211,10 +220,236 @@ bool wxFBIPC::CreateServer( const wxString& name )
 
 void wxFBIPC::Reset()
 {
+	m_generationServer.reset();
 	m_server.reset();
 	m_checker.reset();
 }
 
+namespace
+{
+	const wxString STOP_ITEM = wxT("stop");
+
+	// Bounds the requests read from the socket
+	const wxUint32 MAX_MESSAGE_SIZE = 16 * 1024 * 1024;
+
+	// Seconds a client has to send its request, the generation itself is not limited
+	const long REQUEST_TIMEOUT = 10;
+
+	struct SocketDestroyer
+	{
+		void operator()( wxSocketBase* socket ) const { socket->Destroy(); }
+	};
+
+	bool IsSocketFile( const wxString& service )
+	{
+		#ifdef wxHAS_UNIX_DOMAIN_SOCKETS
+			return service.Find( wxT('/') ) != wxNOT_FOUND;
+		#else
+			return false;
+		#endif
+	}
+
+	// The runtime directory of the user if there is one, it is only accessible by the user
+	wxString GetUserDirectory()
+	{
+		wxString dir;
+		#ifdef wxHAS_UNIX_DOMAIN_SOCKETS
+		if ( !wxGetEnv( wxT("XDG_RUNTIME_DIR"), &dir ) || !wxFileName::DirExists( dir ) )
+		#endif
+		{
+			dir = wxStandardPaths::Get().GetUserDataDir();
+		}
+
+		if ( !wxFileName::DirExists( dir ) )
+		{
+			wxFileName::Mkdir( dir, 0700, wxPATH_MKDIR_FULL );
+		}
+		return dir;
+	}
+
+	wxString GetTokenFile( const wxString& service )
+	{
+		wxString name = service;
+		const wxString forbidden = wxFileName::GetForbiddenChars() + wxT("/\\:");
+		for ( size_t c = 0; c < forbidden.length(); ++c )
+		{
+			name.Replace( wxString( forbidden[c] ), wxT("_") );
+		}
+		return wxFileName( GetUserDirectory(), wxT("wxFormBuilder-generate-") + name + wxT(".token") ).GetFullPath();
+	}
+
+	std::unique_ptr<wxSockAddress> GetAddress( const wxString& service )
+	{
+		#ifdef wxHAS_UNIX_DOMAIN_SOCKETS
+		if ( IsSocketFile( service ) )
+		{
+			std::unique_ptr<wxUNIXaddress> address( new wxUNIXaddress );
+			address->Filename( service );
+			return address;
+		}
+		#endif
+
+		std::unique_ptr<wxIPV4address> address( new wxIPV4address );
+		address->LocalHost();
+		address->Service( service );
+		return address;
+	}
+
+	wxString CreateToken()
+	{
+		std::random_device random;
+		wxString token;
+		for ( int i = 0; i < 4; ++i )
+		{
+			token << wxString::Format( wxT("%08x"), (unsigned int)random() );
+		}
+		return token;
+	}
+
+	// The file is created again, so it never keeps the permissions of an older file
+	bool WriteToken( const wxString& path, const wxString& token )
+	{
+		if ( wxFileName::FileExists( path ) && !wxRemoveFile( path ) )
+		{
+			return false;
+		}
+
+		wxFile file;
+		return file.Create( path, false, wxS_IRUSR | wxS_IWUSR ) && file.Write( token, wxConvUTF8 );
+	}
+
+	bool ReadToken( const wxString& path, wxString* token )
+	{
+		wxLogNull stopLogging;
+		wxFFile file( path, wxT("rb") );
+		return file.IsOpened() && file.ReadAll( token, wxConvUTF8 ) && !token->empty();
+	}
+
+	// A message is its length in four bytes, most significant first, followed by its UTF-8 text
+	bool WriteMessage( wxSocketBase* socket, const wxString& text )
+	{
+		const wxScopedCharBuffer utf8 = text.utf8_str();
+		const wxUint32 length = (wxUint32)utf8.length();
+		const unsigned char header[] = {
+			(unsigned char)( length >> 24 ), (unsigned char)( length >> 16 ), (unsigned char)( length >> 8 ), (unsigned char)length
+		};
+
+		socket->Write( header, sizeof( header ) );
+		if ( socket->Error() || socket->LastCount() != sizeof( header ) )
+		{
+			return false;
+		}
+
+		socket->Write( utf8.data(), length );
+		return !socket->Error() && socket->LastCount() == length;
+	}
+
+	bool ReadMessage( wxSocketBase* socket, wxString* text )
+	{
+		unsigned char header[4];
+		socket->Read( header, sizeof( header ) );
+		if ( socket->Error() || socket->LastCount() != sizeof( header ) )
+		{
+			return false;
+		}
+
+		const wxUint32 length = ( (wxUint32)header[0] << 24 ) | ( (wxUint32)header[1] << 16 ) | ( (wxUint32)header[2] << 8 ) | header[3];
+		if ( length > MAX_MESSAGE_SIZE )
+		{
+			return false;
+		}
+
+		std::string data( length, '\0' );
+		if ( length > 0 )
+		{
+			socket->Read( &data[0], length );
+			if ( socket->Error() || socket->LastCount() != length )
+			{
+				return false;
+			}
+		}
+
+		*text = wxString::FromUTF8( data.data(), data.size() );
+		return true;
+	}
+
+	// Sends a request to the generation server, returns false if there is no server
+	bool RequestGenerationServer( const wxString& service, const wxString& item, wxString* reply )
+	{
+		// Without the token there is no server of this user
+		wxString token;
+		if ( !ReadToken( GetTokenFile( service ), &token ) )
+		{
+			return false;
+		}
+
+		std::unique_ptr<wxSocketClient, SocketDestroyer> client( new wxSocketClient( wxSOCKET_WAITALL | wxSOCKET_BLOCK ) );
+		{
+			// Suspend logging, not finding a server is not an error
+			#ifndef __WXFB_DEBUG__
+			wxLogNull stopLogging;
+			#endif
+
+			std::unique_ptr<wxSockAddress> address = GetAddress( service );
+			if ( !client->Connect( *address, true ) )
+			{
+				return false;
+			}
+		}
+
+		wxString answer;
+		if ( !WriteMessage( client.get(), token ) || !WriteMessage( client.get(), item ) || !ReadMessage( client.get(), &answer ) )
+		{
+			return false;
+		}
+
+		if ( reply )
+		{
+			*reply = answer;
+		}
+		return true;
+	}
+}
+
+wxString wxFBIPC::GetGenerationService()
+{
+	#ifdef wxHAS_UNIX_DOMAIN_SOCKETS
+		wxFileName socket( GetUserDirectory(), wxString::Format( wxT("wxFormBuilder-%s-generate"), wxGetUserId().c_str() ) );
+		return socket.GetFullPath();
+	#else
+		return wxT("4270");
+	#endif
+}
+
+bool wxFBIPC::CreateGenerationServer( const wxString& service, GenerationHandler handler )
+{
+	auto server = std::make_unique<GenerationServer>( handler );
+	if ( !server->Create( service ) )
+	{
+		wxLogError( wxT("Failed to create the code generation server on %s"), service.c_str() );
+		return false;
+	}
+
+	m_generationServer = std::move( server );
+	return true;
+}
+
+bool wxFBIPC::RequestGeneration( const wxString& service, const wxString& languages, const wxArrayString& files, wxString* reply )
+{
+	wxString item = languages;
+	for ( size_t i = 0; i < files.GetCount(); ++i )
+	{
+		item << wxT("\n") << files[i];
+	}
+
+	return RequestGenerationServer( service, item, reply );
+}
+
+bool wxFBIPC::StopGenerationServer( const wxString& service )
+{
+	return RequestGenerationServer( service, STOP_ITEM, NULL );
+}
+
 wxConnectionBase* AppServer::OnAcceptConnection( const wxString& topic )
 {
 	if ( topic == m_name )
@@ -243,3 +478,108 @@ wxConnectionBase* AppClient::OnMakeConnection()
 {
 	return new AppConnection;
 }
+
+GenerationServer::~GenerationServer()
+{
+	if ( m_socket )
+	{
+		m_socket->Destroy();
+	}
+
+	if ( !m_tokenFile.empty() )
+	{
+		wxRemoveFile( m_tokenFile );
+	}
+
+	if ( !m_socketFile.empty() )
+	{
+		wxRemoveFile( m_socketFile );
+	}
+}
+
+bool GenerationServer::Create( const wxString& service )
+{
+	// A socket file left by a server which did not exit cleanly would make the bind fail
+	if ( IsSocketFile( service ) && wxFileName::FileExists( service ) )
+	{
+		wxRemoveFile( service );
+	}
+
+	std::unique_ptr<wxSockAddress> address = GetAddress( service );
+	std::unique_ptr<wxSocketServer, SocketDestroyer> socket( new wxSocketServer( *address ) );
+	if ( !socket->IsOk() )
+	{
+		return false;
+	}
+
+	if ( IsSocketFile( service ) )
+	{
+		m_socketFile = service;
+		#ifdef wxHAS_UNIX_DOMAIN_SOCKETS
+		chmod( service.fn_str(), S_IRUSR | S_IWUSR );
+		#endif
+	}
+
+	m_token = CreateToken();
+	m_tokenFile = GetTokenFile( service );
+	if ( !WriteToken( m_tokenFile, m_token ) )
+	{
+		wxLogError( wxT("Unable to write the token of the code generation server to %s"), m_tokenFile.c_str() );
+		m_tokenFile.clear();
+		return false;
+	}
+
+	m_socket = socket.release();
+	m_socket->SetEventHandler( *this );
+	m_socket->SetNotify( wxSOCKET_CONNECTION_FLAG );
+	m_socket->Notify( true );
+	Bind( wxEVT_SOCKET, &GenerationServer::OnSocketEvent, this );
+	return true;
+}
+
+void GenerationServer::OnSocketEvent( wxSocketEvent& event )
+{
+	if ( event.GetSocketEvent() != wxSOCKET_CONNECTION )
+	{
+		return;
+	}
+
+	std::unique_ptr<wxSocketBase, SocketDestroyer> client( m_socket->Accept( false ) );
+	if ( !client )
+	{
+		return;
+	}
+
+	client->SetFlags( wxSOCKET_WAITALL | wxSOCKET_BLOCK );
+	client->SetTimeout( REQUEST_TIMEOUT );
+
+	wxString token;
+	wxString item;
+	if ( !ReadMessage( client.get(), &token ) || !ReadMessage( client.get(), &item ) )
+	{
+		return;
+	}
+
+	if ( token != m_token )
+	{
+		WriteMessage( client.get(), wxT("ERROR The request does not have the token of this server") );
+		return;
+	}
+
+	if ( item == STOP_ITEM )
+	{
+		// Exits after answering
+		WriteMessage( client.get(), wxT("OK") );
+		wxTheApp->ExitMainLoop();
+		return;
+	}
+
+	wxArrayString files = wxStringTokenize( item, wxT("\n"), wxTOKEN_RET_EMPTY_ALL );
+	wxString languages;
+	if ( !files.IsEmpty() )
+	{
+		languages = files[0];
+		files.RemoveAt( 0 );
+	}
+	WriteMessage( client.get(), m_handler( languages, files ) );
+}
@@ -25,18 +25,29 @@
 #define WXFBIPC_H
 
 #include <wx/ipc.h>
+#include <wx/sckipc.h>
+#include <wx/socket.h>
+#include <functional>
 #include <memory>
 #include <wx/snglinst.h>
 
 /* Only allow one instance of a project to be loaded at a time */
 
 class AppServer;
+class GenerationServer;
+
+/**
+Handles a code generation request: generates the project files with the languages (the code_generation
+property of each project if empty), returning one status line per file, "OK <file>" or "ERROR <file>: <messages>".
+*/
+typedef std::function< wxString ( const wxString& languages, const wxArrayString& files ) > GenerationHandler;
 
 class wxFBIPC
 {
 	private:
 		std::unique_ptr<wxSingleInstanceChecker> m_checker;
 		std::unique_ptr<AppServer> m_server;
+		std::unique_ptr<GenerationServer> m_generationServer;
 		const int m_port;
 
 		bool CreateServer( const wxString& name );
@@ -50,6 +61,30 @@ class wxFBIPC
 
 		bool VerifySingleInstance( const wxString& file, bool switchTo = true );
 		void Reset();
+
+		/**
+		Default endpoint of the code generation server: a Unix domain socket in a directory of the user,
+		or a localhost port on Windows.
+		*/
+		static wxString GetGenerationService();
+
+		/**
+		Starts answering the generation requests on the endpoint, keeping this instance loaded between them.
+		The endpoint is only reachable from this machine, and only the requests with the token the server
+		writes to a file readable by its user are answered.
+		*/
+		bool CreateGenerationServer( const wxString& service, GenerationHandler handler );
+
+		/**
+		Sends a generation request to a running server.
+		@return false if there is no server on the endpoint, otherwise the status lines are stored in reply.
+		*/
+		static bool RequestGeneration( const wxString& service, const wxString& languages, const wxArrayString& files, wxString* reply );
+
+		/**
+		Asks a running server to exit.
+		*/
+		static bool StopGenerationServer( const wxString& service );
 };
 
 // Connection class, for use by both communicationg instances
@@ -72,6 +107,27 @@ public:
 	wxConnectionBase* OnAcceptConnection(const wxString& topic) override;
 };
 
+// Code generation server, on a Unix domain socket or a port bound to localhost, since wxTCPServer listens on
+// every interface and DDE items are too short for the requests. Each connection sends the token of the server and
+// the request, the languages followed by the files, one per line, and gets the status lines back.
+class GenerationServer : public wxEvtHandler
+{
+private:
+	GenerationHandler m_handler;
+	wxSocketServer* m_socket;
+	wxString m_socketFile;
+	wxString m_tokenFile;
+	wxString m_token;
+
+	void OnSocketEvent( wxSocketEvent& event );
+
+public:
+	GenerationServer( GenerationHandler handler ) : m_handler( handler ), m_socket( NULL ){}
+	~GenerationServer() override;
+
+	bool Create( const wxString& service );
+};
+
 // Client class, to be used by subsequent instances in OnInit
 class AppClient: public wxClient
 {
@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "testing.h"
+
+#include "../src/model/binaryproject.h"
+#include "../src/model/objectbase.h"
+#include "../src/rad/appdata.h"
+#include "../src/utils/wxfbexception.h"
+
+#include <ticpp.h>
+#include <wx/filename.h>
+
+namespace
+{
+	// The objects of the element, printed as the project files store them
+	std::string PrintElement( TiXmlElement* element )
+	{
+		ticpp::Element object( element );
+		return Testing::Print( AppData()->GetObjectDatabase()->CreateObject( &object ) );
+	}
+
+	void TestEncodeDecode()
+	{
+		const int major = AppData()->m_fbpVerMajor;
+		const int minor = AppData()->m_fbpVerMinor;
+		PObjectBase project = Testing::CreateProject();
+
+		const std::string data = BinaryProject::Encode( project, major, minor );
+		CHECK( BinaryProject::IsEncoded( data ) );
+		CHECK( !BinaryProject::IsEncoded( Testing::Print( project ) ) );
+
+		int dataMajor = 0, dataMinor = 0;
+		BinaryProject::GetVersion( data, wxT("test"), &dataMajor, &dataMinor );
+		CHECK_EQUAL( major, dataMajor );
+		CHECK_EQUAL( minor, dataMinor );
+
+		PObjectBase decoded = BinaryProject::Decode( AppData()->GetObjectDatabase(), data, wxT("test") );
+		CHECK( decoded );
+		CHECK_EQUAL( Testing::Print( project ), Testing::Print( decoded ) );
+
+		// A single form, as copied to the clipboard
+		PObjectBase form = project->GetChild( 0 );
+		PObjectBase decodedForm = BinaryProject::Decode( AppData()->GetObjectDatabase(), BinaryProject::Encode( form, major, minor ), wxT("test") );
+		CHECK( decodedForm );
+		CHECK_EQUAL( Testing::Print( form ), Testing::Print( decodedForm ) );
+	}
+
+	void TestDecodeToXml()
+	{
+		PObjectBase project = Testing::CreateProject();
+
+		// Any version can be decoded to XML, to be converted
+		const std::string data = BinaryProject::Encode( project, 1, 9 );
+
+		TiXmlElement element( "object" );
+		BinaryProject::DecodeToXml( data, wxT("test"), &element );
+		CHECK_EQUAL( Testing::Print( project ), PrintElement( &element ) );
+	}
+
+	void TestCorruptData()
+	{
+		const int major = AppData()->m_fbpVerMajor;
+		const int minor = AppData()->m_fbpVerMinor;
+		const std::string data = BinaryProject::Encode( Testing::CreateProject(), major, minor );
+
+		TiXmlElement element( "object" );
+		CHECK_THROWS( BinaryProject::DecodeToXml( data.substr( 0, data.size() / 2 ), wxT("test"), &element ), wxFBException );
+		CHECK_THROWS( BinaryProject::Decode( AppData()->GetObjectDatabase(), data.substr( 0, data.size() / 2 ), wxT("test") ), wxFBException );
+
+		// Only the current version is created directly, the others are converted as XML
+		CHECK_THROWS( BinaryProject::Decode( AppData()->GetObjectDatabase(), BinaryProject::Encode( Testing::CreateProject(), major, minor - 1 ), wxT("test") ), wxFBException );
+	}
+
+	void TestFile()
+	{
+		const int major = AppData()->m_fbpVerMajor;
+		const int minor = AppData()->m_fbpVerMinor;
+		const wxString path = wxFileName( Testing::CreateTempDir( wxT("binaryproject") ), wxT("test.fbpb") ).GetFullPath();
+		PObjectBase project = Testing::CreateProject();
+
+		CHECK( BinaryProject::HasBinaryExtension( path ) );
+		CHECK( !BinaryProject::HasBinaryExtension( wxT("test.fbp") ) );
+
+		BinaryProject::Write( project, path, major, minor );
+		CHECK( BinaryProject::IsBinaryFile( path ) );
+
+		int fileMajor = 0, fileMinor = 0;
+		BinaryProject::ReadVersion( path, &fileMajor, &fileMinor );
+		CHECK_EQUAL( major, fileMajor );
+		CHECK_EQUAL( minor, fileMinor );
+
+		PObjectBase read = BinaryProject::Read( AppData()->GetObjectDatabase(), path, major, minor );
+		CHECK( read );
+		CHECK_EQUAL( Testing::Print( project ), Testing::Print( read ) );
+
+		// As loaded from an XML project file
+		TiXmlDocument doc;
+		BinaryProject::ReadXml( path, &doc );
+		TiXmlElement* root = doc.FirstChildElement( "wxFormBuilder_Project" );
+		CHECK( root );
+		TiXmlElement* fileVersion = ( root ? root->FirstChildElement( "FileVersion" ) : NULL );
+		CHECK( fileVersion );
+		if ( fileVersion )
+		{
+			int xmlMajor = 0, xmlMinor = 0;
+			fileVersion->Attribute( "major", &xmlMajor );
+			fileVersion->Attribute( "minor", &xmlMinor );
+			CHECK_EQUAL( major, xmlMajor );
+			CHECK_EQUAL( minor, xmlMinor );
+		}
+		TiXmlElement* object = ( root ? root->FirstChildElement( "object" ) : NULL );
+		CHECK( object );
+		if ( object )
+		{
+			CHECK_EQUAL( Testing::Print( project ), PrintElement( object ) );
+		}
+
+		// A text file is not taken for a binary project
+		const wxString text = wxFileName( wxFileName( path ).GetPath(), wxT("test.fbp") ).GetFullPath();
+		Testing::WriteFile( text, Testing::Print( project ) );
+		CHECK( !BinaryProject::IsBinaryFile( text ) );
+		CHECK_THROWS( BinaryProject::ReadVersion( text, &fileMajor, &fileMinor ), wxFBException );
+	}
+
+	void RunTests()
+	{
+		TestEncodeDecode();
+		TestDecodeToXml();
+		TestCorruptData();
+		TestFile();
+	}
+}
+
+int main( int argc, char** argv )
+{
+	return Testing::RunWithApplication( argc, argv, RunTests );
+}
@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "testing.h"
+
+#include "../src/codegen/codeparser.h"
+
+#include <wx/filename.h>
+
+namespace
+{
+	const char* HEADER =
+		"#ifndef __Derived__\n"
+		"#define __Derived__\n"
+		"\n"
+		"/**\n"
+		"@file\n"
+		"Subclass of Base, which is generated by wxFormBuilder.\n"
+		"*/\n"
+		"\n"
+		"#include \"generated.h\"\n"
+		"\n"
+		"//// end generated include\n"
+		"#include <vector>\n"
+		"class DerivedHelper;\n"
+		"\n"
+		"/** Implementing Base */\n"
+		"class Derived : public Base\n"
+		"{\n"
+		"\tprotected:\n"
+		"\t\t// Handlers for Base events.\n"
+		"\t\tvoid OnButton( wxCommandEvent& event );\n"
+		"\tpublic:\n"
+		"\t\t/** Constructor */\n"
+		"\t\tDerived( wxWindow* parent );\n"
+		"\t//// end generated class members\n"
+		"\tconst char* m_close = \"}\"; // }\n"
+		"\tchar m_open = '{';\n"
+		"\tstd::vector< DerivedHelper* > m_helpers;\n"
+		"};\n"
+		"\n"
+		"#endif // __Derived__\n";
+
+	// Parses the files of the class Derived
+	void Parse( CCodeParser* parser, const std::string& header, const std::string& source )
+	{
+		const wxString dir = Testing::CreateTempDir( wxT("codeparser") );
+		const wxString headerFile = wxFileName( dir, wxT("Derived.h") ).GetFullPath();
+		const wxString sourceFile = wxFileName( dir, wxT("Derived.cpp") ).GetFullPath();
+		Testing::WriteFile( headerFile, header );
+		Testing::WriteFile( sourceFile, source );
+
+		*parser = CCodeParser( headerFile, sourceFile );
+		parser->ParseCFiles( wxT("Derived") );
+		CHECK( parser->IsParsed() );
+	}
+
+	void TestHeader()
+	{
+		CCodeParser parser;
+		Parse( &parser, HEADER, "" );
+
+		CHECK( parser.GetUserIncludes() == wxT("#include <vector>\nclass DerivedHelper;\n") );
+
+		// The braces in the literals and the comments do not close the class
+		CHECK( parser.GetUserMembers() ==
+			wxT("\tconst char* m_close = \"}\"; // }\n\tchar m_open = '{';\n\tstd::vector< DerivedHelper* > m_helpers;\n") );
+	}
+
+	void TestSource()
+	{
+		const char* source =
+			"#include \"Derived.h\"\n"
+			"// Derived::Commented() {\n"
+			"\n"
+			"Derived::Derived( wxWindow* parent )\n"
+			":\n"
+			"Base( parent )\n"
+			"{\n"
+			"\tconst char* text = \"} \\\" {\";\n"
+			"\tchar close = '}';\n"
+			"\tchar quote = '\\'';\n"
+			"\tchar backslash = '\\\\'; int million = 1'000'000;\n"
+			"\t/* } */ // }\n"
+			"\tif ( million ) { Call( '{' ); }\n"
+			"}\n"
+			"\n"
+			"int Derived::s_count = 0;\n"
+			"\n"
+			"// Handles the button\n"
+			"void Derived::OnButton( wxCommandEvent& event )\n"
+			"{\n"
+			"// TODO: Implement OnButton\n"
+			"}\n"
+			"\n"
+			"void Derived::UserFunction()\n"
+			"{\n"
+			"\tKeep();\n"
+			"}\n"
+			"// trailing\n";
+
+		CCodeParser parser;
+		Parse( &parser, HEADER, source );
+
+		CHECK( parser.GetFunctionContents( wxT("Derived::Derived( wxWindow* parent )\n:\nBase( parent )") ) ==
+			wxT("\tconst char* text = \"} \\\" {\";\n")
+			wxT("\tchar close = '}';\n")
+			wxT("\tchar quote = '\\'';\n")
+			wxT("\tchar backslash = '\\\\'; int million = 1'000'000;\n")
+			wxT("\t/* } */ // }\n")
+			wxT("\tif ( million ) { Call( '{' ); }") );
+
+		// The definition of a static member is not a function, the comments are the documentation
+		CHECK( parser.GetFunctionDocumentation( wxT("voidDerived::OnButton(wxCommandEvent&event)") ).Contains( wxT("int Derived::s_count = 0;") ) );
+		CHECK( parser.GetFunctionDocumentation( wxT("voidDerived::OnButton(wxCommandEvent&event)") ).Contains( wxT("// Handles the button") ) );
+		CHECK( parser.GetFunctionContents( wxT("void Derived::OnButton( wxCommandEvent& event )") ) == wxT("// TODO: Implement OnButton") );
+		CHECK( parser.GetFunctionContents( wxT("void Derived::OnButton( wxCommandEvent& event )") ).empty() );
+		CHECK( parser.GetFunctionContents( wxT("void Derived::Commented()") ).empty() );
+
+		// The user functions are kept
+		const wxString remaining = parser.GetRemainingFunctions();
+		CHECK( remaining.Contains( wxT("void Derived::UserFunction()\n{\n\tKeep();\n}") ) );
+		CHECK( !remaining.Contains( wxT("OnButton") ) );
+		CHECK( parser.GetTrailingCode() == wxT("\n// trailing") );
+	}
+
+	void TestLineEnds()
+	{
+		CCodeParser parser;
+		Parse( &parser, HEADER, "void Derived::OnButton( wxCommandEvent& event )\r\n{\r\n\tDone();\r\n}\r\n" );
+		CHECK( parser.GetFunctionContents( wxT("void Derived::OnButton( wxCommandEvent& event )") ) == wxT("\tDone();") );
+	}
+
+	void TestUnbalanced()
+	{
+		// The code after a function without its closing bracket is set aside, not lost
+		const char* source =
+			"void Derived::OnButton( wxCommandEvent& event )\n"
+			"{\n"
+			"\tFirst();\n"
+			"}\n"
+			"\n"
+			"void Derived::Broken()\n"
+			"{\n"
+			"\tif ( true ) {\n"
+			"\t\tLost(); // }\n"
+			"}\n";
+
+		CCodeParser parser;
+		Parse( &parser, HEADER, source );
+		CHECK( parser.GetFunctionContents( wxT("void Derived::OnButton( wxCommandEvent& event )") ) == wxT("\tFirst();") );
+		CHECK( parser.GetFunctionContents( wxT("void Derived::Broken()") ).empty() );
+		CHECK( parser.GetTrailingCode().StartsWith( wxT("//The Following Block is missing a closing bracket\n") ) );
+		CHECK( parser.GetTrailingCode().Contains( wxT("\t\tLost(); // }") ) );
+
+		// A string not closed on its line ends there, a comment not closed runs to the end of the file
+		Parse( &parser, HEADER,
+			"void Derived::OnButton( wxCommandEvent& event )\n{\n\tconst char* text = \"{;\n}\n"
+			"void Derived::Other()\n{\n/* }\n}\n" );
+		CHECK( parser.GetFunctionContents( wxT("void Derived::OnButton( wxCommandEvent& event )") ) == wxT("\tconst char* text = \"{;") );
+		CHECK( parser.GetTrailingCode().Contains( wxT("/* }") ) );
+
+		// A class without its closing bracket has no user members
+		Parse( &parser, "//// end generated include\n/** Implementing Base */\nclass Derived : public Base\n{\n\t//// end generated class members\n\tint m_member;\n", "" );
+		CHECK( parser.GetUserMembers().empty() );
+
+		// Missing files
+		parser = CCodeParser( wxT("missing.h"), wxT("missing.cpp") );
+		parser.ParseCFiles( wxT("Derived") );
+		CHECK( parser.GetUserIncludes().empty() );
+		CHECK( parser.GetUserMembers().empty() );
+		CHECK( parser.GetTrailingCode().empty() );
+	}
+
+	void RunTests()
+	{
+		TestHeader();
+		TestSource();
+		TestLineEnds();
+		TestUnbalanced();
+	}
+}
+
+int main( int argc, char** argv )
+{
+	return Testing::Run( argc, argv, RunTests );
+}
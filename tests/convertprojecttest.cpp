@@ -0,0 +1,163 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "testing.h"
+
+#include "../src/rad/appdata.h"
+
+#include <ticpp.h>
+
+namespace
+{
+	// The property of the object, NULL if it has none of that name
+	TiXmlElement* FindProperty( TiXmlElement* object, const char* name )
+	{
+		for ( TiXmlElement* prop = object->FirstChildElement( "property" ); prop; prop = prop->NextSiblingElement( "property" ) )
+		{
+			const char* propName = prop->Attribute( "name" );
+			if ( propName && std::string( propName ) == name )
+			{
+				return prop;
+			}
+		}
+		return NULL;
+	}
+
+	void CheckFileVersion( TiXmlElement* root )
+	{
+		TiXmlElement* fileVersion = root->FirstChildElement( "FileVersion" );
+		CHECK( fileVersion );
+		if ( fileVersion )
+		{
+			int major = 0, minor = 0;
+			fileVersion->Attribute( "major", &major );
+			fileVersion->Attribute( "minor", &minor );
+			CHECK_EQUAL( AppData()->m_fbpVerMajor, major );
+			CHECK_EQUAL( AppData()->m_fbpVerMinor, minor );
+		}
+	}
+
+	std::string Print( ticpp::Document& doc )
+	{
+		TiXmlPrinter printer;
+		doc.GetTiXmlPointer()->Accept( &printer );
+		return printer.Str();
+	}
+
+	// Projects without file version were written before the version 1.3
+	void TestUnversioned()
+	{
+		ticpp::Document doc;
+		doc.Parse(
+			"<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\" ?>"
+			"<object class=\"Project\">"
+			"  <property name=\"name\">OldProject</property>"
+			"  <property name=\"user_headers\"></property>"
+			"  <object class=\"Panel\">"
+			"    <property name=\"name\">MainPanel</property>"
+			"    <object class=\"wxBoxSizer\">"
+			"      <property name=\"orient\">wxVERTICAL</property>"
+			"      <object class=\"sizeritem\">"
+			"        <property name=\"option\">1</property>"
+			"        <object class=\"wxButton\">"
+			"          <property name=\"name\">m_button</property>"
+			"        </object>"
+			"      </object>"
+			"    </object>"
+			"  </object>"
+			"</object>", true, TIXML_ENCODING_UTF8 );
+
+		CHECK( AppData()->ConvertProjectDocument( doc, wxT("old.fbp"), 0, 0, false ) );
+
+		TiXmlElement* root = doc.GetTiXmlPointer()->FirstChildElement();
+		CHECK_EQUAL( std::string( "wxFormBuilder_Project" ), std::string( root->Value() ) );
+		CheckFileVersion( root );
+
+		TiXmlElement* project = root->FirstChildElement( "object" );
+		CHECK( project );
+		if ( !project )
+		{
+			return;
+		}
+		CHECK( !FindProperty( project, "user_headers" ) );
+
+		TiXmlElement* item = project->FirstChildElement( "object" )->FirstChildElement( "object" )->FirstChildElement( "object" );
+		CHECK( !FindProperty( item, "option" ) );
+		TiXmlElement* proportion = FindProperty( item, "proportion" );
+		CHECK( proportion );
+		CHECK( proportion && proportion->GetText() && std::string( proportion->GetText() ) == "1" );
+		CHECK( item->FirstChildElement( "object" ) );
+	}
+
+	void TestVersioned()
+	{
+		ticpp::Document doc;
+		doc.Parse(
+			"<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\" ?>"
+			"<wxFormBuilder_Project>"
+			"  <FileVersion major=\"1\" minor=\"4\" />"
+			"  <object class=\"Project\">"
+			"    <property name=\"name\">OldProject</property>"
+			"    <property name=\"user_headers\">#include &lt;wx/wx.h&gt;</property>"
+			"    <object class=\"Panel\">"
+			"      <property name=\"name\">MainPanel</property>"
+			"    </object>"
+			"  </object>"
+			"</wxFormBuilder_Project>", true, TIXML_ENCODING_UTF8 );
+
+		CHECK( AppData()->ConvertProjectDocument( doc, wxT("old.fbp"), 1, 4, false ) );
+
+		TiXmlElement* root = doc.GetTiXmlPointer()->FirstChildElement( "wxFormBuilder_Project" );
+		CHECK( root );
+		if ( !root )
+		{
+			return;
+		}
+		CheckFileVersion( root );
+
+		TiXmlElement* project = root->FirstChildElement( "object" );
+		CHECK( !FindProperty( project, "user_headers" ) );
+		CHECK( project->FirstChildElement( "object" ) );
+	}
+
+	// A project of the current version is left as it is
+	void TestCurrent()
+	{
+		ticpp::Document doc;
+		Testing::CreateProject()->Serialize( &doc );
+		const std::string before = Print( doc );
+
+		CHECK( AppData()->ConvertProjectDocument( doc, wxT("current.fbp"), AppData()->m_fbpVerMajor, AppData()->m_fbpVerMinor, false ) );
+		CHECK_EQUAL( before, Print( doc ) );
+	}
+
+	void RunTests()
+	{
+		TestUnversioned();
+		TestVersioned();
+		TestCurrent();
+	}
+}
+
+int main( int argc, char** argv )
+{
+	return Testing::RunWithApplication( argc, argv, RunTests );
+}
@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "testing.h"
+
+#include "../src/codegen/generationcache.h"
+
+#include <wx/filename.h>
+
+namespace
+{
+	void TestInvalidation()
+	{
+		const wxString outputDir = Testing::CreateTempDir( wxT("generationcache-output") );
+		const wxString manifestDir = wxFileName( Testing::CreateTempDir( wxT("generationcache-manifests") ), wxT("generation") ).GetFullPath();
+
+		wxArrayString outputs;
+		outputs.Add( wxFileName( outputDir, wxT("test.h") ).GetFullPath() );
+		outputs.Add( wxFileName( outputDir, wxT("test.cpp") ).GetFullPath() );
+		Testing::WriteFile( outputs[0], "header" );
+		Testing::WriteFile( outputs[1], "source" );
+
+		{
+			GenerationCache cache( outputDir, wxT("test"), manifestDir );
+			CHECK( !cache.IsUpToDate( wxT("C++"), wxT("key"), outputs ) );
+
+			// The directory of the manifests is created on demand
+			cache.Store( wxT("C++"), wxT("key"), outputs );
+			CHECK( cache.IsUpToDate( wxT("C++"), wxT("key"), outputs ) );
+		}
+
+		// The manifest is kept for the same path and file, and only for them
+		CHECK( GenerationCache( outputDir, wxT("test"), manifestDir ).IsUpToDate( wxT("C++"), wxT("key"), outputs ) );
+		CHECK( !GenerationCache( outputDir, wxT("other"), manifestDir ).IsUpToDate( wxT("C++"), wxT("key"), outputs ) );
+
+		GenerationCache cache( outputDir, wxT("test"), manifestDir );
+
+		// Other inputs, language or outputs
+		CHECK( !cache.IsUpToDate( wxT("C++"), wxT("changed"), outputs ) );
+		CHECK( !cache.IsUpToDate( wxT("Python"), wxT("key"), outputs ) );
+		wxArrayString fewer;
+		fewer.Add( outputs[0] );
+		CHECK( !cache.IsUpToDate( wxT("C++"), wxT("key"), fewer ) );
+
+		// Each language has its own record
+		cache.Store( wxT("Python"), wxT("python"), fewer );
+		CHECK( cache.IsUpToDate( wxT("Python"), wxT("python"), fewer ) );
+		CHECK( cache.IsUpToDate( wxT("C++"), wxT("key"), outputs ) );
+
+		// An output modified by someone else
+		Testing::WriteFile( outputs[1], "modified source" );
+		CHECK( !cache.IsUpToDate( wxT("C++"), wxT("key"), outputs ) );
+		cache.Store( wxT("C++"), wxT("key"), outputs );
+		CHECK( cache.IsUpToDate( wxT("C++"), wxT("key"), outputs ) );
+
+		// A deleted output
+		wxRemoveFile( outputs[1] );
+		CHECK( !cache.IsUpToDate( wxT("C++"), wxT("key"), outputs ) );
+	}
+
+	void RunTests()
+	{
+		TestInvalidation();
+	}
+}
+
+int main( int argc, char** argv )
+{
+	return Testing::Run( argc, argv, RunTests );
+}
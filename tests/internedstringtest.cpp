@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "testing.h"
+
+#include "../src/utils/internedstring.h"
+
+namespace
+{
+	void TestIdentity()
+	{
+		const InternedString first( wxT("wxALL") );
+		const InternedString second( wxString( wxT("wxALL") ) );
+		const InternedString other( wxT("wxEXPAND") );
+
+		// Equal values share their storage, converted once
+		CHECK( first == second );
+		CHECK( &first.GetUTF8() == &second.GetUTF8() );
+		CHECK( &first.ToString() == &second.ToString() );
+		CHECK( first != other );
+		CHECK( InternedString::FromUTF8( "wxALL", 5 ) == first );
+
+		// A copy is the same value
+		InternedString copy = other;
+		CHECK( copy == other );
+		copy = first;
+		CHECK( copy == first );
+		CHECK( copy != other );
+	}
+
+	void TestEmpty()
+	{
+		const InternedString none;
+		CHECK( none.empty() );
+		CHECK( none.ToString().empty() );
+		CHECK( none.GetUTF8().empty() );
+		CHECK_EQUAL( 0u, none.GetStorageSize() );
+
+		// Every empty value is the same
+		CHECK( InternedString( wxEmptyString ) == none );
+		CHECK( InternedString( wxString() ).empty() );
+		CHECK( InternedString::FromUTF8( "", 0 ) == none );
+		CHECK( !InternedString( wxT(" ") ).empty() );
+	}
+
+	void TestUTF8()
+	{
+		// U+00DC, U+20AC and U+1D11E: two, three and four bytes in UTF-8
+		const char utf8[] = "\xc3\x9c \xe2\x82\xac \xf0\x9d\x84\x9e";
+		const wxString text = wxString::FromUTF8( utf8 );
+		CHECK_EQUAL( std::string( utf8 ), std::string( text.utf8_str() ) );
+
+		const InternedString fromText( text );
+		const InternedString fromUTF8 = InternedString::FromUTF8( utf8, sizeof( utf8 ) - 1 );
+		CHECK( fromText == fromUTF8 );
+		CHECK_EQUAL( std::string( utf8 ), fromText.GetUTF8() );
+		CHECK( text == fromUTF8.ToString() );
+		CHECK( text == static_cast< const wxString& >( fromUTF8 ) );
+
+		// Embedded line breaks and quotes are kept as they are
+		const wxString multiline = wxT("\"first\"\nsecond\r\n");
+		CHECK( multiline == InternedString( multiline ).ToString() );
+	}
+
+	void TestPool()
+	{
+		const size_t size = InternedString::GetPoolSize();
+		{
+			const InternedString value( wxT("a value of the interned string test") );
+			const InternedString same( wxT("a value of the interned string test") );
+			CHECK_EQUAL( size + 1, InternedString::GetPoolSize() );
+			CHECK( value.GetStorageSize() > 0 );
+		}
+
+		// The value is dropped with its last owner, and interned again when needed
+		CHECK_EQUAL( size, InternedString::GetPoolSize() );
+		CHECK( !InternedString( wxT("a value of the interned string test") ).empty() );
+		CHECK_EQUAL( size, InternedString::GetPoolSize() );
+	}
+
+	void RunTests()
+	{
+		TestIdentity();
+		TestEmpty();
+		TestUTF8();
+		TestPool();
+	}
+}
+
+int main( int argc, char** argv )
+{
+	return Testing::Run( argc, argv, RunTests );
+}
@@ -0,0 +1,218 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "testing.h"
+
+#include "../src/utils/linediff.h"
+
+namespace
+{
+	typedef std::vector< wxString > Lines;
+	typedef std::vector< LineDiff::Hunk > Hunks;
+
+	Lines Split( const wxString& text )
+	{
+		Lines lines;
+		LineDiff::SplitLines( text, &lines );
+		return lines;
+	}
+
+	// The old lines with the hunks applied, as TCCodeWriter::Flush does
+	Lines Apply( const Lines& oldLines, const Lines& newLines, const Hunks& hunks )
+	{
+		Lines result;
+		size_t oldPos = 0;
+		for ( Hunks::const_iterator hunk = hunks.begin(); hunk != hunks.end(); ++hunk )
+		{
+			CHECK( hunk->oldStart >= oldPos );
+			CHECK( hunk->oldStart <= hunk->oldEnd && hunk->oldEnd <= oldLines.size() );
+			CHECK( hunk->newStart <= hunk->newEnd && hunk->newEnd <= newLines.size() );
+
+			result.insert( result.end(), oldLines.begin() + oldPos, oldLines.begin() + hunk->oldStart );
+			result.insert( result.end(), newLines.begin() + hunk->newStart, newLines.begin() + hunk->newEnd );
+			oldPos = hunk->oldEnd;
+		}
+		result.insert( result.end(), oldLines.begin() + oldPos, oldLines.end() );
+		return result;
+	}
+
+	// Compares the texts and checks the hunks give the new text, returns them
+	Hunks Compare( const wxString& oldText, const wxString& newText )
+	{
+		const Lines oldLines = Split( oldText );
+		const Lines newLines = Split( newText );
+
+		Hunks hunks;
+		LineDiff::Compare( oldLines, newLines, &hunks );
+		CHECK( Apply( oldLines, newLines, hunks ) == newLines );
+		return hunks;
+	}
+
+	bool IsHunk( const Hunks& hunks, size_t index, size_t oldStart, size_t oldEnd, size_t newStart, size_t newEnd )
+	{
+		return index < hunks.size() && hunks[ index ].oldStart == oldStart && hunks[ index ].oldEnd == oldEnd &&
+			hunks[ index ].newStart == newStart && hunks[ index ].newEnd == newEnd;
+	}
+
+	void TestSplitLines()
+	{
+		CHECK( Split( wxEmptyString ).empty() );
+
+		const Lines lines = Split( wxT("first\nsecond\r\n\nlast") );
+		CHECK_EQUAL( 4u, lines.size() );
+		CHECK( lines[0] == wxT("first\n") );
+		CHECK( lines[1] == wxT("second\r\n") );
+		CHECK( lines[2] == wxT("\n") );
+		CHECK( lines[3] == wxT("last") );
+
+		CHECK_EQUAL( 1u, Split( wxT("line\n") ).size() );
+	}
+
+	void TestUnchanged()
+	{
+		CHECK( Compare( wxEmptyString, wxEmptyString ).empty() );
+		CHECK( Compare( wxT("a\nb\nc\n"), wxT("a\nb\nc\n") ).empty() );
+	}
+
+	void TestEmpty()
+	{
+		Hunks hunks = Compare( wxEmptyString, wxT("a\nb\n") );
+		CHECK_EQUAL( 1u, hunks.size() );
+		CHECK( IsHunk( hunks, 0, 0, 0, 0, 2 ) );
+
+		hunks = Compare( wxT("a\nb\n"), wxEmptyString );
+		CHECK_EQUAL( 1u, hunks.size() );
+		CHECK( IsHunk( hunks, 0, 0, 2, 0, 0 ) );
+	}
+
+	void TestInsert()
+	{
+		const wxString text = wxT("a\nb\nc\n");
+
+		Hunks hunks = Compare( text, wxT("x\na\nb\nc\n") );
+		CHECK_EQUAL( 1u, hunks.size() );
+		CHECK( IsHunk( hunks, 0, 0, 0, 0, 1 ) );
+
+		hunks = Compare( text, wxT("a\nx\ny\nb\nc\n") );
+		CHECK_EQUAL( 1u, hunks.size() );
+		CHECK( IsHunk( hunks, 0, 1, 1, 1, 3 ) );
+
+		hunks = Compare( text, wxT("a\nb\nc\nx\n") );
+		CHECK_EQUAL( 1u, hunks.size() );
+		CHECK( IsHunk( hunks, 0, 3, 3, 3, 4 ) );
+
+		// A last line without terminator is a different line once one is added after it
+		hunks = Compare( wxT("a\nb"), wxT("a\nb\nc") );
+		CHECK_EQUAL( 1u, hunks.size() );
+		CHECK( IsHunk( hunks, 0, 1, 2, 1, 3 ) );
+	}
+
+	void TestDelete()
+	{
+		const wxString text = wxT("a\nb\nc\nd\n");
+
+		Hunks hunks = Compare( text, wxT("b\nc\nd\n") );
+		CHECK_EQUAL( 1u, hunks.size() );
+		CHECK( IsHunk( hunks, 0, 0, 1, 0, 0 ) );
+
+		hunks = Compare( text, wxT("a\nd\n") );
+		CHECK_EQUAL( 1u, hunks.size() );
+		CHECK( IsHunk( hunks, 0, 1, 3, 1, 1 ) );
+
+		hunks = Compare( text, wxT("a\nb\nc\n") );
+		CHECK_EQUAL( 1u, hunks.size() );
+		CHECK( IsHunk( hunks, 0, 3, 4, 3, 3 ) );
+	}
+
+	void TestReplace()
+	{
+		const wxString text = wxT("a\nb\nc\n");
+
+		Hunks hunks = Compare( text, wxT("x\nb\nc\n") );
+		CHECK_EQUAL( 1u, hunks.size() );
+		CHECK( IsHunk( hunks, 0, 0, 1, 0, 1 ) );
+
+		hunks = Compare( text, wxT("a\nx\nc\n") );
+		CHECK_EQUAL( 1u, hunks.size() );
+		CHECK( IsHunk( hunks, 0, 1, 2, 1, 2 ) );
+
+		hunks = Compare( text, wxT("a\nb\nx\n") );
+		CHECK_EQUAL( 1u, hunks.size() );
+		CHECK( IsHunk( hunks, 0, 2, 3, 2, 3 ) );
+
+		// Separate changes are separate hunks, the repeated lines between them are kept
+		hunks = Compare( wxT("a\n}\n}\nb\n}\nc\n"), wxT("x\n}\n}\nb\n}\ny\n") );
+		CHECK_EQUAL( 2u, hunks.size() );
+		CHECK( IsHunk( hunks, 0, 0, 1, 0, 1 ) );
+		CHECK( IsHunk( hunks, 1, 5, 6, 5, 6 ) );
+
+		// The lines that moved are found between the changes
+		hunks = Compare( wxT("a\nb\nc\nd\ne\n"), wxT("a\nc\nd\nb\ne\n") );
+		CHECK_EQUAL( 2u, hunks.size() );
+	}
+
+	void TestFallback()
+	{
+		// Every other line changes, twice as many edits as the limit
+		wxString oldText = wxT("head\n");
+		wxString newText = wxT("head\n");
+		const int changes = LineDiff::MAX_EDITS;
+		for ( int i = 0; i < changes; ++i )
+		{
+			oldText += wxString::Format( wxT("old %d\n}\n"), i );
+			newText += wxString::Format( wxT("new %d\n}\n"), i );
+		}
+		oldText += wxT("tail\n");
+		newText += wxT("tail\n");
+
+		// The range between the first and the last change is replaced at once
+		Hunks hunks = Compare( oldText, newText );
+		CHECK_EQUAL( 1u, hunks.size() );
+		CHECK( IsHunk( hunks, 0, 1, 2 * changes, 1, 2 * changes ) );
+
+		// Under the limit, each change is its own hunk
+		oldText = wxT("head\n");
+		newText = wxT("head\n");
+		for ( int i = 0; i < changes / 4; ++i )
+		{
+			oldText += wxString::Format( wxT("old %d\n}\n"), i );
+			newText += wxString::Format( wxT("new %d\n}\n"), i );
+		}
+		hunks = Compare( oldText, newText );
+		CHECK_EQUAL( (size_t)( changes / 4 ), hunks.size() );
+	}
+
+	void RunTests()
+	{
+		TestSplitLines();
+		TestUnchanged();
+		TestEmpty();
+		TestInsert();
+		TestDelete();
+		TestReplace();
+		TestFallback();
+	}
+}
+
+int main( int argc, char** argv )
+{
+	return Testing::Run( argc, argv, RunTests );
+}
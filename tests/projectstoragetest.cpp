@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "testing.h"
+
+#include "../src/model/objectbase.h"
+#include "../src/model/projectstorage.h"
+#include "../src/rad/appdata.h"
+#include "../src/utils/wxfbexception.h"
+
+#include <ticpp.h>
+#include <wx/filename.h>
+
+namespace
+{
+	void Save( PObjectBase project, const wxString& projectFile )
+	{
+		ticpp::Document doc;
+		project->Serialize( &doc );
+		ProjectStorage::Save( project, &doc, projectFile );
+	}
+
+	PObjectBase Load( const wxString& projectFile )
+	{
+		ticpp::Document doc;
+		doc.LoadFile( std::string( projectFile.mb_str( wxConvFile ) ), TIXML_ENCODING_UTF8 );
+
+		ticpp::Element* root = doc.FirstChildElement( "wxFormBuilder_Project" );
+		CHECK( ProjectStorage::IsSplit( root ) );
+
+		// The split projects have the file version of the other projects
+		ticpp::Element* fileVersion = root->FirstChildElement( "FileVersion" );
+		int minor = 0;
+		fileVersion->GetAttribute( "minor", &minor );
+		CHECK_EQUAL( AppData()->m_fbpVerMinor, minor );
+
+		// The project file only references the forms
+		ticpp::Element* object = root->FirstChildElement( "object" );
+		CHECK( !object->FirstChildElement( "object", false ) );
+		CHECK( object->FirstChildElement( "form", false ) );
+
+		PObjectBase project = AppData()->GetObjectDatabase()->CreateObject( object );
+		ProjectStorage::LoadForms( AppData()->GetObjectDatabase(), object, project, ::wxPathOnly( projectFile ) );
+		return project;
+	}
+
+	void TestPaths()
+	{
+		const wxString projectFile = wxFileName( wxT("dir"), wxT("test.fbp") ).GetFullPath();
+		const wxString formsDir = ProjectStorage::GetFormsDirectory( projectFile );
+		CHECK_EQUAL( wxFileName( wxT("dir"), wxT("test_forms") ).GetFullPath(), formsDir );
+		CHECK_EQUAL( projectFile, ProjectStorage::GetProjectOfForm( wxFileName( formsDir, wxT("MainPanel.fbf") ).GetFullPath() ) );
+		CHECK( ProjectStorage::GetProjectOfForm( wxFileName( formsDir, wxT("MainPanel.txt") ).GetFullPath() ).empty() );
+	}
+
+	void TestSaveLoad()
+	{
+		const wxString projectFile = wxFileName( Testing::CreateTempDir( wxT("projectstorage") ), wxT("test.fbp") ).GetFullPath();
+		const wxString formsDir = ProjectStorage::GetFormsDirectory( projectFile );
+		PObjectBase project = Testing::CreateProject();
+
+		Save( project, projectFile );
+		const wxString mainForm = wxFileName( formsDir, wxT("MainPanel.fbf") ).GetFullPath();
+		const wxString otherForm = wxFileName( formsDir, wxT("OtherPanel.fbf") ).GetFullPath();
+		CHECK( wxFileName::FileExists( projectFile ) );
+		CHECK( wxFileName::FileExists( mainForm ) );
+		CHECK( wxFileName::FileExists( otherForm ) );
+
+		PObjectBase loaded = Load( projectFile );
+		CHECK_EQUAL( Testing::Print( project ), Testing::Print( loaded ) );
+
+		// Saving again only writes the files that changed
+		const wxDateTime mainTime = wxFileName( mainForm ).GetModificationTime();
+		Testing::WriteFile( otherForm, "changed" );
+		Save( loaded, projectFile );
+		CHECK( mainTime == wxFileName( mainForm ).GetModificationTime() );
+		CHECK_EQUAL( Testing::Print( project ), Testing::Print( Load( projectFile ) ) );
+
+		// The file of a removed form is deleted
+		loaded->RemoveChild( 1 );
+		Save( loaded, projectFile );
+		CHECK( wxFileName::FileExists( mainForm ) );
+		CHECK( !wxFileName::FileExists( otherForm ) );
+		CHECK_EQUAL( Testing::Print( loaded ), Testing::Print( Load( projectFile ) ) );
+		CHECK_EQUAL( 1u, Load( projectFile )->GetChildCount() );
+	}
+
+	void TestMissingForm()
+	{
+		const wxString projectFile = wxFileName( Testing::CreateTempDir( wxT("projectstorage-missing") ), wxT("test.fbp") ).GetFullPath();
+		Save( Testing::CreateProject(), projectFile );
+		wxRemoveFile( wxFileName( ProjectStorage::GetFormsDirectory( projectFile ), wxT("OtherPanel.fbf") ).GetFullPath() );
+
+		CHECK_THROWS( Load( projectFile ), wxFBException );
+	}
+
+	void RunTests()
+	{
+		TestPaths();
+		TestSaveLoad();
+		TestMissingForm();
+	}
+}
+
+int main( int argc, char** argv )
+{
+	return Testing::RunWithApplication( argc, argv, RunTests );
+}
@@ -0,0 +1,213 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "testing.h"
+
+#include "../src/model/objectbase.h"
+#include "../src/rad/appdata.h"
+#include "../src/utils/wxfbexception.h"
+
+#include <ticpp.h>
+#include <wx/app.h>
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/image.h>
+#include <wx/init.h>
+#include <wx/log.h>
+#include <wx/utils.h>
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+	// Exit code of the tests that can not run, as understood by meson
+	const int SKIPPED = 77;
+
+	int s_failures = 0;
+	std::vector< wxString > s_tempDirs;
+
+	int RunTests( void ( *tests )() )
+	{
+		// The messages of the code under test go to the output of the test, never to a dialog
+		wxLog* previousLog = wxLog::SetActiveTarget( new wxLogStderr );
+
+		try
+		{
+			tests();
+		}
+		catch ( wxFBException& ex )
+		{
+			Testing::Fail( std::string( "wxFBException: " ) + std::string( wxString( ex.what() ).utf8_str() ), __FILE__, __LINE__ );
+		}
+		catch ( ticpp::Exception& ex )
+		{
+			Testing::Fail( "ticpp::Exception: " + ex.m_details, __FILE__, __LINE__ );
+		}
+		wxLog::FlushActive();
+		delete wxLog::SetActiveTarget( previousLog );
+
+		for ( std::vector< wxString >::iterator dir = s_tempDirs.begin(); dir != s_tempDirs.end(); ++dir )
+		{
+			wxFileName::Rmdir( *dir, wxPATH_RMDIR_RECURSIVE );
+		}
+
+		if ( s_failures != 0 )
+		{
+			std::cerr << s_failures << " checks failed" << std::endl;
+			return 1;
+		}
+		return 0;
+	}
+
+	const char* PROJECT_XML =
+		"<object class=\"Project\" expanded=\"1\">"
+		"  <property name=\"name\">TestProject</property>"
+		"  <property name=\"file\">test</property>"
+		"  <property name=\"split_forms\">1</property>"
+		"  <object class=\"Panel\" expanded=\"1\">"
+		"    <property name=\"name\">MainPanel</property>"
+		"    <event name=\"OnInitDialog\">OnInitDialog</event>"
+		"    <object class=\"wxBoxSizer\" expanded=\"1\">"
+		"      <property name=\"name\">mainSizer</property>"
+		"      <property name=\"orient\">wxHORIZONTAL</property>"
+		"      <object class=\"sizeritem\" expanded=\"1\">"
+		"        <property name=\"proportion\">1</property>"
+		"        <object class=\"wxButton\" expanded=\"0\">"
+		"          <property name=\"name\">m_button</property>"
+		"          <property name=\"label\">&quot;Quoted&quot; &amp; \xc3\x9cnicode&#x0A;second line</property>"
+		"          <event name=\"OnButtonClick\">OnButton</event>"
+		"        </object>"
+		"      </object>"
+		"    </object>"
+		"  </object>"
+		"  <object class=\"Panel\" expanded=\"1\">"
+		"    <property name=\"name\">OtherPanel</property>"
+		"  </object>"
+		"</object>";
+}
+
+void Testing::Fail( const std::string& message, const char* file, int line )
+{
+	++s_failures;
+	std::cerr << file << ":" << line << ": check failed: " << message << std::endl;
+}
+
+int Testing::Run( int argc, char** argv, void ( *tests )() )
+{
+	wxInitializer initializer( argc, argv );
+	if ( !initializer.IsOk() )
+	{
+		std::cerr << "Unable to initialize wxWidgets" << std::endl;
+		return 1;
+	}
+
+	return RunTests( tests );
+}
+
+int Testing::RunWithApplication( int argc, char** argv, void ( *tests )() )
+{
+	if ( argc < 2 )
+	{
+		std::cerr << "Usage: " << argv[0] << " <source directory>" << std::endl;
+		return 1;
+	}
+	const wxString sourceDir = wxString( argv[1], wxConvFile );
+
+	// The object database and the application data use bitmaps and windows
+	wxApp::SetInstance( new wxApp );
+	if ( !wxEntryStart( argc, argv ) )
+	{
+		std::cerr << "Unable to initialize wxWidgets, there may be no display" << std::endl;
+		return SKIPPED;
+	}
+	wxInitAllImageHandlers();
+
+	int result = 1;
+	try
+	{
+		AppDataCreate( wxFileName( sourceDir, wxT("output") ).GetFullPath() );
+		AppData()->GetObjectDatabase()->SetPluginPath( wxFileName( sourceDir, wxEmptyString ).GetPath( wxPATH_GET_SEPARATOR ) +
+			wxT("tests") + wxFILE_SEP_PATH + wxT("data") + wxFILE_SEP_PATH + wxT("plugins") + wxFILE_SEP_PATH );
+		AppData()->LoadApp();
+
+		result = RunTests( tests );
+	}
+	catch ( wxFBException& ex )
+	{
+		std::cerr << "Unable to load the application data: " << wxString( ex.what() ).utf8_str() << std::endl;
+	}
+
+	AppDataDestroy();
+	wxEntryCleanup();
+	return result;
+}
+
+wxString Testing::CreateTempDir( const wxString& name )
+{
+	const wxString dir = wxFileName( wxFileName::GetTempDir(),
+		wxString::Format( wxT("wxfb-%s-%lu"), name.c_str(), wxGetProcessId() ) ).GetFullPath();
+	wxFileName::Rmdir( dir, wxPATH_RMDIR_RECURSIVE );
+	if ( !wxFileName::Mkdir( dir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+	{
+		THROW_WXFBEX( wxT("Unable to create directory: ") << dir )
+	}
+
+	s_tempDirs.push_back( dir );
+	return dir;
+}
+
+void Testing::WriteFile( const wxString& path, const std::string& contents )
+{
+	wxFFile file( path, wxT("wb") );
+	if ( !file.IsOpened() || !file.Write( contents.data(), contents.size() ) )
+	{
+		THROW_WXFBEX( wxT("Unable to write file: ") << path )
+	}
+}
+
+PObjectBase Testing::CreateProject()
+{
+	return CreateObject( PROJECT_XML );
+}
+
+PObjectBase Testing::CreateObject( const std::string& xml )
+{
+	ticpp::Document doc;
+	doc.Parse( xml, true, TIXML_ENCODING_UTF8 );
+
+	PObjectBase obj = AppData()->GetObjectDatabase()->CreateObject( doc.FirstChildElement() );
+	if ( !obj )
+	{
+		THROW_WXFBEX( wxT("Unable to create the object of the test") )
+	}
+	return obj;
+}
+
+std::string Testing::Print( PObjectBase obj )
+{
+	ticpp::Document doc;
+	obj->Serialize( &doc );
+
+	TiXmlPrinter printer;
+	doc.GetTiXmlPointer()->FirstChildElement()->FirstChildElement( "object" )->Accept( &printer );
+	return printer.Str();
+}
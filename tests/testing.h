@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// wxFormBuilder - A Visual Dialog Editor for wxWidgets.
+// Copyright (C) 2005 José Antonio Hurtado
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+///////////////////////////////////////////////////////////////////////////////
+/**
+@file
+Minimal harness of the tests: checks, temporary directories and the test object database.
+*/
+
+#ifndef __WXFB_TESTING__
+#define __WXFB_TESTING__
+
+#include "../src/utils/wxfbdefs.h"
+
+#include <wx/string.h>
+
+#include <string>
+
+namespace Testing
+{
+	/**
+	* Records a failed check, printed with its location.
+	*/
+	void Fail( const std::string& message, const char* file, int line );
+
+	/**
+	* Runs the tests with wxWidgets initialized as a console application. Returns the exit code of the test.
+	*/
+	int Run( int argc, char** argv, void ( *tests )() );
+
+	/**
+	* Runs the tests with wxWidgets initialized as a GUI application, the application data created and its
+	* object database loaded with the objects of tests/data instead of the plugins. The only argument is the source
+	* directory. Returns the exit code of the test, the skip code if there is no display.
+	*/
+	int RunWithApplication( int argc, char** argv, void ( *tests )() );
+
+	/**
+	* New empty directory, removed with its contents when the test ends.
+	*/
+	wxString CreateTempDir( const wxString& name );
+
+	/**
+	* Writes the text to the file, replacing it.
+	*/
+	void WriteFile( const wxString& path, const std::string& contents );
+
+	/**
+	* Project of the test objects: two forms, the first one with a sizer, a button and events.
+	*/
+	PObjectBase CreateProject();
+
+	/**
+	* The project created from the XML of the object, as stored in the project files.
+	*/
+	PObjectBase CreateObject( const std::string& xml );
+
+	/**
+	* XML of the object and its children, as stored in the project files, to compare objects.
+	*/
+	std::string Print( PObjectBase obj );
+}
+
+#define CHECK( condition ) \
+	do { if ( !( condition ) ) Testing::Fail( #condition, __FILE__, __LINE__ ); } while ( false )
+
+#define CHECK_EQUAL( expected, actual ) \
+	do { if ( !( ( expected ) == ( actual ) ) ) Testing::Fail( #expected " == " #actual, __FILE__, __LINE__ ); } while ( false )
+
+#define CHECK_THROWS( statement, exception ) \
+	do { bool thrown = false; try { statement; } catch ( exception& ) { thrown = true; } \
+		if ( !thrown ) Testing::Fail( #statement " throws " #exception, __FILE__, __LINE__ ); } while ( false )
+
+#endif //__WXFB_TESTING__